@@ -26,698 +26,2572 @@
 /************************************************************************
     INCLUDES
 ************************************************************************/
+#include <string.h>
 #include "MCP9808.h"
 #include "MCP9808_port.h"
 /************************************************************************
      DEFINES AND TYPES
 ************************************************************************/
+#if MCP9808_USE_STATS
+/** Tag the bus transactions of a public function */
+#define MCP9808_STATS_API( dev, id )    MCP9808_StatsApi((dev), (id))
+#else
+#define MCP9808_STATS_API( dev, id )
+#endif /* MCP9808_USE_STATS */
 
 
 
 /************************************************************************
     DECLARATIONS
 ************************************************************************/
-static bool MCP9808_isInitialized = false;    /**< Set to true when system initialized */
-static uint8_t MCP9808_Address = 0x00;        /**< Device I2C address */
+static MCP9808_Error_t MCP9808_ReadReg( MCP9808_Device_t* dev, uint8_t reg, uint8_t size, uint8_t* data );
+static MCP9808_Error_t MCP9808_WriteReg( MCP9808_Device_t* dev, uint8_t reg, uint8_t size, uint8_t* data );
 
 /************************************************************************
     FUNCTIONS
 ************************************************************************/
+#if MCP9808_USE_FLOAT
 /**
- * @brief Convert register temperature data to float.
+ * @brief Convert register temperature data to float. Alert flag bits are
+ *        ignored and the register data is left untouched.
  *
  * @param regData Register data pointer (uint8_t[2]).
  * @param temperature Pointer to temperature storage.
  * @return MCP9808_Error_t A number lower than '0' if something was wrong.
  */
-static MCP9808_Error_t MCP9808_RegToTemp( uint8_t* regData, float* temperature )
+static MCP9808_Error_t MCP9808_RegToTemp( const uint8_t* regData, float* temperature )
 {
     MCP9808_Error_t error = MCP9808_ERROR;
 
     if( (regData != NULL) && (temperature != NULL) )
     {
-        if( regData[MCP9808_MSB]&MCP9808_SIGN_MASK )
-        {
-            regData[MCP9808_MSB] = regData[MCP9808_MSB]&0xF;
-            *temperature = 256.0 - ((regData[MCP9808_MSB]*16.0) + (regData[MCP9808_LSB]/16.0));
-        }
-        else
-        {
-            regData[MCP9808_MSB] = regData[MCP9808_MSB]&0xF;
-            *temperature = ((regData[MCP9808_MSB]*16.0) + (regData[MCP9808_LSB]/16.0));
-        }
+        /* Every 13-bit code is exact in a float: no rounding here */
+        *temperature = (float)MCP9808_RegToQ4((regData[MCP9808_MSB] << 8) | regData[MCP9808_LSB]) * 0.0625f;
+        error = MCP9808_OK;
     }
 
     return error;
 }
 
 /**
- * @brief Transform float temperature into register format.
+ * @brief Transform float temperature into limit register format. The value is
+ *        rounded to the nearest 0.25 °C step (halves towards +inf, as
+ *        MCP9808_Q4ToReg) and saturated to the register range.
  *
  * @param regData Register data pointer (uint8_t[2]).
  * @param temperature Pointer to temperature.
- * @return
+ * @return MCP9808_Error_t A number lower than '0' if something was wrong
+ *         (NaN temperature included).
  */
-static MCP9808_Error_t MCP9808_TempToReg( uint8_t* regData, float* temperature )
+static MCP9808_Error_t MCP9808_TempToReg( uint8_t* regData, const float* temperature )
 {
     MCP9808_Error_t error = MCP9808_ERROR;
+    float quarters = 0.0f;
+    int32_t steps = 0;
+    uint16_t value = 0;
 
-    int16_t floatExp = 0;
-    uint16_t formatedTemp = 0;
-    uint32_t* tempData = (uint32_t*)(temperature);
-
-    if( (regData != NULL) && (temperature != NULL) )
-    {    /*                    1    8        23
-        /* IEE-754 format  |s| exp |  mantissa | */
-        /* Extract float exponent */
-        floatExp = (*tempData >> 23)&0xFF;
-        floatExp -= 127;
-        /*                                                    8        2            */
-        /* Shift right to obtain a number with format | integer | decimal |    */
-
-        formatedTemp  = ( (*tempData&0x7FFFFF) | 0x800000) >> ( 23 - (floatExp + 2) );
-
-        /* Shift left to match register format */
-        formatedTemp = (formatedTemp << 2)&0xFFC;
-        /* MSB*/
-        regData[MCP9808_MSB] = (formatedTemp >> 8)&0xFF;
-        /* LSB */
-        regData[MCP9808_LSB] = (formatedTemp)&0xFF;
+    if( (regData != NULL) && (temperature != NULL) && (*temperature == *temperature) )
+    {
+        /* Scaling by a power of two is exact */
+        quarters = *temperature * 4.0f;
 
-        /* Add sign bit */
-        if( *temperature < 0 )
+        if( quarters >= (float)(MCP9808_LIMIT_MAX_Q4 / 4) )
+        {
+            steps = MCP9808_LIMIT_MAX_Q4 / 4;
+        }
+        else if( quarters <= (float)(MCP9808_LIMIT_MIN_Q4 / 4) )
+        {
+            steps = MCP9808_LIMIT_MIN_Q4 / 4;
+        }
+        else
         {
-            regData[MCP9808_MSB] |= MCP9808_SIGN_MASK;
+            /* Truncate, then round on the exact fraction left */
+            steps = (int32_t)quarters;
+            quarters -= (float)steps;
+            if( quarters >= 0.5f )
+            {
+                steps++;
+            }
+            else if( quarters < -0.5f )
+            {
+                steps--;
+            }
         }
 
+        value = MCP9808_Q4ToReg((int16_t)(steps * 4));
+        regData[MCP9808_MSB] = (value >> 8) & 0xFF;
+        regData[MCP9808_LSB] = value & 0xFF;
         error = MCP9808_OK;
     }
 
     return error;
 }
+#endif /* MCP9808_USE_FLOAT */
 
 /**
- * @brief Initialize MPC9808 driver.
+ * @brief Convert a temperature register value (TA, T UPPER, T LOWER or T CRIT)
+ *        to sixteenths of a degree. Alert flag bits are ignored.
  *
- * @return MCP9808_Error_t A number lower than '0' if something was wrong.
+ * @param regValue Register value (MSB << 8 | LSB).
+ * @return int16_t Temperature in 1/16 °C (Q4).
  */
-MCP9808_Error_t MCP9808_Init( uint8_t devAddress )
+int16_t MCP9808_RegToQ4( uint16_t regValue )
 {
-    MCP9808_Error_t error = MCP9808_ERROR;
+    /* 13-bit two's complement */
+    return (int16_t)((regValue & MCP9808_TEMP_MSK) ^ MCP9808_TEMP_SIGN) - MCP9808_TEMP_SIGN;
+}
+
+/**
+ * @brief Convert sixteenths of a degree to limit register format. The value is
+ *        rounded to the nearest 0.25 °C step and saturated to the register range.
+ *
+ * @param temperature Temperature in 1/16 °C (Q4).
+ * @return uint16_t Register value (MSB << 8 | LSB).
+ */
+uint16_t MCP9808_Q4ToReg( int16_t temperature )
+{
+    int32_t value = ((int32_t)temperature + 2) & ~0x3;
 
-    if( !MCP9808_isInitialized )
+    if( value > MCP9808_LIMIT_MAX_Q4 )
     {
-        error = MCP9808_PORT_Init();
-        MCP9808_Address = devAddress;
+        value = MCP9808_LIMIT_MAX_Q4;
+    }
+    else if( value < MCP9808_LIMIT_MIN_Q4 )
+    {
+        value = MCP9808_LIMIT_MIN_Q4;
+    }
 
-        if( !IS_MCP9808_ERROR(error) )
-        {
-            MCP9808_isInitialized = true;
-        }
+    return (uint16_t)value & MCP9808_LIMIT_MSK;
+}
 
+#if MCP9808_USE_STATS
+/**
+ * @brief Set the public function the next bus transactions belong to.
+ *
+ * @param dev Device handle.
+ * @param api Public function (MCP9808_Api_t).
+ */
+static void MCP9808_StatsApi( MCP9808_Device_t* dev, MCP9808_Api_t api )
+{
+    if( dev != NULL )
+    {
+        dev->api = api;
     }
-    return error;
 }
 
 /**
- * @brief Update I2C device address.
+ * @brief Account one bus transaction.
  *
- * @param devAddress I2C device address.
- * @return MCP9808_Error_t A number lower than '0' if something was wrong.
+ * @param counter Counters to update.
+ * @param write True for a write transaction.
+ * @param bytes Bytes sent on the bus: data, plus the register pointer when sent.
+ * @param error Transaction result.
+ * @param latency Transaction latency (us).
  */
-MCP9808_Error_t MCP9808_setDevAddress( uint8_t devAddress )
+static void MCP9808_StatsCount( MCP9808_Stats_Counter_t* counter, bool write, uint8_t bytes,
+                                MCP9808_Error_t error, uint32_t latency )
 {
-    MCP9808_Address = devAddress;
+    uint8_t bucket = 0;
+
+    while( (latency != 0U) && (bucket < (MCP9808_STATS_BUCKETS - 1U)) )
+    {
+        latency >>= 1;
+        bucket++;
+    }
+
+    if( write )
+    {
+        counter->writes++;
+    }
+    else
+    {
+        counter->reads++;
+    }
+    counter->bytes += bytes;
+    counter->errors += IS_MCP9808_ERROR(error) ? 1U : 0U;
+    counter->latency[bucket]++;
 }
 
 /**
- * @brief Read current temperature.
+ * @brief Account one bus transaction to its register and public function.
  *
- * @param temperature Pointer to temperature storage.
- * @return MCP9808_Error_t A number lower than '0' if something was wrong.
+ * @param dev Device handle.
+ * @param api Public function (MCP9808_Api_t).
+ * @param reg Register.
+ * @param write True for a write transaction.
+ * @param bytes Bytes sent on the bus: data, plus the register pointer when sent.
+ * @param error Transaction result.
+ * @param start Transaction start time (us).
  */
-MCP9808_Error_t MCP9808_ReadTemperature( float* temperature )
+static void MCP9808_StatsRecord( MCP9808_Device_t* dev, uint8_t api, uint8_t reg, bool write, uint8_t bytes,
+                                 MCP9808_Error_t error, uint32_t start )
 {
-    MCP9808_Error_t error = MCP9808_ERROR;
-    uint8_t regData[MCP9808_REG_SIZE];
-    uint16_t rawValue = 0;
+    uint32_t latency = MCP9808_PORT_GetTimeUs(dev->bus) - start;
 
-    error = MCP9808_PORT_Read(MCP9808_Address,
-                            MCP9808_REG_TEMPERATURE,
-                            MCP9808_REG_SIZE, regData);
-    if( !IS_MCP9808_ERROR(error) )
+    if( reg < MCP9808_STATS_REGS )
     {
-        error = MCP9808_RegToTemp(regData, temperature);
+        MCP9808_StatsCount(&dev->stats.reg[reg], write, bytes, error, latency);
+    }
+    if( api < MCP9808_API_COUNT )
+    {
+        MCP9808_StatsCount(&dev->stats.api[api], write, bytes, error, latency);
     }
-    return error;
 }
+#endif /* MCP9808_USE_STATS */
 
+#if MCP9808_USE_STICKY_POINTER
 /**
- * @brief     Set critical temperature value. This value is used to generate
- *             alert signals.
+ * @brief Track the device register pointer after a transaction. Every
+ *        successful transfer leaves it on "reg"; after a failed one its
+ *        value is not known and the next read sends it again.
  *
- * @param temperature Temperature to set.
+ * @param dev Device handle.
+ * @param reg Register used by the transaction.
+ * @param error Transaction result.
+ */
+static void MCP9808_PointerSet( MCP9808_Device_t* dev, uint8_t reg, MCP9808_Error_t error )
+{
+    dev->pointer = IS_MCP9808_ERROR(error) ? MCP9808_POINTER_UNKNOWN : reg;
+}
+#endif /* MCP9808_USE_STICKY_POINTER */
+
+/**
+ * @brief Read a device register through the port layer.
+ *
+ * @param dev Device handle.
+ * @param reg Register to be read.
+ * @param size Register size in bytes.
+ * @param data Register data storage.
  * @return MCP9808_Error_t A number lower than '0' if something was wrong.
  */
-MCP9808_Error_t MCP9808_SetCriticalTemperature( float temperature )
+static MCP9808_Error_t MCP9808_ReadReg( MCP9808_Device_t* dev, uint8_t reg, uint8_t size, uint8_t* data )
 {
     MCP9808_Error_t error = MCP9808_ERROR;
-    uint8_t regData[MCP9808_REG_SIZE];
-
-    error = MCP9808_TempToReg(regData, &temperature);
+#if MCP9808_USE_STATS
+    uint32_t start = 0;
+    uint8_t bytes = 1U + size;      /* Register pointer + data */
+#endif /* MCP9808_USE_STATS */
 
-    if( !IS_MCP9808_ERROR(error) )
+    if( (dev != NULL) && dev->isInitialized && (data != NULL) )
     {
-        error = MCP9808_PORT_Write(MCP9808_Address,
-                                MCP9808_REG_CRITICAL_TEMP,
-                                MCP9808_REG_SIZE, regData);
+#if MCP9808_USE_STATS
+        start = MCP9808_PORT_GetTimeUs(dev->bus);
+#endif /* MCP9808_USE_STATS */
+#if MCP9808_USE_STICKY_POINTER
+        if( dev->pointer == reg )
+        {
+            error = MCP9808_PORT_ReadCurrent(dev->bus, dev->address, size, data);
+#if MCP9808_USE_STATS
+            bytes = size;           /* No register pointer */
+#endif /* MCP9808_USE_STATS */
+        }
+        else
+        {
+            error = MCP9808_PORT_Read(dev->bus, dev->address, reg, size, data);
+        }
+        MCP9808_PointerSet(dev, reg, error);
+#else
+        error = MCP9808_PORT_Read(dev->bus, dev->address, reg, size, data);
+#endif /* MCP9808_USE_STICKY_POINTER */
+#if MCP9808_USE_ONESHOT
+        dev->transfers++;
+#endif /* MCP9808_USE_ONESHOT */
+#if MCP9808_USE_STATS
+        MCP9808_StatsRecord(dev, dev->api, reg, false, bytes, error, start);
+#endif /* MCP9808_USE_STATS */
     }
 
     return error;
 }
 
 /**
- * @brief     Set critical temperature value from device.
- *             the alert function must be enabled.
+ * @brief Write a device register through the port layer.
  *
- * @param temperature Pointer to temperature storage.
+ * @param dev Device handle.
+ * @param reg Register to be written.
+ * @param size Register size in bytes.
+ * @param data Register data.
  * @return MCP9808_Error_t A number lower than '0' if something was wrong.
  */
-MCP9808_Error_t MCP9808_GetCriticalTemperature( float* temperature )
+static MCP9808_Error_t MCP9808_WriteReg( MCP9808_Device_t* dev, uint8_t reg, uint8_t size, uint8_t* data )
 {
     MCP9808_Error_t error = MCP9808_ERROR;
-    uint8_t regData[MCP9808_REG_SIZE];
+#if MCP9808_USE_STATS
+    uint32_t start = 0;
+#endif /* MCP9808_USE_STATS */
 
-    error = MCP9808_PORT_Read(MCP9808_Address,
-                            MCP9808_REG_CRITICAL_TEMP,
-                            MCP9808_REG_SIZE, regData);
-    if( !IS_MCP9808_ERROR(error) )
+    if( (dev != NULL) && dev->isInitialized && (data != NULL) )
     {
-        error = MCP9808_RegToTemp(regData, temperature);
+#if MCP9808_USE_STATS
+        start = MCP9808_PORT_GetTimeUs(dev->bus);
+#endif /* MCP9808_USE_STATS */
+        error = MCP9808_PORT_Write(dev->bus, dev->address, reg, size, data);
+#if MCP9808_USE_ONESHOT
+        dev->transfers++;
+#endif /* MCP9808_USE_ONESHOT */
+#if MCP9808_USE_STICKY_POINTER
+        MCP9808_PointerSet(dev, reg, error);
+#endif /* MCP9808_USE_STICKY_POINTER */
+#if MCP9808_USE_STATS
+        MCP9808_StatsRecord(dev, dev->api, reg, true, 1U + size, error, start);
+#endif /* MCP9808_USE_STATS */
     }
+
     return error;
 }
 
 /**
- * @brief     Set temperature window. This value are used to generate alert signals.
- *            the alert function must be enabled.
- * @param upperTemp Upper temperature boundary
- * @param lowerTemp Lower temperature boundary.
- * @return MCP9808_Error_t A number lower than '0' if something was wrong.
+ * @brief Get the cache slot of a register.
+ *
+ * @param reg Device register.
+ * @return int Cache slot or a number lower than '0' if the register is not cached.
  */
-MCP9808_Error_t MCP9808_SetWindowTemperature( float upperTemp, float lowerTemp )
+static int MCP9808_CacheSlot( uint8_t reg )
 {
-    MCP9808_Error_t error = MCP9808_ERROR;
-    uint8_t regData[MCP9808_REG_SIZE];
+    int slot = MCP9808_ERROR;
 
-    error = MCP9808_TempToReg(regData, &upperTemp);
-
-    if( !IS_MCP9808_ERROR(error) )
+    switch( reg )
     {
-        error = MCP9808_PORT_Write(MCP9808_Address,
-                                MCP9808_REG_UPPER_TEMP,
-                                MCP9808_REG_SIZE, regData);
+        case MCP9808_REG_CONFIG:        slot = MCP9808_CACHE_CONFIG;        break;
+        case MCP9808_REG_UPPER_TEMP:    slot = MCP9808_CACHE_UPPER_TEMP;    break;
+        case MCP9808_REG_LOWER_TEMP:    slot = MCP9808_CACHE_LOWER_TEMP;    break;
+        case MCP9808_REG_CRITICAL_TEMP: slot = MCP9808_CACHE_CRITICAL_TEMP; break;
+        case MCP9808_REG_RESOLUTION:    slot = MCP9808_CACHE_RESOLUTION;    break;
+        default:                                                            break;
+    }
 
-        if( !IS_MCP9808_ERROR(error) )
-        {
-            error = MCP9808_TempToReg(regData, &upperTemp);
-            if( !IS_MCP9808_ERROR(error) )
-            {
-                error = MCP9808_PORT_Write(MCP9808_Address,
-                                        MCP9808_REG_LOWER_TEMP,
-                                        MCP9808_REG_SIZE, regData);
-            }
+    return slot;
+}
+
+/**
+ * @brief Get the register size in bytes.
+ *
+ * @param reg Device register.
+ * @return uint8_t Register size.
+ */
+static uint8_t MCP9808_RegSize( uint8_t reg )
+{
+    return (reg == MCP9808_REG_RESOLUTION) ? 1U : MCP9808_REG_SIZE;
+}
 
+/**
+ * @brief Compute the CONFIG value the device keeps after a write.
+ *        Lock bits can only be cleared by a power-on reset. While any lock is
+ *        set the alert control, alert polarity, alert output mode and
+ *        hysteresis bits are frozen, and shutdown can be left but not
+ *        entered. The alert select bit is only frozen by the window lock.
+ *        Interrupt clear always reads as '0' and alert status is read-only.
+ *
+ * @param current Current CONFIG value.
+ * @param written Written CONFIG value.
+ * @return uint16_t Resulting CONFIG value.
+ */
+static uint16_t MCP9808_ConfigAfterWrite( uint16_t current, uint16_t written )
+{
+    const uint16_t locks = MCP9808_CONFIG_CRIT_LOCK | MCP9808_CONFIG_WIN_LOCK;
+    uint16_t frozen = 0;
+    uint16_t result = written;
+
+    if( current & locks )
+    {
+        frozen = MCP9808_CONFIG_ALERT_CONTROL | MCP9808_CONFIG_ALERT_POLARITY | MCP9808_CONFIG_ALERT_OUTPUT |
+                 ((uint16_t)MCP9808_HYST_MSK << 8);
+        if( current & MCP9808_CONFIG_WIN_LOCK )
+        {
+            frozen |= MCP9808_CONFIG_ALERT_MODE;
         }
+        result = (result & ~frozen) | (current & frozen);
+        result &= ~MCP9808_CONFIG_SHDN | current;
     }
+    result |= current & locks;
+    result &= ~(MCP9808_CONFIG_CLEAR_IRQ | MCP9808_CONFIG_ALERT_STATUS);
 
-    return error;
+    return result;
 }
 
 /**
- * @brief Get temperature window.
+ * @brief Get a register value, from the shadow copy if it is valid.
+ *        Otherwise, the register is read once and cached.
  *
- * @param upperTemp Upper temperature boundary storage.
- * @param lowerTemp Lower temperature boundary storage.
+ * @param dev Device handle.
+ * @param reg Cached register.
+ * @param value Register value storage (MSB << 8 | LSB).
  * @return MCP9808_Error_t A number lower than '0' if something was wrong.
  */
-MCP9808_Error_t MCP9808_GetWindowTemperature( float* upperTemp, float* lowerTemp )
+static MCP9808_Error_t MCP9808_CacheGet( MCP9808_Device_t* dev, uint8_t reg, uint16_t* value )
 {
     MCP9808_Error_t error = MCP9808_ERROR;
-    uint8_t regData[MCP9808_REG_SIZE];
+    uint8_t regData[MCP9808_REG_SIZE] = { 0 };
+    uint8_t size = MCP9808_RegSize(reg);
+    int slot = MCP9808_CacheSlot(reg);
 
-    error = MCP9808_PORT_Read(MCP9808_Address,
-                            MCP9808_REG_UPPER_TEMP,
-                            MCP9808_REG_SIZE, regData);
-    if( !IS_MCP9808_ERROR(error) )
+    if( (dev != NULL) && (value != NULL) && (slot >= 0) )
     {
-        error = MCP9808_RegToTemp(regData, upperTemp);
-        if( !IS_MCP9808_ERROR(error) )
+        if( dev->cache.valid & (1U << slot) )
+        {
+            error = MCP9808_OK;
+        }
+        else
         {
-            error = MCP9808_PORT_Read(MCP9808_Address,
-                                        MCP9808_REG_LOWER_TEMP,
-                                        MCP9808_REG_SIZE, regData);
+            error = MCP9808_ReadReg(dev, reg, size, regData);
             if( !IS_MCP9808_ERROR(error) )
             {
-                error = MCP9808_RegToTemp(regData, lowerTemp);
+                dev->cache.value[slot] = (size == 1U) ? regData[0] :
+                                         ((regData[MCP9808_MSB] << 8) | regData[MCP9808_LSB]);
+                if( reg == MCP9808_REG_CONFIG )
+                {
+                    dev->cache.value[slot] &= ~(MCP9808_CONFIG_CLEAR_IRQ | MCP9808_CONFIG_ALERT_STATUS);
+                }
+                dev->cache.valid |= (1U << slot);
             }
         }
 
+        if( !IS_MCP9808_ERROR(error) )
+        {
+            *value = dev->cache.value[slot];
+        }
     }
+
     return error;
 }
 
 /**
- * @brief Enable window register write protection.
+ * @brief Check if a register write would be ignored by the device because
+ *        of a lock bit known to be set.
  *
- * @return MCP9808_Error_t A number lower than '0' if something was wrong.
+ * @param dev Device handle.
+ * @param reg Register to be written.
+ * @return true if the register is locked.
  */
-MCP9808_Error_t MCP9808_LockWindowTempReg( void )
+static bool MCP9808_IsLocked( MCP9808_Device_t* dev, uint8_t reg )
 {
-    MCP9808_Error_t error = MCP9808_ERROR;
-    uint8_t regData[MCP9808_REG_SIZE];
-
+    uint16_t lock = 0;
 
-    error = MCP9808_PORT_Read(MCP9808_Address,
-                                MCP9808_REG_CONFIG,
-                                MCP9808_REG_SIZE, regData);
-    if ( !IS_MCP9808_ERROR(error) )
+    if( (reg == MCP9808_REG_UPPER_TEMP) || (reg == MCP9808_REG_LOWER_TEMP) )
     {
-        regData[MCP9808_LSB] |= MCP9808_CONFIG_WIN_LOCK;
-
-        error = MCP9808_PORT_Write(MCP9808_Address,
-                                MCP9808_REG_CONFIG,
-                                MCP9808_REG_SIZE, regData);
+        lock = MCP9808_CONFIG_WIN_LOCK;
+    }
+    else if( reg == MCP9808_REG_CRITICAL_TEMP )
+    {
+        lock = MCP9808_CONFIG_CRIT_LOCK;
     }
 
-    return error;
+    return (dev->cache.valid & (1U << MCP9808_CACHE_CONFIG)) &&
+           (dev->cache.value[MCP9808_CACHE_CONFIG] & lock);
 }
 
 /**
- * @brief Disable window register write protection.
+ * @brief Encode a register value into bus format.
  *
- * @return MCP9808_Error_t A number lower than '0' if something was wrong.
+ * @param reg Device register.
+ * @param value Register value (MSB << 8 | LSB).
+ * @param regData Register data storage (uint8_t[2]).
+ * @return uint8_t Register size in bytes.
  */
-MCP9808_Error_t MCP9808_UnlockWindowTempReg( void )
+static uint8_t MCP9808_EncodeReg( uint8_t reg, uint16_t value, uint8_t* regData )
 {
-    MCP9808_Error_t error = MCP9808_ERROR;
-    uint8_t regData[MCP9808_REG_SIZE];
+    uint8_t size = MCP9808_RegSize(reg);
 
-
-    error = MCP9808_PORT_Read(MCP9808_Address,
-                                MCP9808_REG_CONFIG,
-                                MCP9808_REG_SIZE, regData);
-    if ( !IS_MCP9808_ERROR(error) )
+    if( size == 1U )
     {
-        regData[MCP9808_LSB] &= ~(MCP9808_CONFIG_WIN_LOCK);
-
-        error = MCP9808_PORT_Write(MCP9808_Address,
-                                MCP9808_REG_CONFIG,
-                                MCP9808_REG_SIZE, regData);
+        regData[0] = value & 0xFF;
+    }
+    else
+    {
+        regData[MCP9808_MSB] = (value >> 8) & 0xFF;
+        regData[MCP9808_LSB] = value & 0xFF;
     }
 
-    return error;
+    return size;
 }
 
 /**
- * @brief Enable critical temperature register write protection.
+ * @brief Update the shadow copy after a register write. The resulting value
+ *        is only known if the write succeeded and the lock state was known
+ *        (CONFIG and limits), otherwise the slot is invalidated.
  *
- * @return MCP9808_Error_t A number lower than '0' if something was wrong.
+ * @param dev Device handle.
+ * @param reg Written register.
+ * @param value Written value (MSB << 8 | LSB).
+ * @param error Write result.
  */
-MCP9808_Error_t MCP9808_LockCriticalTempReg( void )
+static void MCP9808_CacheWritten( MCP9808_Device_t* dev, uint8_t reg, uint16_t value, MCP9808_Error_t error )
 {
-    MCP9808_Error_t error = MCP9808_ERROR;
-    uint8_t regData[MCP9808_REG_SIZE];
-
+    int slot = MCP9808_CacheSlot(reg);
+    bool known = (dev->cache.valid & (1U << MCP9808_CACHE_CONFIG)) || (reg == MCP9808_REG_RESOLUTION);
 
-    error = MCP9808_PORT_Read(MCP9808_Address,
-                                MCP9808_REG_CONFIG,
-                                MCP9808_REG_SIZE, regData);
-    if ( !IS_MCP9808_ERROR(error) )
+    if( slot >= 0 )
     {
-        regData[MCP9808_LSB] |= MCP9808_CONFIG_CRIT_LOCK;
-
-        error = MCP9808_PORT_Write(MCP9808_Address,
-                                MCP9808_REG_CONFIG,
-                                MCP9808_REG_SIZE, regData);
+        if( !IS_MCP9808_ERROR(error) && known )
+        {
+            if( reg == MCP9808_REG_CONFIG )
+            {
+                value = MCP9808_ConfigAfterWrite(dev->cache.value[MCP9808_CACHE_CONFIG], value);
+            }
+            dev->cache.value[slot] = value;
+            dev->cache.valid |= (1U << slot);
+        }
+        else
+        {
+            /* Device state unknown: read it again on next access */
+            dev->cache.valid &= ~(1U << slot);
+        }
     }
-
-    return error;
 }
 
 /**
- * @brief Disable critical temperature register write protection.
+ * @brief Write a register and update its shadow copy (write-through).
+ *        Limit registers are not written while the matching lock bit is set,
+ *        since the device would ignore the write. CONFIG is read first if it
+ *        is not cached, so the lock state is known and the written limit
+ *        stays in the cache.
  *
+ * @param dev Device handle.
+ * @param reg Cached register.
+ * @param value Register value (MSB << 8 | LSB).
  * @return MCP9808_Error_t A number lower than '0' if something was wrong.
  */
-MCP9808_Error_t MCP9808_UnlockCriticalTempReg( void )
+static MCP9808_Error_t MCP9808_CacheSet( MCP9808_Device_t* dev, uint8_t reg, uint16_t value )
 {
     MCP9808_Error_t error = MCP9808_ERROR;
     uint8_t regData[MCP9808_REG_SIZE];
+    uint8_t size = 0;
+    uint16_t config = 0;
 
-
-    error = MCP9808_PORT_Read(MCP9808_Address,
-                                MCP9808_REG_CONFIG,
-                                MCP9808_REG_SIZE, regData);
-
-    if ( !IS_MCP9808_ERROR(error) )
+    if( (dev != NULL) && (MCP9808_CacheSlot(reg) >= 0) )
     {
-        regData[MCP9808_LSB] &= ~(MCP9808_CONFIG_CRIT_LOCK);
+        error = MCP9808_OK;
+        if( (reg == MCP9808_REG_UPPER_TEMP) || (reg == MCP9808_REG_LOWER_TEMP) || (reg == MCP9808_REG_CRITICAL_TEMP) )
+        {
+            error = MCP9808_CacheGet(dev, MCP9808_REG_CONFIG, &config);
+        }
 
-        error = MCP9808_PORT_Write(MCP9808_Address,
-                                MCP9808_REG_CONFIG,
-                                MCP9808_REG_SIZE, regData);
+        if( !IS_MCP9808_ERROR(error) && MCP9808_IsLocked(dev, reg) )
+        {
+            error = MCP9808_ERROR;
+        }
+        else if( !IS_MCP9808_ERROR(error) )
+        {
+            size = MCP9808_EncodeReg(reg, value, regData);
+            error = MCP9808_WriteReg(dev, reg, size, regData);
+            MCP9808_CacheWritten(dev, reg, value, error);
+        }
     }
 
     return error;
 }
 
 /**
- * @brief Clear interrupt status.
+ * @brief Update CONFIG register bits with a single write transaction.
+ *        The write is skipped if the bits already have the requested value.
  *
+ * @param dev Device handle.
+ * @param mask Bits to update.
+ * @param bits New bits value.
  * @return MCP9808_Error_t A number lower than '0' if something was wrong.
  */
-MCP9808_Error_t MCP9808_ClearInterrupt( void )
+static MCP9808_Error_t MCP9808_UpdateConfig( MCP9808_Device_t* dev, uint16_t mask, uint16_t bits )
 {
     MCP9808_Error_t error = MCP9808_ERROR;
-    uint8_t regData[MCP9808_REG_SIZE];
-
+    uint16_t config = 0;
+    uint16_t newConfig = 0;
 
-    error = MCP9808_PORT_Read(MCP9808_Address,
-                                MCP9808_REG_CONFIG,
-                                MCP9808_REG_SIZE, regData);
-    if ( !IS_MCP9808_ERROR(error) )
+    error = MCP9808_CacheGet(dev, MCP9808_REG_CONFIG, &config);
+    if( !IS_MCP9808_ERROR(error) )
     {
-        regData[MCP9808_LSB] |= MCP9808_CONFIG_CLEAR_IRQ;
-
-        error = MCP9808_PORT_Write(MCP9808_Address,
-                                MCP9808_REG_CONFIG,
-                                MCP9808_REG_SIZE, regData);
+        newConfig = (config & ~mask) | (bits & mask);
+        if( (newConfig != config) || (bits & MCP9808_CONFIG_CLEAR_IRQ) )
+        {
+            error = MCP9808_CacheSet(dev, MCP9808_REG_CONFIG, newConfig);
+        }
     }
 
     return error;
 }
 
 /**
- * @brief Check if the alert is asserted.
+ * @brief Initialize a MPC9808 device handle. Every handle keeps its own
+ *        address and bus context, so several devices can be used at the
+ *        same time (from different threads if the port layer allows it).
  *
+ * @param dev Device handle storage.
+ * @param bus Port bus context. It is passed as is to the port layer.
+ * @param devAddress I2C device address.
  * @return MCP9808_Error_t A number lower than '0' if something was wrong.
  */
-bool MCP9808_IsAlertAsserted( void )
+MCP9808_Error_t MCP9808_Init( MCP9808_Device_t* dev, void* bus, uint8_t devAddress )
 {
-    bool result = false;
     MCP9808_Error_t error = MCP9808_ERROR;
-    uint8_t regData[MCP9808_REG_SIZE];
 
-
-    error = MCP9808_PORT_Read(MCP9808_Address,
-                                MCP9808_REG_CONFIG,
-                                MCP9808_REG_SIZE, regData);
-    if ( !IS_MCP9808_ERROR(error) )
+    if( dev != NULL )
     {
-        result = regData[MCP9808_LSB]&MCP9808_CONFIG_ALERT_STATUS;
+        dev->bus = bus;
+        dev->address = devAddress;
+        dev->isInitialized = false;
+        dev->cache.valid = 0U;
+#if MCP9808_USE_STICKY_POINTER
+        dev->pointer = MCP9808_POINTER_UNKNOWN;
+#endif /* MCP9808_USE_STICKY_POINTER */
+#if MCP9808_USE_ALERT_PIN
+        dev->alertHandler = NULL;
+        dev->alertContext = NULL;
+        dev->alertPending = false;
+#endif /* MCP9808_USE_ALERT_PIN */
+#if MCP9808_USE_STATS
+        dev->api = MCP9808_API_OTHER;
+        memset(&dev->stats, 0, sizeof(dev->stats));
+#endif /* MCP9808_USE_STATS */
+#if MCP9808_USE_ASYNC
+        dev->configPending = false;
+#endif /* MCP9808_USE_ASYNC */
+#if MCP9808_USE_ONESHOT
+        dev->transfers = 0U;
+#endif /* MCP9808_USE_ONESHOT */
+
+        error = MCP9808_PORT_Init(bus);
 
+        if( !IS_MCP9808_ERROR(error) )
+        {
+            dev->isInitialized = true;
+        }
     }
-
-    return result;
+    return error;
 }
 
 /**
- * @brief Enable alert function.
+ * @brief Update I2C device address. The register cache is invalidated.
  *
+ * @param dev Device handle.
+ * @param devAddress I2C device address.
  * @return MCP9808_Error_t A number lower than '0' if something was wrong.
  */
-MCP9808_Error_t MCP9808_EnableAlert( void )
+MCP9808_Error_t MCP9808_setDevAddress( MCP9808_Device_t* dev, uint8_t devAddress )
 {
     MCP9808_Error_t error = MCP9808_ERROR;
-    uint8_t regData[MCP9808_REG_SIZE];
 
-
-    error = MCP9808_PORT_Read(MCP9808_Address,
-                                MCP9808_REG_CONFIG,
-                                MCP9808_REG_SIZE, regData);
-    if ( !IS_MCP9808_ERROR(error) )
+    if( dev != NULL )
     {
-        regData[MCP9808_LSB] |= MCP9808_CONFIG_ALERT_CONTROL;
-
-        error = MCP9808_PORT_Write(MCP9808_Address,
-                                MCP9808_REG_CONFIG,
-                                MCP9808_REG_SIZE, regData);
+        dev->address = devAddress;
+        dev->cache.valid = 0U;
+#if MCP9808_USE_STICKY_POINTER
+        dev->pointer = MCP9808_POINTER_UNKNOWN;
+#endif /* MCP9808_USE_STICKY_POINTER */
+        error = MCP9808_OK;
     }
 
     return error;
 }
 
 /**
- * @brief Disable alert function.
+ * @brief Drop the register shadow copy. Registers will be read again
+ *        from the device on next access. Use it if the device could
+ *        have been modified by someone else (reset, other master).
+ *        The register pointer is forgotten too (sticky pointer).
  *
+ * @param dev Device handle.
  * @return MCP9808_Error_t A number lower than '0' if something was wrong.
  */
-MCP9808_Error_t MCP9808_DisableAlert( void )
+MCP9808_Error_t MCP9808_InvalidateCache( MCP9808_Device_t* dev )
 {
     MCP9808_Error_t error = MCP9808_ERROR;
-    uint8_t regData[MCP9808_REG_SIZE];
 
-
-    error = MCP9808_PORT_Read(MCP9808_Address,
-                                MCP9808_REG_CONFIG,
-                                MCP9808_REG_SIZE, regData);
-    if ( !IS_MCP9808_ERROR(error) )
+    if( dev != NULL )
     {
-        regData[MCP9808_LSB] &= ~(MCP9808_CONFIG_ALERT_CONTROL);
-
-        error = MCP9808_PORT_Write(MCP9808_Address,
-                                MCP9808_REG_CONFIG,
-                                MCP9808_REG_SIZE, regData);
+        dev->cache.valid = 0U;
+#if MCP9808_USE_STICKY_POINTER
+        dev->pointer = MCP9808_POINTER_UNKNOWN;
+#endif /* MCP9808_USE_STICKY_POINTER */
+        error = MCP9808_OK;
     }
 
     return error;
 }
 
 /**
- * @brief     Set alert output assert mode. If it is set to "MCP9808_ALERT_MODE_ALL"
- *             the output will be updated when the current temperature crosses any boundary,
- *             otherwise, the output will only be updated when it crosses TCRIT.
+ * @brief Reload the register shadow copy from the device.
  *
- * @param mode Output mode.
+ * @param dev Device handle.
  * @return MCP9808_Error_t A number lower than '0' if something was wrong.
  */
-MCP9808_Error_t MCP9808_SetAlertMode( MCP9808_Alert_Mode_t mode )
+MCP9808_Error_t MCP9808_SyncCache( MCP9808_Device_t* dev )
 {
-    MCP9808_Error_t error = MCP9808_ERROR;
-    uint8_t regData[MCP9808_REG_SIZE];
-
-
-    error = MCP9808_PORT_Read(MCP9808_Address,
-                                MCP9808_REG_CONFIG,
-                                MCP9808_REG_SIZE, regData);
-    if ( !IS_MCP9808_ERROR(error) )
+    static const uint8_t regs[MCP9808_CACHE_SIZE] =
     {
-        regData[MCP9808_LSB] &= ~(MCP9808_ALERT_MODE_MSK);
-        regData[MCP9808_LSB] |= mode&MCP9808_ALERT_MODE_MSK;
-
-        error = MCP9808_PORT_Write(MCP9808_Address,
-                                MCP9808_REG_CONFIG,
-                                MCP9808_REG_SIZE, regData);
+        MCP9808_REG_CONFIG, MCP9808_REG_UPPER_TEMP, MCP9808_REG_LOWER_TEMP,
+        MCP9808_REG_CRITICAL_TEMP, MCP9808_REG_RESOLUTION
+    };
+    MCP9808_Error_t error = MCP9808_InvalidateCache(dev);
+    uint16_t value = 0;
+    uint8_t i = 0;
+
+    MCP9808_STATS_API(dev, MCP9808_API_SYNC_CACHE);
+    for( i = 0; (i < MCP9808_CACHE_SIZE) && !IS_MCP9808_ERROR(error); i++ )
+    {
+        error = MCP9808_CacheGet(dev, regs[i], &value);
     }
 
     return error;
 }
 
+#if MCP9808_USE_STATS
 /**
- * @brief    Set alert output polarity (HIGH or LOW).
+ * @brief Copy the device bus statistics. Counters are updated from the
+ *        calling thread (and from the async completion context), so take
+ *        the snapshot from the thread that uses the device.
  *
- * @param polarity Polarity to set.
+ * @param dev Device handle.
+ * @param snapshot Statistics storage.
+ * @return MCP9808_Error_t A number lower than '0' if something was wrong.
+ */
+MCP9808_Error_t MCP9808_GetStats( const MCP9808_Device_t* dev, MCP9808_Stats_t* snapshot )
+{
+    MCP9808_Error_t error = MCP9808_ERROR;
+
+    if( (dev != NULL) && (snapshot != NULL) )
+    {
+        memcpy(snapshot, &dev->stats, sizeof(*snapshot));
+        error = MCP9808_OK;
+    }
+
+    return error;
+}
+
+/**
+ * @brief Clear the device bus statistics.
+ *
+ * @param dev Device handle.
+ * @return MCP9808_Error_t A number lower than '0' if something was wrong.
+ */
+MCP9808_Error_t MCP9808_ResetStats( MCP9808_Device_t* dev )
+{
+    MCP9808_Error_t error = MCP9808_ERROR;
+
+    if( dev != NULL )
+    {
+        memset(&dev->stats, 0, sizeof(dev->stats));
+        error = MCP9808_OK;
+    }
+
+    return error;
+}
+#endif /* MCP9808_USE_STATS */
+
+/**
+ * @brief Read the TA register.
+ *
+ * @param dev Device handle.
+ * @param raw Pointer to register value storage (MSB << 8 | LSB).
  * @return MCP9808_Error_t A number lower than '0' if something was wrong.
  */
-MCP9808_Error_t MCP9808_SetAlertPolarity( MCP9808_Alert_Polarity_t polarity )
+static MCP9808_Error_t MCP9808_ReadTA( MCP9808_Device_t* dev, uint16_t* raw )
 {
     MCP9808_Error_t error = MCP9808_ERROR;
     uint8_t regData[MCP9808_REG_SIZE];
 
+    error = MCP9808_ReadReg(dev,
+                            MCP9808_REG_TEMPERATURE,
+                            MCP9808_REG_SIZE, regData);
+    if( !IS_MCP9808_ERROR(error) && (raw != NULL) )
+    {
+        *raw = (regData[MCP9808_MSB] << 8) | regData[MCP9808_LSB];
+    }
+    return error;
+}
+
+/**
+ * @brief Read the raw temperature register (TA). Bits 15 to 13 hold the
+ *        TCRIT, TUPPER and TLOWER alert flags.
+ *
+ * @param dev Device handle.
+ * @param raw Pointer to register value storage (MSB << 8 | LSB).
+ * @return MCP9808_Error_t A number lower than '0' if something was wrong.
+ */
+MCP9808_Error_t MCP9808_ReadTemperatureRaw( MCP9808_Device_t* dev, uint16_t* raw )
+{
+    MCP9808_STATS_API(dev, MCP9808_API_READ_TEMPERATURE_RAW);
+    return MCP9808_ReadTA(dev, raw);
+}
 
-    error = MCP9808_PORT_Read(MCP9808_Address,
-                                MCP9808_REG_CONFIG,
-                                MCP9808_REG_SIZE, regData);
-    if ( !IS_MCP9808_ERROR(error) )
+/**
+ * @brief Read current temperature in sixteenths of a degree. No float is used.
+ *
+ * @param dev Device handle.
+ * @param temperature Pointer to temperature storage (1/16 °C).
+ * @return MCP9808_Error_t A number lower than '0' if something was wrong.
+ */
+MCP9808_Error_t MCP9808_ReadTemperatureQ4( MCP9808_Device_t* dev, int16_t* temperature )
+{
+    MCP9808_Error_t error = MCP9808_ERROR;
+    uint16_t raw = 0;
+
+    MCP9808_STATS_API(dev, MCP9808_API_READ_TEMPERATURE_Q4);
+    error = MCP9808_ReadTA(dev, &raw);
+    if( !IS_MCP9808_ERROR(error) && (temperature != NULL) )
     {
-        regData[MCP9808_LSB] &= ~(MCP9808_ALERT_POL_MSK);
-        regData[MCP9808_LSB] |= polarity&MCP9808_ALERT_POL_MSK;
+        *temperature = MCP9808_RegToQ4(raw);
+    }
+    return error;
+}
 
-        error = MCP9808_PORT_Write(MCP9808_Address,
-                                MCP9808_REG_CONFIG,
-                                MCP9808_REG_SIZE, regData);
+/**
+ * @brief     Read the temperature of several devices. Consecutive devices on
+ *            the same bus are read with a single MCP9808_PORT_ReadMulti()
+ *            transfer (if the port provides it). If that transfer fails, the
+ *            devices are read one by one so every result has its own status.
+ *
+ * @param devices Device handles.
+ * @param n Number of devices.
+ * @param out Results storage, n entries.
+ * @return MCP9808_Error_t A number lower than '0' if any device failed.
+ */
+MCP9808_Error_t MCP9808_ReadTemperatureMulti( MCP9808_Device_t* const* devices, size_t n,
+                                              MCP9808_Multi_Result_t* out )
+{
+    MCP9808_Error_t error = MCP9808_ERROR;
+    size_t i = 0;
+    size_t j = 0;
+    size_t count = 0;
+#if MCP9808_USE_MULTI
+    uint8_t addresses[MCP9808_MULTI_MAX];
+    uint8_t regData[MCP9808_MULTI_MAX * MCP9808_REG_SIZE];
+#if MCP9808_USE_STATS
+    uint32_t start = 0;
+#endif /* MCP9808_USE_STATS */
+#endif
+    MCP9808_Error_t multiError = MCP9808_ERROR;
+
+    if( (devices != NULL) && (out != NULL) )
+    {
+        error = MCP9808_OK;
+
+        for( i = 0; i < n; i += count )
+        {
+            count = 1U;
+            multiError = MCP9808_ERROR;
+#if MCP9808_USE_MULTI
+            while( ((i + count) < n) && (count < MCP9808_MULTI_MAX) && (devices[i] != NULL) &&
+                   (devices[i + count] != NULL) && devices[i + count]->isInitialized &&
+                   (devices[i + count]->bus == devices[i]->bus) )
+            {
+                count++;
+            }
+
+            if( (count > 1U) && devices[i]->isInitialized )
+            {
+                for( j = 0; j < count; j++ )
+                {
+                    addresses[j] = devices[i + j]->address;
+                }
+#if MCP9808_USE_STATS
+                start = MCP9808_PORT_GetTimeUs(devices[i]->bus);
+#endif /* MCP9808_USE_STATS */
+                multiError = MCP9808_PORT_ReadMulti(devices[i]->bus, addresses, (uint8_t)count,
+                                                    MCP9808_REG_TEMPERATURE, MCP9808_REG_SIZE, regData);
+#if MCP9808_USE_STICKY_POINTER
+                for( j = 0; j < count; j++ )
+                {
+                    MCP9808_PointerSet(devices[i + j], MCP9808_REG_TEMPERATURE, multiError);
+                }
+#endif /* MCP9808_USE_STICKY_POINTER */
+#if MCP9808_USE_ONESHOT
+                /* Same accounting as MCP9808_ReadReg(): every device took part in the transfer */
+                for( j = 0; j < count; j++ )
+                {
+                    devices[i + j]->transfers++;
+                }
+#endif /* MCP9808_USE_ONESHOT */
+#if MCP9808_USE_STATS
+                for( j = 0; j < count; j++ )
+                {
+                    MCP9808_StatsRecord(devices[i + j], MCP9808_API_READ_TEMPERATURE_MULTI,
+                                        MCP9808_REG_TEMPERATURE, false, 1U + MCP9808_REG_SIZE, multiError, start);
+                }
+#endif /* MCP9808_USE_STATS */
+            }
+
+            if( !IS_MCP9808_ERROR(multiError) )
+            {
+                for( j = 0; j < count; j++ )
+                {
+                    out[i + j].error = MCP9808_OK;
+                    out[i + j].raw = (regData[j * MCP9808_REG_SIZE + MCP9808_MSB] << 8) |
+                                     regData[j * MCP9808_REG_SIZE + MCP9808_LSB];
+                    out[i + j].temperature = MCP9808_RegToQ4(out[i + j].raw);
+                }
+            }
+#endif
+            for( j = i; (j < (i + count)) && IS_MCP9808_ERROR(multiError); j++ )
+            {
+                MCP9808_STATS_API(devices[j], MCP9808_API_READ_TEMPERATURE_MULTI);
+                out[j].error = MCP9808_ReadTA(devices[j], &out[j].raw);
+                if( IS_MCP9808_ERROR(out[j].error) )
+                {
+                    out[j].raw = 0U;
+                    out[j].temperature = 0;
+                    error = out[j].error;
+                }
+                else
+                {
+                    out[j].temperature = MCP9808_RegToQ4(out[j].raw);
+                }
+            }
+        }
     }
 
     return error;
 }
 
 /**
- * @brief Set alert output mode (compare or IRQ).
+ * @brief Get the conversion time (tCONV, typical) of a resolution.
  *
- * @param output Output mode to set.
+ * @param resolution Temperature resolution.
+ * @return uint32_t Conversion time (us).
+ */
+uint32_t MCP9808_ConversionTimeUs( MCP9808_Resolution_t resolution )
+{
+    static const uint32_t conversionUs[4] = { 30000U, 65000U, 130000U, 250000U };
+
+    return conversionUs[resolution & MCP9808_RESOLUTION_MSK];
+}
+
+/**
+ * @brief Get the maximum conversion time of a resolution: the typical
+ *        tCONV plus MCP9808_TCONV_MARGIN_PCT. A new TA value is only
+ *        guaranteed after this time.
+ *
+ * @param resolution Temperature resolution.
+ * @return uint32_t Conversion time (us).
+ */
+uint32_t MCP9808_ConversionTimeMaxUs( MCP9808_Resolution_t resolution )
+{
+    uint32_t conversionUs = MCP9808_ConversionTimeUs(resolution);
+
+    return conversionUs + (conversionUs / 100U) * MCP9808_TCONV_MARGIN_PCT;
+}
+
+/**
+ * @brief Get the maximum conversion time of the resolution set in the device.
+ *        RESOLUTION is served from the register cache, so it follows
+ *        MCP9808_SetResolution() without extra bus traffic. Every sampler
+ *        function starts here: the bus traffic that follows (cold cache
+ *        fill included) is charged to MCP9808_API_SAMPLER.
+ *
+ * @param dev Device handle.
+ * @param conversionUs Conversion time storage (us).
  * @return MCP9808_Error_t A number lower than '0' if something was wrong.
  */
-MCP9808_Error_t MCP9808_SetAlertOutput( MCP9808_Alert_Output_t output )
+static MCP9808_Error_t MCP9808_SamplerPeriod( MCP9808_Device_t* dev, uint32_t* conversionUs )
 {
     MCP9808_Error_t error = MCP9808_ERROR;
-    uint8_t regData[MCP9808_REG_SIZE];
+    uint16_t resolution = 0;
 
+    MCP9808_STATS_API(dev, MCP9808_API_SAMPLER);
+    error = MCP9808_CacheGet(dev, MCP9808_REG_RESOLUTION, &resolution);
+    if( !IS_MCP9808_ERROR(error) )
+    {
+        *conversionUs = MCP9808_ConversionTimeMaxUs(resolution & MCP9808_RESOLUTION_MSK);
+    }
 
-    error = MCP9808_PORT_Read(MCP9808_Address,
-                                MCP9808_REG_CONFIG,
-                                MCP9808_REG_SIZE, regData);
-    if ( !IS_MCP9808_ERROR(error) )
+    return error;
+}
+
+/**
+ * @brief Initialize a TA sampler. The device resolution is read once (and
+ *        cached) to know the conversion time.
+ *
+ * @param sampler Sampler storage.
+ * @param dev Device handle.
+ * @return MCP9808_Error_t A number lower than '0' if something was wrong.
+ */
+MCP9808_Error_t MCP9808_SamplerInit( MCP9808_Sampler_t* sampler, MCP9808_Device_t* dev )
+{
+    MCP9808_Error_t error = MCP9808_ERROR;
+    uint32_t conversionUs = 0;
+
+    if( sampler != NULL )
     {
-        regData[MCP9808_LSB] &= ~(MCP9808_ALERT_OUTPUT_MSK);
-        regData[MCP9808_LSB] |= output&MCP9808_ALERT_OUTPUT_MSK;
+        sampler->dev = dev;
+        sampler->timeUs = 0U;
+        sampler->raw = 0U;
+        sampler->valid = false;
 
-        error = MCP9808_PORT_Write(MCP9808_Address,
-                                MCP9808_REG_CONFIG,
-                                MCP9808_REG_SIZE, regData);
+        error = MCP9808_SamplerPeriod(dev, &conversionUs);
     }
 
     return error;
 }
 
 /**
- * @brief Get device ID and revision.
+ * @brief     Get the temperature, reading TA only if a new conversion is due.
+ *            The device converts once every tCONV (30 to 250 ms depending on
+ *            the resolution): calls closer than the maximum tCONV (see
+ *            MCP9808_ConversionTimeMaxUs()) from the last bus read
+ *            return the same sample without bus traffic. The last raw
+ *            register (alert flags included) is kept in sampler->raw.
  *
- * @param id Pointer to ID storage.
- * @param revision Pointer to revision storage.
+ * @param sampler Sampler.
+ * @param nowUs Current time (us, free running, may wrap around).
+ * @param temperature Temperature storage (1/16 °C).
+ * @param ageUs Time since the sample was read (0 if it has just been read). Can be NULL.
  * @return MCP9808_Error_t A number lower than '0' if something was wrong.
  */
-MCP9808_Error_t MCP9808_GetID( uint8_t* id, uint8_t* revision )
+MCP9808_Error_t MCP9808_SamplerRead( MCP9808_Sampler_t* sampler, uint32_t nowUs, int16_t* temperature,
+                                     uint32_t* ageUs )
 {
     MCP9808_Error_t error = MCP9808_ERROR;
-    uint8_t regData[MCP9808_REG_SIZE];
+    uint32_t conversionUs = 0;
+    uint16_t raw = 0;
 
+    if( (sampler != NULL) && (temperature != NULL) )
+    {
+        error = MCP9808_SamplerPeriod(sampler->dev, &conversionUs);
+        if( !IS_MCP9808_ERROR(error) && (!sampler->valid || ((nowUs - sampler->timeUs) >= conversionUs)) )
+        {
+            error = MCP9808_ReadTA(sampler->dev, &raw);
+            if( !IS_MCP9808_ERROR(error) )
+            {
+                sampler->raw = raw;
+                sampler->timeUs = nowUs;
+                sampler->valid = true;
+            }
+        }
 
-    error = MCP9808_PORT_Read(MCP9808_Address,
-                                MCP9808_REG_ID_2,
-                                MCP9808_REG_SIZE, regData);
-    if ( !IS_MCP9808_ERROR(error) )
+        if( !IS_MCP9808_ERROR(error) )
+        {
+            *temperature = MCP9808_RegToQ4(sampler->raw);
+            if( ageUs != NULL )
+            {
+                *ageUs = nowUs - sampler->timeUs;
+            }
+        }
+    }
+
+    return error;
+}
+
+/**
+ * @brief Get the time left until MCP9808_SamplerRead() reads a new sample,
+ *        e.g. to sleep instead of polling.
+ *
+ * @param sampler Sampler.
+ * @param nowUs Current time (us).
+ * @param waitUs Time to wait storage (us, 0 if a new sample is already due).
+ * @return MCP9808_Error_t A number lower than '0' if something was wrong.
+ */
+MCP9808_Error_t MCP9808_SamplerNextUs( MCP9808_Sampler_t* sampler, uint32_t nowUs, uint32_t* waitUs )
+{
+    MCP9808_Error_t error = MCP9808_ERROR;
+    uint32_t conversionUs = 0;
+    uint32_t elapsedUs = 0;
+
+    if( (sampler != NULL) && (waitUs != NULL) )
     {
-        *id = regData[MCP9808_MSB];
-        *revision = regData[MCP9808_LSB];
+        error = MCP9808_SamplerPeriod(sampler->dev, &conversionUs);
+        if( !IS_MCP9808_ERROR(error) )
+        {
+            elapsedUs = nowUs - sampler->timeUs;
+            *waitUs = (!sampler->valid || (elapsedUs >= conversionUs)) ? 0U : (conversionUs - elapsedUs);
+        }
     }
 
     return error;
 }
 
 /**
- * @brief Get hysteresis configuration.
+ * @brief     Initialize an adaptive resolution controller. The temperature
+ *            rate is measured over MCP9808_ADAPTIVE_WINDOW_US windows: above
+ *            "fastRate" the resolution goes one step coarser (shorter tCONV,
+ *            more samples), below "slowRate" for MCP9808_ADAPTIVE_HOLD windows
+ *            in a row it goes one step finer. The gap between both rates and
+ *            the hold count keep it from flapping. Fields can be tuned after
+ *            init (window, hold, coarsest/finest resolutions).
  *
- * @param hysteresis Pointer to hysteresis mode storage.
+ * @param adaptive Controller storage.
+ * @param dev Device handle.
+ * @param fastRate Rate to go coarser (1/16 °C per second).
+ * @param slowRate Rate to go finer (1/16 °C per second), lower than fastRate.
  * @return MCP9808_Error_t A number lower than '0' if something was wrong.
  */
-MCP9808_Error_t MCP9808_GetHysteresis( MCP9808_Hysteresis_t* hysteresis )
+MCP9808_Error_t MCP9808_AdaptiveInit( MCP9808_Adaptive_t* adaptive, MCP9808_Device_t* dev,
+                                      uint16_t fastRate, uint16_t slowRate )
 {
     MCP9808_Error_t error = MCP9808_ERROR;
-    uint8_t regData[MCP9808_REG_SIZE];
 
+    if( (adaptive != NULL) && (slowRate < fastRate) )
+    {
+        adaptive->windowUs = MCP9808_ADAPTIVE_WINDOW_US;
+        adaptive->fastRate = fastRate;
+        adaptive->slowRate = slowRate;
+        adaptive->coarsest = MCP9808_RESOLUTION_1;
+        adaptive->finest = MCP9808_RESOLUTION_4;
+        adaptive->hold = MCP9808_ADAPTIVE_HOLD;
+        adaptive->stable = 0U;
+        adaptive->refValid = false;
+        adaptive->refTemperature = 0;
+        adaptive->refTimeUs = 0U;
+        adaptive->switches = 0U;
+
+        error = MCP9808_SamplerInit(&adaptive->sampler, dev);
+    }
+
+    return error;
+}
 
-    error = MCP9808_PORT_Read(MCP9808_Address,
-                                MCP9808_REG_CONFIG,
-                                MCP9808_REG_SIZE, regData);
-    if ( !IS_MCP9808_ERROR(error) )
+/**
+ * @brief Check the rate over the last window and change the resolution
+ *        if needed (one cached RESOLUTION write).
+ *
+ * @param adaptive Controller.
+ * @param rate Temperature rate (1/16 °C per second).
+ * @return MCP9808_Error_t A number lower than '0' if something was wrong.
+ */
+static MCP9808_Error_t MCP9808_AdaptiveStep( MCP9808_Adaptive_t* adaptive, uint32_t rate )
+{
+    MCP9808_Error_t error = MCP9808_ERROR;
+    MCP9808_Resolution_t resolution = MCP9808_RESOLUTION_4;
+    MCP9808_Resolution_t target = MCP9808_RESOLUTION_4;
+
+    error = MCP9808_GetResolution(adaptive->sampler.dev, &resolution);
+    target = resolution;
+
+    /* Resolution unknown: keep the hold state for the next window */
+    if( !IS_MCP9808_ERROR(error) )
+    {
+        if( rate >= adaptive->fastRate )
+        {
+            adaptive->stable = 0U;
+            target = (resolution > adaptive->coarsest) ? (MCP9808_Resolution_t)(resolution - 1) : resolution;
+        }
+        else if( rate <= adaptive->slowRate )
+        {
+            adaptive->stable++;
+            if( adaptive->stable >= adaptive->hold )
+            {
+                adaptive->stable = 0U;
+                target = (resolution < adaptive->finest) ? (MCP9808_Resolution_t)(resolution + 1) : resolution;
+            }
+        }
+        else
+        {
+            adaptive->stable = 0U;
+        }
+    }
+
+    if( !IS_MCP9808_ERROR(error) && (target != resolution) )
     {
-        *hysteresis = regData[MCP9808_MSB] & MCP9808_HYST_MSK;
+        error = MCP9808_SetResolution(adaptive->sampler.dev, target);
+        if( !IS_MCP9808_ERROR(error) )
+        {
+            adaptive->switches++;
+        }
     }
 
     return error;
 }
 
 /**
- * @brief Set hysteresis configuration.
+ * @brief     Get the temperature (see MCP9808_SamplerRead()) and adapt the
+ *            resolution to how fast it changes.
  *
- * @param hysteresis Hysteresis mode.
+ * @param adaptive Controller.
+ * @param nowUs Current time (us, free running, may wrap around).
+ * @param temperature Temperature storage (1/16 °C).
+ * @param ageUs Time since the sample was read (0 if it has just been read). Can be NULL.
  * @return MCP9808_Error_t A number lower than '0' if something was wrong.
  */
-MCP9808_Error_t MCP9808_SetHysteresis( MCP9808_Hysteresis_t hysteresis )
+MCP9808_Error_t MCP9808_AdaptiveRead( MCP9808_Adaptive_t* adaptive, uint32_t nowUs, int16_t* temperature,
+                                      uint32_t* ageUs )
 {
     MCP9808_Error_t error = MCP9808_ERROR;
-    uint8_t regData[MCP9808_REG_SIZE];
+    uint32_t elapsedUs = 0;
+    uint32_t delta = 0;
 
+    if( adaptive != NULL )
+    {
+        error = MCP9808_SamplerRead(&adaptive->sampler, nowUs, temperature, ageUs);
+    }
 
-    error = MCP9808_PORT_Read(MCP9808_Address,
-                                MCP9808_REG_CONFIG,
-                                MCP9808_REG_SIZE, regData);
-    if ( !IS_MCP9808_ERROR(error) )
+    if( !IS_MCP9808_ERROR(error) )
     {
-        regData[MCP9808_MSB] &= ~(MCP9808_HYST_MSK);
-        regData[MCP9808_MSB] |= hysteresis&MCP9808_HYST_MSK;
+        elapsedUs = nowUs - adaptive->refTimeUs;
 
-        error = MCP9808_PORT_Write(MCP9808_Address,
-                                MCP9808_REG_CONFIG,
-                                MCP9808_REG_SIZE, regData);
+        if( !adaptive->refValid )
+        {
+            adaptive->refValid = true;
+            adaptive->refTemperature = *temperature;
+            adaptive->refTimeUs = nowUs;
+        }
+        else if( elapsedUs >= adaptive->windowUs )
+        {
+            delta = (*temperature > adaptive->refTemperature) ? (*temperature - adaptive->refTemperature) :
+                                                                (adaptive->refTemperature - *temperature);
+            adaptive->refTemperature = *temperature;
+            adaptive->refTimeUs = nowUs;
+
+            error = MCP9808_AdaptiveStep(adaptive, (uint32_t)(((uint64_t)delta * 1000000U) / elapsedUs));
+        }
     }
 
     return error;
 }
 
 /**
- * @brief Set temperature resolution configuration.
+ * @brief Set a temperature limit register.
  *
- * @param resolution Temperature resolution storage.
+ * @param dev Device handle.
+ * @param reg Limit register.
+ * @param temperature Temperature to set (1/16 °C).
+ * @return MCP9808_Error_t A number lower than '0' if something was wrong.
+ */
+static MCP9808_Error_t MCP9808_SetLimit( MCP9808_Device_t* dev, uint8_t reg, int16_t temperature )
+{
+    return MCP9808_CacheSet(dev, reg, MCP9808_Q4ToReg(temperature));
+}
+
+/**
+ * @brief Get a temperature limit register.
+ *
+ * @param dev Device handle.
+ * @param reg Limit register.
+ * @param temperature Pointer to temperature storage (1/16 °C).
  * @return MCP9808_Error_t A number lower than '0' if something was wrong.
  */
-MCP9808_Error_t MCP9808_SetResolution( MCP9808_Resolution_t resolution )
+static MCP9808_Error_t MCP9808_GetLimit( MCP9808_Device_t* dev, uint8_t reg, int16_t* temperature )
 {
     MCP9808_Error_t error = MCP9808_ERROR;
-    uint8_t regData;
+    uint16_t value = 0;
 
-    error = MCP9808_PORT_Read(MCP9808_Address, MCP9808_REG_RESOLUTION,1, &regData);
-    if ( !IS_MCP9808_ERROR(error) )
+    error = MCP9808_CacheGet(dev, reg, &value);
+    if( !IS_MCP9808_ERROR(error) && (temperature != NULL) )
     {
-        regData &= ~(MCP9808_RESOLUTION_MSK);
-        regData |= resolution&MCP9808_RESOLUTION_MSK;
+        *temperature = MCP9808_RegToQ4(value);
+    }
+
+    return error;
+}
+
+/**
+ * @brief     Set critical temperature value in sixteenths of a degree.
+ *
+ * @param dev Device handle.
+ * @param temperature Temperature to set (1/16 °C).
+ * @return MCP9808_Error_t A number lower than '0' if something was wrong.
+ */
+MCP9808_Error_t MCP9808_SetCriticalTemperatureQ4( MCP9808_Device_t* dev, int16_t temperature )
+{
+    MCP9808_STATS_API(dev, MCP9808_API_SET_CRITICAL_TEMPERATURE);
+    return MCP9808_SetLimit(dev, MCP9808_REG_CRITICAL_TEMP, temperature);
+}
+
+/**
+ * @brief     Get critical temperature value in sixteenths of a degree.
+ *
+ * @param dev Device handle.
+ * @param temperature Pointer to temperature storage (1/16 °C).
+ * @return MCP9808_Error_t A number lower than '0' if something was wrong.
+ */
+MCP9808_Error_t MCP9808_GetCriticalTemperatureQ4( MCP9808_Device_t* dev, int16_t* temperature )
+{
+    MCP9808_STATS_API(dev, MCP9808_API_GET_CRITICAL_TEMPERATURE);
+    return MCP9808_GetLimit(dev, MCP9808_REG_CRITICAL_TEMP, temperature);
+}
+
+/**
+ * @brief     Set temperature window in sixteenths of a degree.
+ *
+ * @param dev Device handle.
+ * @param upperTemp Upper temperature boundary (1/16 °C).
+ * @param lowerTemp Lower temperature boundary (1/16 °C).
+ * @return MCP9808_Error_t A number lower than '0' if something was wrong.
+ */
+MCP9808_Error_t MCP9808_SetWindowTemperatureQ4( MCP9808_Device_t* dev, int16_t upperTemp, int16_t lowerTemp )
+{
+    MCP9808_Error_t error = MCP9808_ERROR;
 
-        error = MCP9808_PORT_Write(MCP9808_Address, MCP9808_REG_RESOLUTION, 1, &regData);
+    MCP9808_STATS_API(dev, MCP9808_API_SET_WINDOW_TEMPERATURE);
+    error = MCP9808_SetLimit(dev, MCP9808_REG_UPPER_TEMP, upperTemp);
+    if( !IS_MCP9808_ERROR(error) )
+    {
+        error = MCP9808_SetLimit(dev, MCP9808_REG_LOWER_TEMP, lowerTemp);
     }
 
     return error;
 }
 
 /**
- * @brief Get temperature resolution configuration.
+ * @brief     Get temperature window in sixteenths of a degree.
  *
- * @param resolution Temperature resolution.
+ * @param dev Device handle.
+ * @param upperTemp Upper temperature boundary storage (1/16 °C).
+ * @param lowerTemp Lower temperature boundary storage (1/16 °C).
  * @return MCP9808_Error_t A number lower than '0' if something was wrong.
  */
-MCP9808_Error_t MCP9808_GetResolution( MCP9808_Resolution_t* resolution )
+MCP9808_Error_t MCP9808_GetWindowTemperatureQ4( MCP9808_Device_t* dev, int16_t* upperTemp, int16_t* lowerTemp )
 {
     MCP9808_Error_t error = MCP9808_ERROR;
-    uint8_t regData;
 
-    error = MCP9808_PORT_Read(MCP9808_Address, MCP9808_REG_RESOLUTION,1, &regData);
-    if ( !IS_MCP9808_ERROR(error) )
+    MCP9808_STATS_API(dev, MCP9808_API_GET_WINDOW_TEMPERATURE);
+    error = MCP9808_GetLimit(dev, MCP9808_REG_UPPER_TEMP, upperTemp);
+    if( !IS_MCP9808_ERROR(error) )
     {
-        *resolution = regData &MCP9808_RESOLUTION_MSK;
+        error = MCP9808_GetLimit(dev, MCP9808_REG_LOWER_TEMP, lowerTemp);
     }
 
     return error;
 }
 
+#if MCP9808_USE_FLOAT
 /**
- * @brief Get the manufacturer ID (0x0054).
+ * @brief Read current temperature.
  *
- * @param id Manufacturer ID.
+ * @param dev Device handle.
+ * @param temperature Pointer to temperature storage.
  * @return MCP9808_Error_t A number lower than '0' if something was wrong.
  */
-MCP9808_Error_t MCP9808_GetManufactureID( uint16_t*id )
+MCP9808_Error_t MCP9808_ReadTemperature( MCP9808_Device_t* dev, float* temperature )
 {
     MCP9808_Error_t error = MCP9808_ERROR;
     uint8_t regData[MCP9808_REG_SIZE];
 
-
-    error = MCP9808_PORT_Read(MCP9808_Address,
-                                MCP9808_REG_ID_1,
-                                MCP9808_REG_SIZE, regData);
-    if ( !IS_MCP9808_ERROR(error) )
+    MCP9808_STATS_API(dev, MCP9808_API_READ_TEMPERATURE);
+    error = MCP9808_ReadReg(dev,
+                            MCP9808_REG_TEMPERATURE,
+                            MCP9808_REG_SIZE, regData);
+    if( !IS_MCP9808_ERROR(error) )
     {
-        *id = (regData[MCP9808_MSB] << 8) | regData[MCP9808_LSB];
+        error = MCP9808_RegToTemp(regData, temperature);
+    }
+    return error;
+}
+
+/**
+ * @brief Set a temperature limit register from a float value.
+ *
+ * @param dev Device handle.
+ * @param reg Limit register.
+ * @param temperature Temperature to set.
+ * @return MCP9808_Error_t A number lower than '0' if something was wrong.
+ */
+static MCP9808_Error_t MCP9808_SetLimitFloat( MCP9808_Device_t* dev, uint8_t reg, float temperature )
+{
+    MCP9808_Error_t error = MCP9808_ERROR;
+    uint8_t regData[MCP9808_REG_SIZE];
+
+    error = MCP9808_TempToReg(regData, &temperature);
+
+    if( !IS_MCP9808_ERROR(error) )
+    {
+        error = MCP9808_CacheSet(dev, reg, (regData[MCP9808_MSB] << 8) | regData[MCP9808_LSB]);
+    }
+
+    return error;
+}
+
+/**
+ * @brief Get a temperature limit register as a float value.
+ *
+ * @param dev Device handle.
+ * @param reg Limit register.
+ * @param temperature Pointer to temperature storage.
+ * @return MCP9808_Error_t A number lower than '0' if something was wrong.
+ */
+static MCP9808_Error_t MCP9808_GetLimitFloat( MCP9808_Device_t* dev, uint8_t reg, float* temperature )
+{
+    MCP9808_Error_t error = MCP9808_ERROR;
+    uint8_t regData[MCP9808_REG_SIZE];
+    uint16_t value = 0;
+
+    error = MCP9808_CacheGet(dev, reg, &value);
+    if( !IS_MCP9808_ERROR(error) )
+    {
+        regData[MCP9808_MSB] = (value >> 8) & 0xFF;
+        regData[MCP9808_LSB] = value & 0xFF;
+        error = MCP9808_RegToTemp(regData, temperature);
+    }
+
+    return error;
+}
+
+/**
+ * @brief     Set critical temperature value. This value is used to generate
+ *             alert signals.
+ *
+ * @param dev Device handle.
+ * @param temperature Temperature to set.
+ * @return MCP9808_Error_t A number lower than '0' if something was wrong.
+ */
+MCP9808_Error_t MCP9808_SetCriticalTemperature( MCP9808_Device_t* dev, float temperature )
+{
+    MCP9808_STATS_API(dev, MCP9808_API_SET_CRITICAL_TEMPERATURE);
+    return MCP9808_SetLimitFloat(dev, MCP9808_REG_CRITICAL_TEMP, temperature);
+}
+
+/**
+ * @brief     Get critical temperature value (served from the register cache).
+ *
+ * @param dev Device handle.
+ * @param temperature Pointer to temperature storage.
+ * @return MCP9808_Error_t A number lower than '0' if something was wrong.
+ */
+MCP9808_Error_t MCP9808_GetCriticalTemperature( MCP9808_Device_t* dev, float* temperature )
+{
+    MCP9808_STATS_API(dev, MCP9808_API_GET_CRITICAL_TEMPERATURE);
+    return MCP9808_GetLimitFloat(dev, MCP9808_REG_CRITICAL_TEMP, temperature);
+}
+
+/**
+ * @brief     Set temperature window. This value are used to generate alert signals.
+ *            the alert function must be enabled.
+ *
+ * @param dev Device handle.
+ * @param upperTemp Upper temperature boundary
+ * @param lowerTemp Lower temperature boundary.
+ * @return MCP9808_Error_t A number lower than '0' if something was wrong.
+ */
+MCP9808_Error_t MCP9808_SetWindowTemperature( MCP9808_Device_t* dev, float upperTemp, float lowerTemp )
+{
+    MCP9808_Error_t error = MCP9808_ERROR;
+
+    MCP9808_STATS_API(dev, MCP9808_API_SET_WINDOW_TEMPERATURE);
+    error = MCP9808_SetLimitFloat(dev, MCP9808_REG_UPPER_TEMP, upperTemp);
+    if( !IS_MCP9808_ERROR(error) )
+    {
+        error = MCP9808_SetLimitFloat(dev, MCP9808_REG_LOWER_TEMP, lowerTemp);
+    }
+
+    return error;
+}
+
+/**
+ * @brief Get temperature window (served from the register cache).
+ *
+ * @param dev Device handle.
+ * @param upperTemp Upper temperature boundary storage.
+ * @param lowerTemp Lower temperature boundary storage.
+ * @return MCP9808_Error_t A number lower than '0' if something was wrong.
+ */
+MCP9808_Error_t MCP9808_GetWindowTemperature( MCP9808_Device_t* dev, float* upperTemp, float* lowerTemp )
+{
+    MCP9808_Error_t error = MCP9808_ERROR;
+
+    MCP9808_STATS_API(dev, MCP9808_API_GET_WINDOW_TEMPERATURE);
+    error = MCP9808_GetLimitFloat(dev, MCP9808_REG_UPPER_TEMP, upperTemp);
+    if( !IS_MCP9808_ERROR(error) )
+    {
+        error = MCP9808_GetLimitFloat(dev, MCP9808_REG_LOWER_TEMP, lowerTemp);
+    }
+
+    return error;
+}
+#endif /* MCP9808_USE_FLOAT */
+
+/**
+ * @brief Check that a lock bit is clear. Lock bits can not be cleared by a
+ *        CONFIG write: once set they stay set until the device power-on
+ *        reset, so nothing is ever written here.
+ *
+ * @param dev Device handle.
+ * @param lock MCP9808_CONFIG_WIN_LOCK or MCP9808_CONFIG_CRIT_LOCK.
+ * @return MCP9808_Error_t A number lower than '0' if the lock bit is set or CONFIG could not be read.
+ */
+static MCP9808_Error_t MCP9808_Unlock( MCP9808_Device_t* dev, uint16_t lock )
+{
+    MCP9808_Error_t error = MCP9808_ERROR;
+    uint16_t config = 0;
+
+    error = MCP9808_CacheGet(dev, MCP9808_REG_CONFIG, &config);
+    if( !IS_MCP9808_ERROR(error) && (config & lock) )
+    {
+        error = MCP9808_ERROR;
+    }
+
+    return error;
+}
+
+/**
+ * @brief Enable window register write protection. It can only be removed
+ *        by a device power-on reset.
+ *
+ * @param dev Device handle.
+ * @return MCP9808_Error_t A number lower than '0' if something was wrong.
+ */
+MCP9808_Error_t MCP9808_LockWindowTempReg( MCP9808_Device_t* dev )
+{
+    MCP9808_STATS_API(dev, MCP9808_API_LOCK);
+    return MCP9808_UpdateConfig(dev, MCP9808_CONFIG_WIN_LOCK, MCP9808_CONFIG_WIN_LOCK);
+}
+
+/**
+ * @brief Check that the window registers are not write protected. The
+ *        window lock only clears at power-on reset, so no write is sent.
+ *
+ * @param dev Device handle.
+ * @return MCP9808_Error_t A number lower than '0' if the lock is set (or CONFIG could not be read).
+ */
+MCP9808_Error_t MCP9808_UnlockWindowTempReg( MCP9808_Device_t* dev )
+{
+    MCP9808_STATS_API(dev, MCP9808_API_LOCK);
+    return MCP9808_Unlock(dev, MCP9808_CONFIG_WIN_LOCK);
+}
+
+/**
+ * @brief Enable critical temperature register write protection. It can
+ *        only be removed by a device power-on reset.
+ *
+ * @param dev Device handle.
+ * @return MCP9808_Error_t A number lower than '0' if something was wrong.
+ */
+MCP9808_Error_t MCP9808_LockCriticalTempReg( MCP9808_Device_t* dev )
+{
+    MCP9808_STATS_API(dev, MCP9808_API_LOCK);
+    return MCP9808_UpdateConfig(dev, MCP9808_CONFIG_CRIT_LOCK, MCP9808_CONFIG_CRIT_LOCK);
+}
+
+/**
+ * @brief Check that the critical temperature register is not write
+ *        protected. The critical lock only clears at power-on reset, so no
+ *        write is sent.
+ *
+ * @param dev Device handle.
+ * @return MCP9808_Error_t A number lower than '0' if the lock is set (or CONFIG could not be read).
+ */
+MCP9808_Error_t MCP9808_UnlockCriticalTempReg( MCP9808_Device_t* dev )
+{
+    MCP9808_STATS_API(dev, MCP9808_API_LOCK);
+    return MCP9808_Unlock(dev, MCP9808_CONFIG_CRIT_LOCK);
+}
+
+/**
+ * @brief Clear interrupt status.
+ *
+ * @param dev Device handle.
+ * @return MCP9808_Error_t A number lower than '0' if something was wrong.
+ */
+MCP9808_Error_t MCP9808_ClearInterrupt( MCP9808_Device_t* dev )
+{
+    MCP9808_STATS_API(dev, MCP9808_API_CLEAR_INTERRUPT);
+    return MCP9808_UpdateConfig(dev, MCP9808_CONFIG_CLEAR_IRQ, MCP9808_CONFIG_CLEAR_IRQ);
+}
+
+/**
+ * @brief Check if the alert is asserted. The alert status is volatile, so
+ *        CONFIG is always read from the device (and the cache refreshed).
+ *
+ * @param dev Device handle.
+ * @return MCP9808_Error_t A number lower than '0' if something was wrong.
+ */
+bool MCP9808_IsAlertAsserted( MCP9808_Device_t* dev )
+{
+    bool result = false;
+    MCP9808_Error_t error = MCP9808_ERROR;
+    uint8_t regData[MCP9808_REG_SIZE];
+
+    MCP9808_STATS_API(dev, MCP9808_API_IS_ALERT_ASSERTED);
+
+    error = MCP9808_ReadReg(dev,
+                                MCP9808_REG_CONFIG,
+                                MCP9808_REG_SIZE, regData);
+    if ( !IS_MCP9808_ERROR(error) )
+    {
+        result = regData[MCP9808_LSB]&MCP9808_CONFIG_ALERT_STATUS;
+
+        dev->cache.value[MCP9808_CACHE_CONFIG] = ((regData[MCP9808_MSB] << 8) | regData[MCP9808_LSB]) &
+                                                 ~(MCP9808_CONFIG_CLEAR_IRQ | MCP9808_CONFIG_ALERT_STATUS);
+        dev->cache.valid |= (1U << MCP9808_CACHE_CONFIG);
+    }
+
+    return result;
+}
+
+#if MCP9808_USE_ALERT_PIN
+/**
+ * @brief ALERT pin edge callback given to the port layer.
+ *
+ * @param context Device handle.
+ */
+static void MCP9808_AlertEdge( void* context )
+{
+    MCP9808_AlertNotify((MCP9808_Device_t*)context);
+}
+
+/**
+ * @brief     Handle alerts from the ALERT pin instead of polling
+ *            MCP9808_IsAlertAsserted(). The pin is attached through the port
+ *            layer; each asserting edge is decoded by MCP9808_AlertProcess(),
+ *            which calls "handler". The alert output itself is configured as
+ *            usual (MCP9808_EnableAlert(), mode, polarity, output).
+ *
+ * @param dev Device handle.
+ * @param handler Alert handler, NULL to detach the pin.
+ * @param context Handler context.
+ * @return MCP9808_Error_t A number lower than '0' if something was wrong.
+ */
+MCP9808_Error_t MCP9808_SetAlertHandler( MCP9808_Device_t* dev, MCP9808_Alert_Handler_t handler, void* context )
+{
+    MCP9808_Error_t error = MCP9808_ERROR;
+
+    if( (dev != NULL) && dev->isInitialized )
+    {
+        dev->alertHandler = handler;
+        dev->alertContext = context;
+        dev->alertPending = false;
+
+        error = MCP9808_PORT_AlertAttach(dev->bus, dev->address,
+                                         (handler != NULL) ? MCP9808_AlertEdge : NULL, dev);
+    }
+
+    return error;
+}
+
+/**
+ * @brief Report an ALERT pin edge. It only flags the event, so it can be
+ *        called from the GPIO interrupt handler; the bus is accessed later
+ *        by MCP9808_AlertProcess().
+ *
+ * @param dev Device handle.
+ */
+void MCP9808_AlertNotify( MCP9808_Device_t* dev )
+{
+    if( dev != NULL )
+    {
+        dev->alertPending = true;
+    }
+}
+
+/**
+ * @brief     Process a pending alert: TA is read once to know which limits
+ *            fired (TCRIT, TUPPER, TLOWER), the interrupt is cleared (interrupt
+ *            output mode) and the handler is called. Without pending alert
+ *            nothing is done, so it can be called on every loop iteration
+ *            without bus traffic.
+ *
+ * @param dev Device handle.
+ * @return MCP9808_Error_t A number lower than '0' if something was wrong.
+ */
+MCP9808_Error_t MCP9808_AlertProcess( MCP9808_Device_t* dev )
+{
+    MCP9808_Error_t error = MCP9808_ERROR;
+    MCP9808_Alert_Event_t event;
+    uint16_t config = 0;
+
+    if( dev != NULL )
+    {
+        error = MCP9808_OK;
+
+        if( dev->alertPending )
+        {
+            /* Edges seen from now on trigger a new process */
+            dev->alertPending = false;
+
+            MCP9808_STATS_API(dev, MCP9808_API_ALERT_PROCESS);
+            error = MCP9808_ReadTA(dev, &event.raw);
+            if( !IS_MCP9808_ERROR(error) )
+            {
+                event.temperature = MCP9808_RegToQ4(event.raw);
+                event.flags = event.raw & MCP9808_TA_FLAGS_MSK;
+
+                error = MCP9808_CacheGet(dev, MCP9808_REG_CONFIG, &config);
+            }
+            if( !IS_MCP9808_ERROR(error) && ((config & MCP9808_ALERT_OUTPUT_MSK) == MCP9808_ALERT_OUTPUT_IRQ) )
+            {
+                error = MCP9808_UpdateConfig(dev, MCP9808_CONFIG_CLEAR_IRQ, MCP9808_CONFIG_CLEAR_IRQ);
+            }
+            if( !IS_MCP9808_ERROR(error) && (dev->alertHandler != NULL) )
+            {
+                dev->alertHandler(dev->alertContext, &event);
+            }
+        }
+    }
+
+    return error;
+}
+#endif /* MCP9808_USE_ALERT_PIN */
+
+/**
+ * @brief Enable alert function.
+ *
+ * @param dev Device handle.
+ * @return MCP9808_Error_t A number lower than '0' if something was wrong.
+ */
+MCP9808_Error_t MCP9808_EnableAlert( MCP9808_Device_t* dev )
+{
+    MCP9808_STATS_API(dev, MCP9808_API_SET_ALERT);
+    return MCP9808_UpdateConfig(dev, MCP9808_CONFIG_ALERT_CONTROL, MCP9808_CONFIG_ALERT_CONTROL);
+}
+
+/**
+ * @brief Disable alert function.
+ *
+ * @param dev Device handle.
+ * @return MCP9808_Error_t A number lower than '0' if something was wrong.
+ */
+MCP9808_Error_t MCP9808_DisableAlert( MCP9808_Device_t* dev )
+{
+    MCP9808_STATS_API(dev, MCP9808_API_SET_ALERT);
+    return MCP9808_UpdateConfig(dev, MCP9808_CONFIG_ALERT_CONTROL, 0U);
+}
+
+/**
+ * @brief     Set alert output assert mode. If it is set to "MCP9808_ALERT_MODE_ALL"
+ *             the output will be updated when the current temperature crosses any boundary,
+ *             otherwise, the output will only be updated when it crosses TCRIT.
+ *
+ * @param dev Device handle.
+ * @param mode Output mode.
+ * @return MCP9808_Error_t A number lower than '0' if something was wrong.
+ */
+MCP9808_Error_t MCP9808_SetAlertMode( MCP9808_Device_t* dev, MCP9808_Alert_Mode_t mode )
+{
+    MCP9808_STATS_API(dev, MCP9808_API_SET_ALERT);
+    return MCP9808_UpdateConfig(dev, MCP9808_ALERT_MODE_MSK, mode);
+}
+
+/**
+ * @brief    Set alert output polarity (HIGH or LOW).
+ *
+ * @param dev Device handle.
+ * @param polarity Polarity to set.
+ * @return MCP9808_Error_t A number lower than '0' if something was wrong.
+ */
+MCP9808_Error_t MCP9808_SetAlertPolarity( MCP9808_Device_t* dev, MCP9808_Alert_Polarity_t polarity )
+{
+    MCP9808_STATS_API(dev, MCP9808_API_SET_ALERT);
+    return MCP9808_UpdateConfig(dev, MCP9808_ALERT_POL_MSK, polarity);
+}
+
+/**
+ * @brief Set alert output mode (compare or IRQ).
+ *
+ * @param dev Device handle.
+ * @param output Output mode to set.
+ * @return MCP9808_Error_t A number lower than '0' if something was wrong.
+ */
+MCP9808_Error_t MCP9808_SetAlertOutput( MCP9808_Device_t* dev, MCP9808_Alert_Output_t output )
+{
+    MCP9808_STATS_API(dev, MCP9808_API_SET_ALERT);
+    return MCP9808_UpdateConfig(dev, MCP9808_ALERT_OUTPUT_MSK, output);
+}
+
+/**
+ * @brief Get device ID and revision.
+ *
+ * @param dev Device handle.
+ * @param id Pointer to ID storage.
+ * @param revision Pointer to revision storage.
+ * @return MCP9808_Error_t A number lower than '0' if something was wrong.
+ */
+MCP9808_Error_t MCP9808_GetID( MCP9808_Device_t* dev, uint8_t* id, uint8_t* revision )
+{
+    MCP9808_Error_t error = MCP9808_ERROR;
+    uint8_t regData[MCP9808_REG_SIZE];
+
+    MCP9808_STATS_API(dev, MCP9808_API_GET_ID);
+
+    error = MCP9808_ReadReg(dev,
+                                MCP9808_REG_ID_2,
+                                MCP9808_REG_SIZE, regData);
+    if ( !IS_MCP9808_ERROR(error) && (id != NULL) && (revision != NULL) )
+    {
+        *id = regData[MCP9808_MSB];
+        *revision = regData[MCP9808_LSB];
+    }
+
+    return error;
+}
+
+/**
+ * @brief Get hysteresis configuration (served from the register cache).
+ *
+ * @param dev Device handle.
+ * @param hysteresis Pointer to hysteresis mode storage.
+ * @return MCP9808_Error_t A number lower than '0' if something was wrong.
+ */
+MCP9808_Error_t MCP9808_GetHysteresis( MCP9808_Device_t* dev, MCP9808_Hysteresis_t* hysteresis )
+{
+    MCP9808_Error_t error = MCP9808_ERROR;
+    uint16_t config = 0;
+
+    MCP9808_STATS_API(dev, MCP9808_API_GET_HYSTERESIS);
+    error = MCP9808_CacheGet(dev, MCP9808_REG_CONFIG, &config);
+    if ( !IS_MCP9808_ERROR(error) && (hysteresis != NULL) )
+    {
+        *hysteresis = (config >> 8) & MCP9808_HYST_MSK;
+    }
+
+    return error;
+}
+
+/**
+ * @brief Set hysteresis configuration.
+ *
+ * @param dev Device handle.
+ * @param hysteresis Hysteresis mode.
+ * @return MCP9808_Error_t A number lower than '0' if something was wrong.
+ */
+MCP9808_Error_t MCP9808_SetHysteresis( MCP9808_Device_t* dev, MCP9808_Hysteresis_t hysteresis )
+{
+    MCP9808_STATS_API(dev, MCP9808_API_SET_HYSTERESIS);
+    return MCP9808_UpdateConfig(dev, (uint16_t)MCP9808_HYST_MSK << 8, (uint16_t)hysteresis << 8);
+}
+
+/**
+ * @brief Set temperature resolution configuration.
+ *
+ * @param dev Device handle.
+ * @param resolution Temperature resolution storage.
+ * @return MCP9808_Error_t A number lower than '0' if something was wrong.
+ */
+MCP9808_Error_t MCP9808_SetResolution( MCP9808_Device_t* dev, MCP9808_Resolution_t resolution )
+{
+    MCP9808_Error_t error = MCP9808_ERROR;
+    uint16_t regData = 0;
+
+    MCP9808_STATS_API(dev, MCP9808_API_SET_RESOLUTION);
+    error = MCP9808_CacheGet(dev, MCP9808_REG_RESOLUTION, &regData);
+    if ( !IS_MCP9808_ERROR(error) )
+    {
+        regData &= ~(MCP9808_RESOLUTION_MSK);
+        regData |= resolution&MCP9808_RESOLUTION_MSK;
+
+        error = MCP9808_CacheSet(dev, MCP9808_REG_RESOLUTION, regData);
+    }
+
+    return error;
+}
+
+/**
+ * @brief     Enter or leave shutdown mode (SHDN). In shutdown the device
+ *            stops converting (TA keeps the last value) and the bus stays
+ *            available. Shutdown cannot be entered while a lock bit is set.
+ *
+ * @param dev Device handle.
+ * @param shutdown True to enter shutdown, false to resume conversions.
+ * @return MCP9808_Error_t A number lower than '0' if something was wrong.
+ */
+MCP9808_Error_t MCP9808_SetShutdown( MCP9808_Device_t* dev, bool shutdown )
+{
+    MCP9808_Error_t error = MCP9808_ERROR;
+    uint16_t config = 0;
+
+    MCP9808_STATS_API(dev, MCP9808_API_SHUTDOWN);
+    error = MCP9808_CacheGet(dev, MCP9808_REG_CONFIG, &config);
+    if( !IS_MCP9808_ERROR(error) )
+    {
+        if( shutdown && (config & (MCP9808_CONFIG_CRIT_LOCK | MCP9808_CONFIG_WIN_LOCK)) )
+        {
+            error = MCP9808_ERROR;
+        }
+        else
+        {
+            error = MCP9808_UpdateConfig(dev, MCP9808_CONFIG_SHDN, shutdown ? MCP9808_CONFIG_SHDN : 0U);
+        }
+    }
+
+    return error;
+}
+
+#if MCP9808_USE_ONESHOT
+/**
+ * @brief     Take a single sample from shutdown: wake the device up, wait for
+ *            one conversion at "resolution", read TA and shut it down again.
+ *            With CONFIG and RESOLUTION cached it costs 3 bus transactions
+ *            (wake-up write, TA read, shutdown write). The device is left in
+ *            shutdown even if the read fails.
+ *            The awake time is measured with MCP9808_PORT_GetTimeUs(); the
+ *            energy is estimated from it (MCP9808_VDD_MV, typical IDD).
+ *
+ * @param dev Device handle.
+ * @param resolution Conversion resolution (sets the wait: 30 to 250 ms).
+ * @param result Sample and cost storage.
+ * @return MCP9808_Error_t A number lower than '0' if something was wrong.
+ */
+MCP9808_Error_t MCP9808_ReadTemperatureOneShot( MCP9808_Device_t* dev, MCP9808_Resolution_t resolution,
+                                                MCP9808_OneShot_t* result )
+{
+    MCP9808_Error_t error = MCP9808_ERROR;
+    MCP9808_Error_t sleepError = MCP9808_ERROR;
+    uint16_t current = 0;
+    uint16_t config = 0;
+    uint32_t waitUs = 0;
+    uint32_t transfers = 0;
+    uint32_t wakeUs = 0;
+
+    MCP9808_STATS_API(dev, MCP9808_API_ONESHOT);
+    if( (dev != NULL) && (result != NULL) )
+    {
+        result->raw = 0U;
+        result->temperature = 0;
+        result->awakeUs = 0U;
+        result->energyNj = 0U;
+        result->transfers = 0U;
+        transfers = dev->transfers;
+
+        error = MCP9808_CacheGet(dev, MCP9808_REG_CONFIG, &config);
+    }
+    if( !IS_MCP9808_ERROR(error) && (config & (MCP9808_CONFIG_CRIT_LOCK | MCP9808_CONFIG_WIN_LOCK)) )
+    {
+        /* It could not go back to shutdown */
+        error = MCP9808_ERROR;
+    }
+    if( !IS_MCP9808_ERROR(error) )
+    {
+        error = MCP9808_CacheGet(dev, MCP9808_REG_RESOLUTION, &current);
+    }
+    if( !IS_MCP9808_ERROR(error) && ((current & MCP9808_RESOLUTION_MSK) != (resolution & MCP9808_RESOLUTION_MSK)) )
+    {
+        error = MCP9808_CacheSet(dev, MCP9808_REG_RESOLUTION, resolution & MCP9808_RESOLUTION_MSK);
+    }
+
+    if( !IS_MCP9808_ERROR(error) )
+    {
+        wakeUs = MCP9808_PORT_GetTimeUs(dev->bus);
+        error = MCP9808_UpdateConfig(dev, MCP9808_CONFIG_SHDN, 0U);
+
+        if( !IS_MCP9808_ERROR(error) )
+        {
+            waitUs = MCP9808_ConversionTimeUs(resolution);
+            waitUs += (waitUs / 100U) * MCP9808_ONESHOT_MARGIN_PCT;
+            MCP9808_PORT_DelayUs(dev->bus, waitUs);
+
+            error = MCP9808_ReadTA(dev, &result->raw);
+            result->temperature = MCP9808_RegToQ4(result->raw);
+        }
+
+        sleepError = MCP9808_UpdateConfig(dev, MCP9808_CONFIG_SHDN, MCP9808_CONFIG_SHDN);
+        result->awakeUs = MCP9808_PORT_GetTimeUs(dev->bus) - wakeUs;
+        result->energyNj = (uint32_t)(((uint64_t)MCP9808_VDD_MV * MCP9808_IDD_UA * result->awakeUs) / 1000000U);
+        error = IS_MCP9808_ERROR(error) ? error : sleepError;
+    }
+
+    if( (dev != NULL) && (result != NULL) )
+    {
+        /* Only the transactions that reached the bus: cache hits and skipped writes cost nothing */
+        result->transfers = (uint8_t)(dev->transfers - transfers);
+    }
+
+    return error;
+}
+#endif /* MCP9808_USE_ONESHOT */
+
+/**
+ * @brief Get temperature resolution configuration (served from the register cache).
+ *
+ * @param dev Device handle.
+ * @param resolution Temperature resolution.
+ * @return MCP9808_Error_t A number lower than '0' if something was wrong.
+ */
+MCP9808_Error_t MCP9808_GetResolution( MCP9808_Device_t* dev, MCP9808_Resolution_t* resolution )
+{
+    MCP9808_Error_t error = MCP9808_ERROR;
+    uint16_t regData = 0;
+
+    MCP9808_STATS_API(dev, MCP9808_API_GET_RESOLUTION);
+    error = MCP9808_CacheGet(dev, MCP9808_REG_RESOLUTION, &regData);
+    if ( !IS_MCP9808_ERROR(error) && (resolution != NULL) )
+    {
+        *resolution = regData &MCP9808_RESOLUTION_MSK;
+    }
+
+    return error;
+}
+
+/**
+ * @brief Get the manufacturer ID (0x0054).
+ *
+ * @param dev Device handle.
+ * @param id Manufacturer ID.
+ * @return MCP9808_Error_t A number lower than '0' if something was wrong.
+ */
+MCP9808_Error_t MCP9808_GetManufactureID( MCP9808_Device_t* dev, uint16_t*id )
+{
+    MCP9808_Error_t error = MCP9808_ERROR;
+    uint8_t regData[MCP9808_REG_SIZE];
+
+    MCP9808_STATS_API(dev, MCP9808_API_GET_ID);
+
+    error = MCP9808_ReadReg(dev,
+                                MCP9808_REG_ID_1,
+                                MCP9808_REG_SIZE, regData);
+    if ( !IS_MCP9808_ERROR(error) && (id != NULL) )
+    {
+        *id = (regData[MCP9808_MSB] << 8) | regData[MCP9808_LSB];
+    }
+
+    return error;
+}
+
+/**
+ * @brief Clear a staged configuration.
+ *
+ * @param stage Staged configuration storage.
+ * @return MCP9808_Error_t A number lower than '0' if something was wrong.
+ */
+MCP9808_Error_t MCP9808_StageInit( MCP9808_Stage_t* stage )
+{
+    MCP9808_Error_t error = MCP9808_ERROR;
+
+    if( stage != NULL )
+    {
+        memset(stage, 0, sizeof(*stage));
+        error = MCP9808_OK;
+    }
+
+    return error;
+}
+
+/**
+ * @brief Stage CONFIG register bits.
+ *
+ * @param stage Staged configuration.
+ * @param mask Bits to update.
+ * @param bits New bits value.
+ * @return MCP9808_Error_t A number lower than '0' if something was wrong.
+ */
+static MCP9808_Error_t MCP9808_StageConfig( MCP9808_Stage_t* stage, uint16_t mask, uint16_t bits )
+{
+    MCP9808_Error_t error = MCP9808_ERROR;
+
+    if( stage != NULL )
+    {
+        stage->value[MCP9808_CACHE_CONFIG] &= ~mask;
+        stage->value[MCP9808_CACHE_CONFIG] |= bits & mask;
+        stage->configMask |= mask;
+        stage->dirty |= (1U << MCP9808_CACHE_CONFIG);
+        error = MCP9808_OK;
+    }
+
+    return error;
+}
+
+/**
+ * @brief Stage a register value.
+ *
+ * @param stage Staged configuration.
+ * @param slot Cache slot of the register.
+ * @param value Register value (MSB << 8 | LSB).
+ * @return MCP9808_Error_t A number lower than '0' if something was wrong.
+ */
+static MCP9808_Error_t MCP9808_StageReg( MCP9808_Stage_t* stage, MCP9808_Cache_Slot_t slot, uint16_t value )
+{
+    MCP9808_Error_t error = MCP9808_ERROR;
+
+    if( stage != NULL )
+    {
+        stage->value[slot] = value;
+        stage->dirty |= (1U << slot);
+        error = MCP9808_OK;
+    }
+
+    return error;
+}
+
+#if MCP9808_USE_FLOAT
+/**
+ * @brief Stage a temperature limit register from a float value.
+ *
+ * @param stage Staged configuration.
+ * @param slot Cache slot of the limit register.
+ * @param temperature Temperature to set.
+ * @return MCP9808_Error_t A number lower than '0' if something was wrong.
+ */
+static MCP9808_Error_t MCP9808_StageLimitFloat( MCP9808_Stage_t* stage, MCP9808_Cache_Slot_t slot, float temperature )
+{
+    MCP9808_Error_t error = MCP9808_ERROR;
+    uint8_t regData[MCP9808_REG_SIZE];
+
+    error = MCP9808_TempToReg(regData, &temperature);
+    if( !IS_MCP9808_ERROR(error) )
+    {
+        error = MCP9808_StageReg(stage, slot, (regData[MCP9808_MSB] << 8) | regData[MCP9808_LSB]);
+    }
+
+    return error;
+}
+#endif /* MCP9808_USE_FLOAT */
+
+/**
+ * @brief Stage alert output enable/disable.
+ *
+ * @param stage Staged configuration.
+ * @param enable True to enable the alert output.
+ * @return MCP9808_Error_t A number lower than '0' if something was wrong.
+ */
+MCP9808_Error_t MCP9808_StageAlert( MCP9808_Stage_t* stage, bool enable )
+{
+    return MCP9808_StageConfig(stage, MCP9808_CONFIG_ALERT_CONTROL,
+                               enable ? MCP9808_CONFIG_ALERT_CONTROL : 0U);
+}
+
+/**
+ * @brief Stage alert output assert mode. See MCP9808_SetAlertMode().
+ *
+ * @param stage Staged configuration.
+ * @param mode Output mode.
+ * @return MCP9808_Error_t A number lower than '0' if something was wrong.
+ */
+MCP9808_Error_t MCP9808_StageAlertMode( MCP9808_Stage_t* stage, MCP9808_Alert_Mode_t mode )
+{
+    return MCP9808_StageConfig(stage, MCP9808_ALERT_MODE_MSK, mode);
+}
+
+/**
+ * @brief Stage alert output polarity.
+ *
+ * @param stage Staged configuration.
+ * @param polarity Polarity to set.
+ * @return MCP9808_Error_t A number lower than '0' if something was wrong.
+ */
+MCP9808_Error_t MCP9808_StageAlertPolarity( MCP9808_Stage_t* stage, MCP9808_Alert_Polarity_t polarity )
+{
+    return MCP9808_StageConfig(stage, MCP9808_ALERT_POL_MSK, polarity);
+}
+
+/**
+ * @brief Stage alert output mode (compare or IRQ).
+ *
+ * @param stage Staged configuration.
+ * @param output Output mode to set.
+ * @return MCP9808_Error_t A number lower than '0' if something was wrong.
+ */
+MCP9808_Error_t MCP9808_StageAlertOutput( MCP9808_Stage_t* stage, MCP9808_Alert_Output_t output )
+{
+    return MCP9808_StageConfig(stage, MCP9808_ALERT_OUTPUT_MSK, output);
+}
+
+/**
+ * @brief Stage hysteresis configuration.
+ *
+ * @param stage Staged configuration.
+ * @param hysteresis Hysteresis mode.
+ * @return MCP9808_Error_t A number lower than '0' if something was wrong.
+ */
+MCP9808_Error_t MCP9808_StageHysteresis( MCP9808_Stage_t* stage, MCP9808_Hysteresis_t hysteresis )
+{
+    return MCP9808_StageConfig(stage, (uint16_t)MCP9808_HYST_MSK << 8, (uint16_t)hysteresis << 8);
+}
+
+/**
+ * @brief Stage temperature resolution configuration.
+ *
+ * @param stage Staged configuration.
+ * @param resolution Temperature resolution.
+ * @return MCP9808_Error_t A number lower than '0' if something was wrong.
+ */
+MCP9808_Error_t MCP9808_StageResolution( MCP9808_Stage_t* stage, MCP9808_Resolution_t resolution )
+{
+    return MCP9808_StageReg(stage, MCP9808_CACHE_RESOLUTION, resolution&MCP9808_RESOLUTION_MSK);
+}
+
+/**
+ * @brief Stage critical temperature value in sixteenths of a degree.
+ *
+ * @param stage Staged configuration.
+ * @param temperature Temperature to set (1/16 °C).
+ * @return MCP9808_Error_t A number lower than '0' if something was wrong.
+ */
+MCP9808_Error_t MCP9808_StageCriticalTemperatureQ4( MCP9808_Stage_t* stage, int16_t temperature )
+{
+    return MCP9808_StageReg(stage, MCP9808_CACHE_CRITICAL_TEMP, MCP9808_Q4ToReg(temperature));
+}
+
+/**
+ * @brief Stage temperature window in sixteenths of a degree.
+ *
+ * @param stage Staged configuration.
+ * @param upperTemp Upper temperature boundary (1/16 °C).
+ * @param lowerTemp Lower temperature boundary (1/16 °C).
+ * @return MCP9808_Error_t A number lower than '0' if something was wrong.
+ */
+MCP9808_Error_t MCP9808_StageWindowTemperatureQ4( MCP9808_Stage_t* stage, int16_t upperTemp, int16_t lowerTemp )
+{
+    MCP9808_Error_t error = MCP9808_ERROR;
+
+    error = MCP9808_StageReg(stage, MCP9808_CACHE_UPPER_TEMP, MCP9808_Q4ToReg(upperTemp));
+    if( !IS_MCP9808_ERROR(error) )
+    {
+        error = MCP9808_StageReg(stage, MCP9808_CACHE_LOWER_TEMP, MCP9808_Q4ToReg(lowerTemp));
+    }
+
+    return error;
+}
+
+#if MCP9808_USE_FLOAT
+/**
+ * @brief Stage critical temperature value.
+ *
+ * @param stage Staged configuration.
+ * @param temperature Temperature to set.
+ * @return MCP9808_Error_t A number lower than '0' if something was wrong.
+ */
+MCP9808_Error_t MCP9808_StageCriticalTemperature( MCP9808_Stage_t* stage, float temperature )
+{
+    return MCP9808_StageLimitFloat(stage, MCP9808_CACHE_CRITICAL_TEMP, temperature);
+}
+
+/**
+ * @brief Stage temperature window.
+ *
+ * @param stage Staged configuration.
+ * @param upperTemp Upper temperature boundary.
+ * @param lowerTemp Lower temperature boundary.
+ * @return MCP9808_Error_t A number lower than '0' if something was wrong.
+ */
+MCP9808_Error_t MCP9808_StageWindowTemperature( MCP9808_Stage_t* stage, float upperTemp, float lowerTemp )
+{
+    MCP9808_Error_t error = MCP9808_ERROR;
+
+    error = MCP9808_StageLimitFloat(stage, MCP9808_CACHE_UPPER_TEMP, upperTemp);
+    if( !IS_MCP9808_ERROR(error) )
+    {
+        error = MCP9808_StageLimitFloat(stage, MCP9808_CACHE_LOWER_TEMP, lowerTemp);
+    }
+
+    return error;
+}
+#endif /* MCP9808_USE_FLOAT */
+
+/**
+ * @brief Stage register write protection. Locks are always applied last.
+ *
+ * @param stage Staged configuration.
+ * @param window True to lock T UPPER and T LOWER.
+ * @param critical True to lock T CRIT.
+ * @return MCP9808_Error_t A number lower than '0' if something was wrong.
+ */
+MCP9808_Error_t MCP9808_StageLock( MCP9808_Stage_t* stage, bool window, bool critical )
+{
+    return MCP9808_StageConfig(stage, MCP9808_CONFIG_WIN_LOCK | MCP9808_CONFIG_CRIT_LOCK,
+                               (window ? MCP9808_CONFIG_WIN_LOCK : 0U) |
+                               (critical ? MCP9808_CONFIG_CRIT_LOCK : 0U));
+}
+
+/**
+ * @brief     Apply a staged configuration with the minimum number of writes.
+ *            Limit and resolution registers are written first (at most one
+ *            write each, skipped if the cached value already matches), then
+ *            CONFIG with a single write. Lock bits, if staged, are set by a
+ *            last CONFIG write so that every other change lands before them.
+ *
+ * @param dev Device handle.
+ * @param stage Staged configuration.
+ * @return MCP9808_Error_t A number lower than '0' if something was wrong.
+ */
+MCP9808_Error_t MCP9808_StageCommit( MCP9808_Device_t* dev, const MCP9808_Stage_t* stage )
+{
+    static const uint8_t regs[MCP9808_CACHE_SIZE] =
+    {
+        MCP9808_REG_CONFIG, MCP9808_REG_UPPER_TEMP, MCP9808_REG_LOWER_TEMP,
+        MCP9808_REG_CRITICAL_TEMP, MCP9808_REG_RESOLUTION
+    };
+    const uint16_t locks = MCP9808_CONFIG_CRIT_LOCK | MCP9808_CONFIG_WIN_LOCK;
+    MCP9808_Error_t error = MCP9808_ERROR;
+    uint16_t config = 0;
+    uint16_t target = 0;
+    uint16_t unlocked = 0;
+    uint8_t slot = 0;
+
+    MCP9808_STATS_API(dev, MCP9808_API_STAGE_COMMIT);
+    if( (dev != NULL) && (stage != NULL) )
+    {
+        error = MCP9808_OK;
+
+        for( slot = MCP9808_CACHE_UPPER_TEMP; (slot < MCP9808_CACHE_SIZE) && !IS_MCP9808_ERROR(error); slot++ )
+        {
+            if( (stage->dirty & (1U << slot)) &&
+                !((dev->cache.valid & (1U << slot)) && (dev->cache.value[slot] == stage->value[slot])) )
+            {
+                error = MCP9808_CacheSet(dev, regs[slot], stage->value[slot]);
+            }
+        }
+
+        if( !IS_MCP9808_ERROR(error) && (stage->dirty & (1U << MCP9808_CACHE_CONFIG)) )
+        {
+            error = MCP9808_CacheGet(dev, MCP9808_REG_CONFIG, &config);
+            if( !IS_MCP9808_ERROR(error) )
+            {
+                target = (config & ~stage->configMask) | (stage->value[MCP9808_CACHE_CONFIG] & stage->configMask);
+                unlocked = (target & ~locks) | (config & locks);
+
+                if( unlocked != config )
+                {
+                    error = MCP9808_CacheSet(dev, MCP9808_REG_CONFIG, unlocked);
+                }
+                if( !IS_MCP9808_ERROR(error) && (target != unlocked) )
+                {
+                    error = MCP9808_CacheSet(dev, MCP9808_REG_CONFIG, target);
+                }
+            }
+        }
+    }
+
+    return error;
+}
+
+#if MCP9808_USE_ASYNC
+/**
+ * @brief Port completion callback of every asynchronous request.
+ *        Decodes read data, updates the shadow copy for writes and
+ *        notifies the user. It runs in the port completion context and
+ *        updates the device cache and statistics without locking: the
+ *        device must not be used by other functions until the request
+ *        is done.
+ *
+ * @param context Request.
+ * @param result Transfer result.
+ */
+static void MCP9808_AsyncDone( void* context, MCP9808_Error_t result )
+{
+    MCP9808_Request_t* request = (MCP9808_Request_t*)context;
+
+#if MCP9808_USE_STICKY_POINTER
+    MCP9808_PointerSet(request->dev, request->reg, result);
+#endif /* MCP9808_USE_STICKY_POINTER */
+#if MCP9808_USE_STATS
+    MCP9808_StatsRecord(request->dev, MCP9808_API_ASYNC, request->reg, request->write,
+                        1U + MCP9808_RegSize(request->reg), result, request->start);
+#endif /* MCP9808_USE_STATS */
+    if( request->write )
+    {
+        MCP9808_CacheWritten(request->dev, request->reg, request->value, result);
+        if( request->reg == MCP9808_REG_CONFIG )
+        {
+            /* The cache is up to date: the next CONFIG update can be built on it */
+            request->dev->configPending = false;
+        }
+    }
+    else if( !IS_MCP9808_ERROR(result) )
+    {
+        request->value = (request->data[MCP9808_MSB] << 8) | request->data[MCP9808_LSB];
+        request->temperature = MCP9808_RegToQ4(request->value);
+    }
+
+    request->result = result;
+    request->state = MCP9808_REQUEST_DONE;
+
+    if( request->callback != NULL )
+    {
+        request->callback(request);
+    }
+}
+
+/**
+ * @brief Fill a request and submit it to the port layer.
+ *
+ * @param dev Device handle.
+ * @param request Request storage.
+ * @param reg Register.
+ * @param write True to write "value", false to read the register.
+ * @param value Value to write (MSB << 8 | LSB).
+ * @param callback Completion callback (can be NULL).
+ * @param context User context.
+ * @return MCP9808_Error_t A number lower than '0' if the request could not be submitted.
+ */
+static MCP9808_Error_t MCP9808_Submit( MCP9808_Device_t* dev, MCP9808_Request_t* request, uint8_t reg,
+                                       bool write, uint16_t value, MCP9808_Callback_t callback, void* context )
+{
+    MCP9808_Error_t error = MCP9808_ERROR;
+    uint8_t size = MCP9808_RegSize(reg);
+
+    if( (dev != NULL) && dev->isInitialized && (request != NULL) &&
+        (request->state != MCP9808_REQUEST_PENDING) )
+    {
+        request->dev = dev;
+        request->callback = callback;
+        request->context = context;
+        request->result = MCP9808_ERROR;
+        request->value = value;
+        request->temperature = 0;
+        request->reg = reg;
+        request->write = write;
+        request->state = MCP9808_REQUEST_PENDING;
+#if MCP9808_USE_STICKY_POINTER
+        dev->pointer = MCP9808_POINTER_UNKNOWN;
+#endif /* MCP9808_USE_STICKY_POINTER */
+#if MCP9808_USE_STATS
+        request->start = MCP9808_PORT_GetTimeUs(dev->bus);
+#endif /* MCP9808_USE_STATS */
+
+        if( write )
+        {
+            MCP9808_EncodeReg(reg, value, request->data);
+            error = MCP9808_PORT_WriteAsync(dev->bus, dev->address, reg, size, request->data,
+                                            MCP9808_AsyncDone, request);
+        }
+        else
+        {
+            error = MCP9808_PORT_ReadAsync(dev->bus, dev->address, reg, size, request->data,
+                                           MCP9808_AsyncDone, request);
+        }
+
+        if( IS_MCP9808_ERROR(error) )
+        {
+            request->result = error;
+            request->state = MCP9808_REQUEST_DONE;
+        }
+    }
+
+    return error;
+}
+
+/**
+ * @brief Complete a request without bus traffic (nothing to write).
+ *
+ * @param dev Device handle.
+ * @param request Request storage.
+ * @param callback Completion callback (can be NULL).
+ * @param context User context.
+ * @return MCP9808_Error_t A number lower than '0' if the request is still pending.
+ */
+static MCP9808_Error_t MCP9808_CompleteNow( MCP9808_Device_t* dev, MCP9808_Request_t* request,
+                                            MCP9808_Callback_t callback, void* context )
+{
+    MCP9808_Error_t error = MCP9808_ERROR;
+
+    if( request->state != MCP9808_REQUEST_PENDING )
+    {
+        request->dev = dev;
+        request->callback = callback;
+        request->context = context;
+        request->write = false;
+        request->result = MCP9808_OK;
+        request->state = MCP9808_REQUEST_DONE;
+        error = MCP9808_OK;
+
+        if( callback != NULL )
+        {
+            callback(request);
+        }
+    }
+
+    return error;
+}
+
+/**
+ * @brief Check if an asynchronous request has finished. Can be used
+ *        instead of a completion callback.
+ *
+ * @param request Request.
+ * @return true if the request is done and "result" is valid.
+ */
+bool MCP9808_IsRequestDone( const MCP9808_Request_t* request )
+{
+    return (request != NULL) && (request->state == MCP9808_REQUEST_DONE);
+}
+
+/**
+ * @brief     Start a temperature read. On completion "value" holds the raw TA
+ *            register and "temperature" the decoded value (1/16 °C).
+ *            Requests to different devices can be queued back to back.
+ *
+ * @param dev Device handle.
+ * @param request Request storage, zero-initialised before its first use. It must
+ *                stay valid until it is done and is refused while pending.
+ * @param callback Completion callback (can be NULL to poll the request).
+ * @param context User context.
+ * @return MCP9808_Error_t A number lower than '0' if the request could not be submitted.
+ */
+MCP9808_Error_t MCP9808_ReadTemperatureAsync( MCP9808_Device_t* dev, MCP9808_Request_t* request,
+                                              MCP9808_Callback_t callback, void* context )
+{
+    return MCP9808_Submit(dev, request, MCP9808_REG_TEMPERATURE, false, 0U, callback, context);
+}
+
+/**
+ * @brief     Start a CONFIG bits update (single write). It is the asynchronous
+ *            version of the enable/alert/lock/clear functions, e.g.
+ *            mask = bits = MCP9808_CONFIG_CLEAR_IRQ clears the interrupt.
+ *            CONFIG must be cached (see MCP9808_SyncCache()). The new value
+ *            is built on the cached one, which is only updated on completion,
+ *            so a second update is refused while one is pending for the same
+ *            device. The request completes immediately if nothing has to be
+ *            written.
+ *
+ * @param dev Device handle.
+ * @param request Request storage, zero-initialised before its first use. It must
+ *                stay valid until it is done and is refused while pending.
+ * @param mask Bits to update (MCP9808_Config_t, hysteresis bits << 8).
+ * @param bits New bits value.
+ * @param callback Completion callback (can be NULL to poll the request).
+ * @param context User context.
+ * @return MCP9808_Error_t A number lower than '0' if the request could not be submitted
+ *         (request or CONFIG update already pending included).
+ */
+MCP9808_Error_t MCP9808_UpdateConfigAsync( MCP9808_Device_t* dev, MCP9808_Request_t* request, uint16_t mask,
+                                           uint16_t bits, MCP9808_Callback_t callback, void* context )
+{
+    MCP9808_Error_t error = MCP9808_ERROR;
+    uint16_t config = 0;
+    uint16_t newConfig = 0;
+
+    if( (dev != NULL) && (request != NULL) && (request->state != MCP9808_REQUEST_PENDING) &&
+        (dev->cache.valid & (1U << MCP9808_CACHE_CONFIG)) && !dev->configPending )
+    {
+        config = dev->cache.value[MCP9808_CACHE_CONFIG];
+        newConfig = (config & ~mask) | (bits & mask);
+
+        if( (newConfig != config) || (bits & MCP9808_CONFIG_CLEAR_IRQ) )
+        {
+            /* Set first: the port may complete the transfer before returning */
+            dev->configPending = true;
+            error = MCP9808_Submit(dev, request, MCP9808_REG_CONFIG, true, newConfig, callback, context);
+            if( IS_MCP9808_ERROR(error) )
+            {
+                dev->configPending = false;
+            }
+        }
+        else
+        {
+            error = MCP9808_CompleteNow(dev, request, callback, context);
+        }
+    }
+
+    return error;
+}
+
+/**
+ * @brief     Start a temperature resolution update (single write).
+ *
+ * @param dev Device handle.
+ * @param request Request storage, zero-initialised before its first use. It must
+ *                stay valid until it is done and is refused while pending.
+ * @param resolution Temperature resolution.
+ * @param callback Completion callback (can be NULL to poll the request).
+ * @param context User context.
+ * @return MCP9808_Error_t A number lower than '0' if the request could not be submitted.
+ */
+MCP9808_Error_t MCP9808_SetResolutionAsync( MCP9808_Device_t* dev, MCP9808_Request_t* request,
+                                            MCP9808_Resolution_t resolution,
+                                            MCP9808_Callback_t callback, void* context )
+{
+    return MCP9808_Submit(dev, request, MCP9808_REG_RESOLUTION, true,
+                          resolution&MCP9808_RESOLUTION_MSK, callback, context);
+}
+
+/**
+ * @brief     Start a temperature limit update (single write).
+ *
+ * @param dev Device handle.
+ * @param request Request storage, zero-initialised before its first use. It must
+ *                stay valid until it is done and is refused while pending.
+ * @param reg Limit register (T UPPER, T LOWER or T CRIT).
+ * @param temperature Temperature to set (1/16 °C).
+ * @param callback Completion callback (can be NULL to poll the request).
+ * @param context User context.
+ * @return MCP9808_Error_t A number lower than '0' if the request could not be submitted.
+ */
+MCP9808_Error_t MCP9808_SetLimitQ4Async( MCP9808_Device_t* dev, MCP9808_Request_t* request,
+                                         MCP9808_Register_t reg, int16_t temperature,
+                                         MCP9808_Callback_t callback, void* context )
+{
+    MCP9808_Error_t error = MCP9808_ERROR;
+
+    if( (dev != NULL) &&
+        ((reg == MCP9808_REG_UPPER_TEMP) || (reg == MCP9808_REG_LOWER_TEMP) || (reg == MCP9808_REG_CRITICAL_TEMP)) &&
+        !MCP9808_IsLocked(dev, reg) )
+    {
+        error = MCP9808_Submit(dev, request, reg, true, MCP9808_Q4ToReg(temperature), callback, context);
     }
 
     return error;
 }
+#endif /* MCP9808_USE_ASYNC */
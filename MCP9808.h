@@ -37,6 +37,46 @@
     DEFINES AND TYPES
 ************************************************************************/
 
+/** Set to 0 to build the driver without any float code (Q4 API only) */
+#ifndef MCP9808_USE_FLOAT
+#define MCP9808_USE_FLOAT       1
+#endif /* MCP9808_USE_FLOAT */
+
+/** Set to 1 to build the asynchronous API (needs the async port functions) */
+#ifndef MCP9808_USE_ASYNC
+#define MCP9808_USE_ASYNC       0
+#endif /* MCP9808_USE_ASYNC */
+
+/** Set to 1 if the port provides MCP9808_PORT_ReadMulti() (one bus transfer for many devices) */
+#ifndef MCP9808_USE_MULTI
+#define MCP9808_USE_MULTI       0
+#endif /* MCP9808_USE_MULTI */
+
+/** Set to 1 to count bus transactions per register and per API (needs MCP9808_PORT_GetTimeUs()) */
+#ifndef MCP9808_USE_STATS
+#define MCP9808_USE_STATS       0
+#endif /* MCP9808_USE_STATS */
+
+/** Set to 1 to handle alerts from the ALERT pin edge (needs MCP9808_PORT_AlertAttach()) */
+#ifndef MCP9808_USE_ALERT_PIN
+#define MCP9808_USE_ALERT_PIN   0
+#endif /* MCP9808_USE_ALERT_PIN */
+
+/** Set to 1 to build the one-shot API (needs MCP9808_PORT_DelayUs() and MCP9808_PORT_GetTimeUs()) */
+#ifndef MCP9808_USE_ONESHOT
+#define MCP9808_USE_ONESHOT     0
+#endif /* MCP9808_USE_ONESHOT */
+
+/** Set to 1 to skip the pointer byte when the register pointer is already set (needs MCP9808_PORT_ReadCurrent()) */
+#ifndef MCP9808_USE_STICKY_POINTER
+#define MCP9808_USE_STICKY_POINTER  0
+#endif /* MCP9808_USE_STICKY_POINTER */
+
+/** Maximum number of devices read in a single MCP9808_PORT_ReadMulti() call */
+#ifndef MCP9808_MULTI_MAX
+#define MCP9808_MULTI_MAX       8U
+#endif /* MCP9808_MULTI_MAX */
+
 #define MCP9808_ERROR           -1
 #define MCP9808_OK               0
 
@@ -44,13 +84,174 @@
 #define MCP9808_SIGN_MASK       0x10U
 #define MCP9808_MSB             0U
 #define MCP9808_LSB             1U
+#define MCP9808_POINTER_UNKNOWN 0xFFU   /**< Register pointer not known (sticky pointer) */
+
+/** Temperature registers format */
+#define MCP9808_TA_TCRIT        0x8000U /**< TA >= TCRIT flag */
+#define MCP9808_TA_TUPPER       0x4000U /**< TA > TUPPER flag */
+#define MCP9808_TA_TLOWER       0x2000U /**< TA < TLOWER flag */
+#define MCP9808_TA_FLAGS_MSK    0xE000U /**< TA alert flags */
+#define MCP9808_TEMP_MSK        0x1FFFU /**< 13-bit two's complement temperature */
+#define MCP9808_TEMP_SIGN       0x1000U /**< Temperature sign bit */
+#define MCP9808_LIMIT_MSK       0x1FFCU /**< Limit registers temperature bits (0.25°C steps) */
+#define MCP9808_LIMIT_MAX_Q4    4092    /**< Highest limit value (+255.75°C) */
+#define MCP9808_LIMIT_MIN_Q4    -4096   /**< Lowest limit value (-256°C) */
+
+/** CONFIG MSB bits (MCP9808_Config_t only covers the LSB) */
+#define MCP9808_CONFIG_SHDN     0x0100U /**< Shutdown Mode (SHDN) */
+
+/** Identification registers */
+#define MCP9808_MANUFACTURER_ID 0x0054U /**< Manufacturer ID register value */
+#define MCP9808_DEVICE_ID       0x04U   /**< Device ID (Device ID/Revision register MSB) */
+
+/** Adaptive resolution defaults (see MCP9808_AdaptiveInit()) */
+#define MCP9808_ADAPTIVE_WINDOW_US  1000000U    /**< Rate measurement window */
+#define MCP9808_ADAPTIVE_HOLD       3U          /**< Stable windows before a finer resolution */
+
+/** One-shot energy estimate */
+#ifndef MCP9808_VDD_MV
+#define MCP9808_VDD_MV          3300U   /**< Supply voltage (mV) */
+#endif /* MCP9808_VDD_MV */
+#define MCP9808_IDD_UA          200U    /**< Operating current, typical (uA) */
+#ifndef MCP9808_ONESHOT_MARGIN_PCT
+#define MCP9808_ONESHOT_MARGIN_PCT  10U /**< Extra wait over the typical tCONV (%) */
+#endif /* MCP9808_ONESHOT_MARGIN_PCT */
 
+/** Maximum conversion time (sampler period) */
+#ifndef MCP9808_TCONV_MARGIN_PCT
+#define MCP9808_TCONV_MARGIN_PCT    10U /**< Worst case tCONV over the typical one (%) */
+#endif /* MCP9808_TCONV_MARGIN_PCT */
 
-#define IS_MCP9808_ERROR( error ) ((error) < MCP9808_ERROR)
+/** Q4 temperature: signed sixteenths of a degree (0.0625°C per LSB) */
+#define MCP9808_Q4_ONE          16
+
+
+#define IS_MCP9808_ERROR( error ) ((error) < MCP9808_OK)
 
 
 typedef int MCP9808_Error_t;
 
+/** Shadow register cache slots */
+typedef enum
+{
+    MCP9808_CACHE_CONFIG        = 0U,   /**< CONFIG register */
+    MCP9808_CACHE_UPPER_TEMP    = 1U,   /**< T UPPER register */
+    MCP9808_CACHE_LOWER_TEMP    = 2U,   /**< T LOWER register */
+    MCP9808_CACHE_CRITICAL_TEMP = 3U,   /**< T CRIT register */
+    MCP9808_CACHE_RESOLUTION    = 4U,   /**< RESOLUTION register */
+    MCP9808_CACHE_SIZE          = 5U,
+}MCP9808_Cache_Slot_t;
+
+/** Shadow copy of the non-volatile device registers */
+typedef struct
+{
+    uint16_t    value[MCP9808_CACHE_SIZE]; /**< Register values (MSB << 8 | LSB) */
+    uint8_t     valid;                     /**< Bitmap of valid slots (1 << slot) */
+}MCP9808_Cache_t;
+
+/** Staged configuration. See MCP9808_StageCommit(). */
+typedef struct
+{
+    uint16_t    value[MCP9808_CACHE_SIZE];  /**< Staged register values (same slots as the cache) */
+    uint16_t    configMask;                 /**< CONFIG bits staged in value[MCP9808_CACHE_CONFIG] */
+    uint8_t     dirty;                      /**< Bitmap of staged slots (1 << slot) */
+}MCP9808_Stage_t;
+
+#if MCP9808_USE_STATS
+/** Latency histogram buckets: [0] 0 us, [n] 2^(n-1) to 2^n - 1 us, last one open */
+#define MCP9808_STATS_BUCKETS   16U
+/** Register pointer values (0b0000 to 0b1000) */
+#define MCP9808_STATS_REGS      9U
+
+/** Public functions that can reach the bus */
+typedef enum
+{
+    MCP9808_API_OTHER                   = 0U,   /**< Outside of any driver call */
+    MCP9808_API_SYNC_CACHE,
+    MCP9808_API_READ_TEMPERATURE_RAW,
+    MCP9808_API_READ_TEMPERATURE_Q4,
+    MCP9808_API_READ_TEMPERATURE_MULTI,
+    MCP9808_API_READ_TEMPERATURE,
+    MCP9808_API_SET_CRITICAL_TEMPERATURE,
+    MCP9808_API_GET_CRITICAL_TEMPERATURE,
+    MCP9808_API_SET_WINDOW_TEMPERATURE,
+    MCP9808_API_GET_WINDOW_TEMPERATURE,
+    MCP9808_API_LOCK,                           /**< Lock/unlock functions */
+    MCP9808_API_CLEAR_INTERRUPT,
+    MCP9808_API_IS_ALERT_ASSERTED,
+    MCP9808_API_SET_ALERT,                      /**< Enable/disable, mode, polarity and output functions */
+    MCP9808_API_GET_ID,                         /**< GetID and GetManufactureID */
+    MCP9808_API_GET_HYSTERESIS,
+    MCP9808_API_SET_HYSTERESIS,
+    MCP9808_API_GET_RESOLUTION,
+    MCP9808_API_SET_RESOLUTION,
+    MCP9808_API_STAGE_COMMIT,
+    MCP9808_API_ASYNC,                          /**< Asynchronous requests */
+    MCP9808_API_SAMPLER,                        /**< MCP9808_SamplerInit/Read/NextUs() */
+    MCP9808_API_ALERT_PROCESS,                  /**< MCP9808_AlertProcess() */
+    MCP9808_API_SHUTDOWN,                       /**< MCP9808_SetShutdown() */
+    MCP9808_API_ONESHOT,                        /**< MCP9808_ReadTemperatureOneShot() */
+    MCP9808_API_COUNT,
+}MCP9808_Api_t;
+
+/** Bus transactions counters */
+typedef struct
+{
+    uint32_t    reads;                              /**< Read transactions */
+    uint32_t    writes;                             /**< Write transactions */
+    uint32_t    bytes;                              /**< Register bytes transferred (pointer included when sent) */
+    uint32_t    errors;                             /**< Failed transactions */
+    uint32_t    latency[MCP9808_STATS_BUCKETS];     /**< Transaction latency histogram (us) */
+}MCP9808_Stats_Counter_t;
+
+/** Device statistics. See MCP9808_GetStats(). */
+typedef struct
+{
+    MCP9808_Stats_Counter_t reg[MCP9808_STATS_REGS];    /**< Per register counters */
+    MCP9808_Stats_Counter_t api[MCP9808_API_COUNT];     /**< Per public function counters (float and Q4 variants merged) */
+}MCP9808_Stats_t;
+#endif /* MCP9808_USE_STATS */
+
+#if MCP9808_USE_ALERT_PIN
+/** Alert event, decoded from the TA register read after the pin edge */
+typedef struct
+{
+    uint16_t    raw;            /**< Raw TA register (MSB << 8 | LSB) */
+    int16_t     temperature;    /**< Temperature (1/16 °C) */
+    uint16_t    flags;          /**< MCP9808_TA_TCRIT, MCP9808_TA_TUPPER and MCP9808_TA_TLOWER bits */
+}MCP9808_Alert_Event_t;
+
+/** Alert handler, called from MCP9808_AlertProcess() */
+typedef void (*MCP9808_Alert_Handler_t)( void* context, const MCP9808_Alert_Event_t* event );
+#endif /* MCP9808_USE_ALERT_PIN */
+
+/** Device handle. One instance per physical sensor. */
+typedef struct
+{
+    void*           bus;            /**< Port bus context (I2C adapter, fd, ...) */
+    uint8_t         address;        /**< Device I2C address */
+    bool            isInitialized;  /**< Set to true when device initialized */
+    MCP9808_Cache_t cache;          /**< Register shadow copy */
+#if MCP9808_USE_ALERT_PIN
+    MCP9808_Alert_Handler_t alertHandler;   /**< Alert handler (NULL if not used) */
+    void*           alertContext;   /**< Alert handler context */
+    volatile bool   alertPending;   /**< Set by MCP9808_AlertNotify() */
+#endif /* MCP9808_USE_ALERT_PIN */
+#if MCP9808_USE_STICKY_POINTER
+    uint8_t         pointer;        /**< Device register pointer (MCP9808_POINTER_UNKNOWN if not known) */
+#endif /* MCP9808_USE_STICKY_POINTER */
+#if MCP9808_USE_STATS
+    uint8_t         api;            /**< Public function being run (MCP9808_Api_t) */
+    MCP9808_Stats_t stats;          /**< Bus transactions counters */
+#endif /* MCP9808_USE_STATS */
+#if MCP9808_USE_ASYNC
+    volatile bool   configPending;  /**< A CONFIG write request is in flight */
+#endif /* MCP9808_USE_ASYNC */
+#if MCP9808_USE_ONESHOT
+    uint32_t        transfers;      /**< Register transactions issued (wraps around) */
+#endif /* MCP9808_USE_ONESHOT */
+}MCP9808_Device_t;
+
 typedef enum
 {
     /* 0b0000 RESERVED */
@@ -119,6 +320,88 @@ typedef enum
     MCP9808_ALERT_OUTPUT_IRQ    = 0x01, /**< Interrupt output */
     MCP9808_ALERT_OUTPUT_MSK    = 0x01
 }MCP9808_Alert_Output_t;
+/** Result of a multi-device temperature read */
+typedef struct
+{
+    MCP9808_Error_t error;          /**< Read result of this device */
+    uint16_t        raw;            /**< Raw TA register (MSB << 8 | LSB) */
+    int16_t         temperature;    /**< Temperature (1/16 °C) */
+}MCP9808_Multi_Result_t;
+
+#if MCP9808_USE_ONESHOT
+/** One-shot conversion result and cost */
+typedef struct
+{
+    uint16_t    raw;            /**< Raw TA register (MSB << 8 | LSB) */
+    int16_t     temperature;    /**< Temperature (1/16 °C) */
+    uint32_t    awakeUs;        /**< Measured time out of shutdown, wake-up write to shutdown write (us) */
+    uint32_t    energyNj;       /**< Energy estimate: awakeUs at MCP9808_VDD_MV and typical IDD (nJ) */
+    uint8_t     transfers;      /**< Bus transactions issued (register cache fills included) */
+}MCP9808_OneShot_t;
+#endif /* MCP9808_USE_ONESHOT */
+
+/** Conversion aware TA sampler. See MCP9808_SamplerRead(). */
+typedef struct
+{
+    MCP9808_Device_t*   dev;            /**< Device handle */
+    uint32_t            timeUs;         /**< Last bus read time (us) */
+    uint16_t            raw;            /**< Last TA register read (MSB << 8 | LSB) */
+    bool                valid;          /**< Set once a sample has been read */
+}MCP9808_Sampler_t;
+
+/** Adaptive resolution controller. See MCP9808_AdaptiveRead(). */
+typedef struct
+{
+    MCP9808_Sampler_t   sampler;        /**< TA sampler (follows the resolution changes) */
+    uint32_t            windowUs;       /**< Rate measurement window (us) */
+    uint16_t            fastRate;       /**< Rate to go one resolution coarser (1/16 °C per second) */
+    uint16_t            slowRate;       /**< Rate to go one resolution finer (1/16 °C per second, < fastRate) */
+    uint8_t             coarsest;       /**< Coarsest resolution allowed (MCP9808_Resolution_t) */
+    uint8_t             finest;         /**< Finest resolution allowed (MCP9808_Resolution_t) */
+    uint8_t             hold;           /**< Slow windows in a row needed to go finer */
+    uint8_t             stable;         /**< Slow windows in a row so far */
+    bool                refValid;       /**< Set once the window has a reference sample */
+    int16_t             refTemperature; /**< Window reference temperature (1/16 °C) */
+    uint32_t            refTimeUs;      /**< Window reference time (us) */
+    uint32_t            switches;       /**< Resolution changes done */
+}MCP9808_Adaptive_t;
+
+#if MCP9808_USE_ASYNC
+/** Asynchronous request state */
+typedef enum
+{
+    MCP9808_REQUEST_IDLE        = 0,    /**< Never submitted */
+    MCP9808_REQUEST_PENDING     = 1,    /**< Transfer in progress */
+    MCP9808_REQUEST_DONE        = 2,    /**< Transfer finished, result is valid */
+}MCP9808_Request_State_t;
+
+typedef struct MCP9808_Request_s MCP9808_Request_t;
+
+/** Completion callback. It is called from the port completion context (ISR on most ports). */
+typedef void (*MCP9808_Callback_t)( MCP9808_Request_t* request );
+
+/**
+ * Asynchronous request. It must be zero-initialised (MCP9808_REQUEST_IDLE)
+ * before its first use and stay valid until it is done. A pending request
+ * cannot be submitted again.
+ */
+struct MCP9808_Request_s
+{
+    MCP9808_Device_t*               dev;            /**< Device handle */
+    MCP9808_Callback_t              callback;       /**< Completion callback (can be NULL) */
+    void*                           context;        /**< User context */
+    volatile MCP9808_Request_State_t state;         /**< Poll token */
+    MCP9808_Error_t                 result;         /**< Transfer result */
+    uint16_t                        value;          /**< Register value read or written (MSB << 8 | LSB) */
+    int16_t                         temperature;    /**< Temperature (1/16 °C) for temperature reads */
+    uint8_t                         reg;            /**< Register */
+    bool                            write;          /**< True for write requests */
+    uint8_t                         data[MCP9808_REG_SIZE]; /**< Transfer buffer */
+#if MCP9808_USE_STATS
+    uint32_t                        start;          /**< Submit time (us) */
+#endif /* MCP9808_USE_STATS */
+};
+#endif /* MCP9808_USE_ASYNC */
 
 /************************************************************************
     FUNCTIONS
@@ -129,119 +412,343 @@ typedef enum
 /**
   See "MCP98008.c" for details of how to use this function.
  */
-MCP9808_Error_t MCP9808_Init( uint8_t devAddress );
+MCP9808_Error_t MCP9808_Init( MCP9808_Device_t* dev, void* bus, uint8_t devAddress );
+
+/**
+  See "MCP98008.c" for details of how to use this function.
+ */
+MCP9808_Error_t MCP9808_setDevAddress( MCP9808_Device_t* dev, uint8_t devAddress );
+
+/**
+  See "MCP98008.c" for details of how to use this function.
+ */
+MCP9808_Error_t MCP9808_InvalidateCache( MCP9808_Device_t* dev );
+
+/**
+  See "MCP98008.c" for details of how to use this function.
+ */
+MCP9808_Error_t MCP9808_SyncCache( MCP9808_Device_t* dev );
+
+#if MCP9808_USE_STATS
+/**
+  See "MCP98008.c" for details of how to use this function.
+ */
+MCP9808_Error_t MCP9808_GetStats( const MCP9808_Device_t* dev, MCP9808_Stats_t* snapshot );
 
 /**
   See "MCP98008.c" for details of how to use this function.
  */
-MCP9808_Error_t MCP9808_setDevAddress( uint8_t devAddress );
+MCP9808_Error_t MCP9808_ResetStats( MCP9808_Device_t* dev );
+#endif /* MCP9808_USE_STATS */
 
 /** Read data functions */
 
 /**
   See "MCP98008.c" for details of how to use this function.
  */
-MCP9808_Error_t MCP9808_ReadTemperature( float* temperature );
+int16_t MCP9808_RegToQ4( uint16_t regValue );
+
+/**
+  See "MCP98008.c" for details of how to use this function.
+ */
+uint16_t MCP9808_Q4ToReg( int16_t temperature );
+
+/**
+  See "MCP98008.c" for details of how to use this function.
+ */
+MCP9808_Error_t MCP9808_ReadTemperatureRaw( MCP9808_Device_t* dev, uint16_t* raw );
+
+/**
+  See "MCP98008.c" for details of how to use this function.
+ */
+MCP9808_Error_t MCP9808_ReadTemperatureQ4( MCP9808_Device_t* dev, int16_t* temperature );
+
+/**
+  See "MCP98008.c" for details of how to use this function.
+ */
+MCP9808_Error_t MCP9808_ReadTemperatureMulti( MCP9808_Device_t* const* devices, size_t n,
+                                              MCP9808_Multi_Result_t* out );
 
 /**
   See "MCP98008.c" for details of how to use this function.
  */
-MCP9808_Error_t MCP9808_GetCriticalTemperature( float* temperature );
+uint32_t MCP9808_ConversionTimeUs( MCP9808_Resolution_t resolution );
+/**
+  See "MCP98008.c" for details of how to use this function.
+ */
+uint32_t MCP9808_ConversionTimeMaxUs( MCP9808_Resolution_t resolution );
 
 /**
   See "MCP98008.c" for details of how to use this function.
  */
-MCP9808_Error_t MCP9808_GetWindowTemperature( float* upperTemp, float* lowerTemp );
+MCP9808_Error_t MCP9808_SamplerInit( MCP9808_Sampler_t* sampler, MCP9808_Device_t* dev );
 
 /**
   See "MCP98008.c" for details of how to use this function.
  */
-MCP9808_Error_t MCP9808_GetHysteresis( MCP9808_Hysteresis_t* hysteresis );
+MCP9808_Error_t MCP9808_SamplerRead( MCP9808_Sampler_t* sampler, uint32_t nowUs, int16_t* temperature,
+                                     uint32_t* ageUs );
 
 /**
   See "MCP98008.c" for details of how to use this function.
  */
-MCP9808_Error_t MCP9808_GetResolution( MCP9808_Resolution_t* resolution );
+MCP9808_Error_t MCP9808_SamplerNextUs( MCP9808_Sampler_t* sampler, uint32_t nowUs, uint32_t* waitUs );
 
 /**
   See "MCP98008.c" for details of how to use this function.
  */
-MCP9808_Error_t MCP9808_GetID( uint8_t* id, uint8_t* revision );
+MCP9808_Error_t MCP9808_AdaptiveInit( MCP9808_Adaptive_t* adaptive, MCP9808_Device_t* dev,
+                                      uint16_t fastRate, uint16_t slowRate );
 
 /**
   See "MCP98008.c" for details of how to use this function.
  */
-MCP9808_Error_t MCP9808_GetManufactureID( uint16_t*id );
+MCP9808_Error_t MCP9808_AdaptiveRead( MCP9808_Adaptive_t* adaptive, uint32_t nowUs, int16_t* temperature,
+                                      uint32_t* ageUs );
+
+/**
+  See "MCP98008.c" for details of how to use this function.
+ */
+MCP9808_Error_t MCP9808_GetCriticalTemperatureQ4( MCP9808_Device_t* dev, int16_t* temperature );
+
+/**
+  See "MCP98008.c" for details of how to use this function.
+ */
+MCP9808_Error_t MCP9808_GetWindowTemperatureQ4( MCP9808_Device_t* dev, int16_t* upperTemp, int16_t* lowerTemp );
+
+#if MCP9808_USE_FLOAT
+/**
+  See "MCP98008.c" for details of how to use this function.
+ */
+MCP9808_Error_t MCP9808_ReadTemperature( MCP9808_Device_t* dev, float* temperature );
+
+/**
+  See "MCP98008.c" for details of how to use this function.
+ */
+MCP9808_Error_t MCP9808_GetCriticalTemperature( MCP9808_Device_t* dev, float* temperature );
+
+/**
+  See "MCP98008.c" for details of how to use this function.
+ */
+MCP9808_Error_t MCP9808_GetWindowTemperature( MCP9808_Device_t* dev, float* upperTemp, float* lowerTemp );
+#endif /* MCP9808_USE_FLOAT */
+
+/**
+  See "MCP98008.c" for details of how to use this function.
+ */
+MCP9808_Error_t MCP9808_GetHysteresis( MCP9808_Device_t* dev, MCP9808_Hysteresis_t* hysteresis );
+
+/**
+  See "MCP98008.c" for details of how to use this function.
+ */
+MCP9808_Error_t MCP9808_GetResolution( MCP9808_Device_t* dev, MCP9808_Resolution_t* resolution );
+
+/**
+  See "MCP98008.c" for details of how to use this function.
+ */
+MCP9808_Error_t MCP9808_GetID( MCP9808_Device_t* dev, uint8_t* id, uint8_t* revision );
+
+/**
+  See "MCP98008.c" for details of how to use this function.
+ */
+MCP9808_Error_t MCP9808_GetManufactureID( MCP9808_Device_t* dev, uint16_t*id );
 
 /** Device configuration functions */
 
 /**
   See "MCP98008.c" for details of how to use this function.
  */
-MCP9808_Error_t MCP9808_SetCriticalTemperature( float temperature );
+MCP9808_Error_t MCP9808_SetCriticalTemperatureQ4( MCP9808_Device_t* dev, int16_t temperature );
+/**
+  See "MCP98008.c" for details of how to use this function.
+ */
+MCP9808_Error_t MCP9808_SetWindowTemperatureQ4( MCP9808_Device_t* dev, int16_t upperTemp, int16_t lowerTemp );
+
+#if MCP9808_USE_FLOAT
+/**
+  See "MCP98008.c" for details of how to use this function.
+ */
+MCP9808_Error_t MCP9808_SetCriticalTemperature( MCP9808_Device_t* dev, float temperature );
+/**
+  See "MCP98008.c" for details of how to use this function.
+ */
+MCP9808_Error_t MCP9808_SetWindowTemperature( MCP9808_Device_t* dev, float upperTemp, float lowerTemp );
+#endif /* MCP9808_USE_FLOAT */
+/**
+  See "MCP98008.c" for details of how to use this function.
+ */
+MCP9808_Error_t MCP9808_SetHysteresis( MCP9808_Device_t* dev, MCP9808_Hysteresis_t hysteresis );
 /**
   See "MCP98008.c" for details of how to use this function.
  */
-MCP9808_Error_t MCP9808_SetWindowTemperature( float upperTemp, float lowerTemp );
+MCP9808_Error_t MCP9808_SetResolution( MCP9808_Device_t* dev, MCP9808_Resolution_t resolution );
 /**
   See "MCP98008.c" for details of how to use this function.
  */
-MCP9808_Error_t MCP9808_SetHysteresis( MCP9808_Hysteresis_t hysteresis );
+MCP9808_Error_t MCP9808_SetShutdown( MCP9808_Device_t* dev, bool shutdown );
+#if MCP9808_USE_ONESHOT
 /**
   See "MCP98008.c" for details of how to use this function.
  */
-MCP9808_Error_t MCP9808_SetResolution( MCP9808_Resolution_t resolution );
+MCP9808_Error_t MCP9808_ReadTemperatureOneShot( MCP9808_Device_t* dev, MCP9808_Resolution_t resolution,
+                                                MCP9808_OneShot_t* result );
+#endif /* MCP9808_USE_ONESHOT */
 
 /** Device alert functions */
 
 /**
   See "MCP98008.c" for details of how to use this function.
  */
-bool MCP9808_IsAlertAsserted( void );
+bool MCP9808_IsAlertAsserted( MCP9808_Device_t* dev );
 
 /**
   See "MCP98008.c" for details of how to use this function.
  */
-MCP9808_Error_t MCP9808_EnableAlert( void );
+MCP9808_Error_t MCP9808_EnableAlert( MCP9808_Device_t* dev );
 /**
   See "MCP98008.c" for details of how to use this function.
  */
-MCP9808_Error_t MCP9808_DisableAlert( void );
+MCP9808_Error_t MCP9808_DisableAlert( MCP9808_Device_t* dev );
 /**
   See "MCP98008.c" for details of how to use this function.
  */
-MCP9808_Error_t MCP9808_SetAlertMode( MCP9808_Alert_Mode_t mode );
+MCP9808_Error_t MCP9808_SetAlertMode( MCP9808_Device_t* dev, MCP9808_Alert_Mode_t mode );
 /**
   See "MCP98008.c" for details of how to use this function.
  */
-MCP9808_Error_t MCP9808_SetAlertPolarity( MCP9808_Alert_Polarity_t polarity );
+MCP9808_Error_t MCP9808_SetAlertPolarity( MCP9808_Device_t* dev, MCP9808_Alert_Polarity_t polarity );
 /**
   See "MCP98008.c" for details of how to use this function.
  */
-MCP9808_Error_t MCP9808_SetAlertOutput( MCP9808_Alert_Output_t output );
+MCP9808_Error_t MCP9808_SetAlertOutput( MCP9808_Device_t* dev, MCP9808_Alert_Output_t output );
 
 /** Other configuration functions */
 
 /**
   See "MCP98008.c" for details of how to use this function.
  */
-MCP9808_Error_t MCP9808_LockWindowTempReg( void );
+MCP9808_Error_t MCP9808_LockWindowTempReg( MCP9808_Device_t* dev );
+/**
+  See "MCP98008.c" for details of how to use this function.
+ */
+MCP9808_Error_t MCP9808_UnlockWindowTempReg( MCP9808_Device_t* dev );
+/**
+  See "MCP98008.c" for details of how to use this function.
+ */
+MCP9808_Error_t MCP9808_LockCriticalTempReg( MCP9808_Device_t* dev );
+/**
+  See "MCP98008.c" for details of how to use this function.
+ */
+MCP9808_Error_t MCP9808_UnlockCriticalTempReg( MCP9808_Device_t* dev );
+/**
+  See "MCP98008.c" for details of how to use this function.
+ */
+MCP9808_Error_t MCP9808_ClearInterrupt( MCP9808_Device_t* dev );
+
+#if MCP9808_USE_ALERT_PIN
+/** Event driven alert functions */
+
+/**
+  See "MCP98008.c" for details of how to use this function.
+ */
+MCP9808_Error_t MCP9808_SetAlertHandler( MCP9808_Device_t* dev, MCP9808_Alert_Handler_t handler, void* context );
+/**
+  See "MCP98008.c" for details of how to use this function.
+ */
+void MCP9808_AlertNotify( MCP9808_Device_t* dev );
+/**
+  See "MCP98008.c" for details of how to use this function.
+ */
+MCP9808_Error_t MCP9808_AlertProcess( MCP9808_Device_t* dev );
+#endif /* MCP9808_USE_ALERT_PIN */
+
+/** Staged configuration functions */
+
+/**
+  See "MCP98008.c" for details of how to use this function.
+ */
+MCP9808_Error_t MCP9808_StageInit( MCP9808_Stage_t* stage );
+/**
+  See "MCP98008.c" for details of how to use this function.
+ */
+MCP9808_Error_t MCP9808_StageAlert( MCP9808_Stage_t* stage, bool enable );
+/**
+  See "MCP98008.c" for details of how to use this function.
+ */
+MCP9808_Error_t MCP9808_StageAlertMode( MCP9808_Stage_t* stage, MCP9808_Alert_Mode_t mode );
+/**
+  See "MCP98008.c" for details of how to use this function.
+ */
+MCP9808_Error_t MCP9808_StageAlertPolarity( MCP9808_Stage_t* stage, MCP9808_Alert_Polarity_t polarity );
+/**
+  See "MCP98008.c" for details of how to use this function.
+ */
+MCP9808_Error_t MCP9808_StageAlertOutput( MCP9808_Stage_t* stage, MCP9808_Alert_Output_t output );
+/**
+  See "MCP98008.c" for details of how to use this function.
+ */
+MCP9808_Error_t MCP9808_StageHysteresis( MCP9808_Stage_t* stage, MCP9808_Hysteresis_t hysteresis );
+/**
+  See "MCP98008.c" for details of how to use this function.
+ */
+MCP9808_Error_t MCP9808_StageResolution( MCP9808_Stage_t* stage, MCP9808_Resolution_t resolution );
+#if MCP9808_USE_FLOAT
+/**
+  See "MCP98008.c" for details of how to use this function.
+ */
+MCP9808_Error_t MCP9808_StageCriticalTemperature( MCP9808_Stage_t* stage, float temperature );
+/**
+  See "MCP98008.c" for details of how to use this function.
+ */
+MCP9808_Error_t MCP9808_StageWindowTemperature( MCP9808_Stage_t* stage, float upperTemp, float lowerTemp );
+#endif /* MCP9808_USE_FLOAT */
+/**
+  See "MCP98008.c" for details of how to use this function.
+ */
+MCP9808_Error_t MCP9808_StageCriticalTemperatureQ4( MCP9808_Stage_t* stage, int16_t temperature );
+/**
+  See "MCP98008.c" for details of how to use this function.
+ */
+MCP9808_Error_t MCP9808_StageWindowTemperatureQ4( MCP9808_Stage_t* stage, int16_t upperTemp, int16_t lowerTemp );
+/**
+  See "MCP98008.c" for details of how to use this function.
+ */
+MCP9808_Error_t MCP9808_StageLock( MCP9808_Stage_t* stage, bool window, bool critical );
+/**
+  See "MCP98008.c" for details of how to use this function.
+ */
+MCP9808_Error_t MCP9808_StageCommit( MCP9808_Device_t* dev, const MCP9808_Stage_t* stage );
+
+#if MCP9808_USE_ASYNC
+/** Asynchronous functions */
+
+/**
+  See "MCP98008.c" for details of how to use this function.
+ */
+bool MCP9808_IsRequestDone( const MCP9808_Request_t* request );
 /**
   See "MCP98008.c" for details of how to use this function.
  */
-MCP9808_Error_t MCP9808_UnlockWindowTempReg( void );
+MCP9808_Error_t MCP9808_ReadTemperatureAsync( MCP9808_Device_t* dev, MCP9808_Request_t* request,
+                                              MCP9808_Callback_t callback, void* context );
 /**
   See "MCP98008.c" for details of how to use this function.
  */
-MCP9808_Error_t MCP9808_LockCriticalTempReg( void );
+MCP9808_Error_t MCP9808_UpdateConfigAsync( MCP9808_Device_t* dev, MCP9808_Request_t* request, uint16_t mask,
+                                           uint16_t bits, MCP9808_Callback_t callback, void* context );
 /**
   See "MCP98008.c" for details of how to use this function.
  */
-MCP9808_Error_t MCP9808_UnlockCriticalTempReg( void );
+MCP9808_Error_t MCP9808_SetResolutionAsync( MCP9808_Device_t* dev, MCP9808_Request_t* request,
+                                            MCP9808_Resolution_t resolution,
+                                            MCP9808_Callback_t callback, void* context );
 /**
   See "MCP98008.c" for details of how to use this function.
  */
-MCP9808_Error_t MCP9808_ClearInterrupt( void );
+MCP9808_Error_t MCP9808_SetLimitQ4Async( MCP9808_Device_t* dev, MCP9808_Request_t* request,
+                                         MCP9808_Register_t reg, int16_t temperature,
+                                         MCP9808_Callback_t callback, void* context );
+#endif /* MCP9808_USE_ASYNC */
 
 
 #endif /* DRIVERS_INC_MCP9808_H_ */
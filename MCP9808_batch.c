@@ -0,0 +1,441 @@
+/**                             _____________
+ *              /\      /\     /             \
+ *             //\\____//\\   |   MAUUUU!!    |
+ *            /     '      \   \  ___________/
+ *           /   /\ '  /\    \ /_/                  / /  ___    / __\ |__   __ _| |_
+ *          |    == o ==      |       /|         / /  / _ \  / /  | '_ \ / _` | __|
+ *           \      '        /       | |        / /__|  __/ / /___| | | | (_| | |_
+ *             \           /         \ \        \____/\___| \____/|_| |_|\__,_|\__|
+ *             /----<o>---- \         / /
+ *             |            ' \       \ \
+ *             |    |    | '   '\      \ \
+ *  _________  | ´´ |  ' |     '  \    / /
+ *  |  MAYA  | |  ' |    | '       |__/ /
+ *   \______/   \__/ \__/ \_______/____/
+ * 
+ * @file MCP9808_batch.c
+ * @author Alejandro Gomez Molina (@Alejo2312)
+ * @brief Bulk decoder for raw temperature register frames. Each frame is
+ *        the 2-byte TA register as read from the bus (MSB first).
+ *        SIMD kernels are selected at build time (-msse2, -mavx2, NEON).
+ * @version 0.1
+ * @date Mar 22, 2022
+ * 
+ * @copyright Copyright (c) 2022
+ * 
+ */
+
+/************************************************************************
+    INCLUDES
+************************************************************************/
+#include "MCP9808_batch.h"
+
+#if defined(__SSE2__) || defined(__AVX2__)
+#include <immintrin.h>
+#endif
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define MCP9808_HAS_NEON        1
+#endif
+
+/************************************************************************
+     DEFINES AND TYPES
+************************************************************************/
+#define MCP9808_Q4_SCALE        0.0625f     /**< °C per Q4 LSB */
+
+/************************************************************************
+    FUNCTIONS
+************************************************************************/
+
+/**
+ * @brief Decode one frame.
+ *
+ * @param frame Frame pointer (uint8_t[2]).
+ * @param flags Alert flags storage (can be NULL).
+ * @return int16_t Temperature (1/16 °C).
+ */
+static inline int16_t MCP9808_DecodeFrame( const uint8_t* frame, uint8_t* flags )
+{
+    uint16_t raw = ((uint16_t)frame[MCP9808_MSB] << 8) | frame[MCP9808_LSB];
+
+    if( flags != NULL )
+    {
+        *flags = raw >> 13;
+    }
+    return MCP9808_RegToQ4(raw);
+}
+
+/**
+ * @brief Scalar Q4 kernel.
+ */
+static void MCP9808_DecodeQ4Scalar( const uint8_t* frames, size_t n, int16_t* out, uint8_t* flags )
+{
+    size_t i = 0;
+
+    for( i = 0; i < n; i++ )
+    {
+        out[i] = MCP9808_DecodeFrame(&frames[i * MCP9808_REG_SIZE], (flags != NULL) ? &flags[i] : NULL);
+    }
+}
+
+#if defined(__SSE2__)
+/**
+ * @brief SSE2 kernel: byte swap, shift the 13-bit field to the top of the
+ *        lane and arithmetic shift it back to sign extend it.
+ *
+ * @return __m128i 8 decoded Q4 values.
+ */
+static inline __m128i MCP9808_DecodeSSE2( const uint8_t* frames, uint8_t* flags )
+{
+    __m128i raw = _mm_loadu_si128((const __m128i*)frames);
+
+    raw = _mm_or_si128(_mm_slli_epi16(raw, 8), _mm_srli_epi16(raw, 8));
+    if( flags != NULL )
+    {
+        __m128i f = _mm_srli_epi16(raw, 13);
+        _mm_storel_epi64((__m128i*)flags, _mm_packus_epi16(f, f));
+    }
+
+    return _mm_srai_epi16(_mm_slli_epi16(raw, 3), 3);
+}
+
+/**
+ * @brief SSE2 Q4 kernel.
+ */
+static void MCP9808_DecodeQ4SSE2( const uint8_t* frames, size_t n, int16_t* out, uint8_t* flags )
+{
+    size_t i = 0;
+
+    for( i = 0; (i + 8U) <= n; i += 8U )
+    {
+        _mm_storeu_si128((__m128i*)&out[i],
+                         MCP9808_DecodeSSE2(&frames[i * MCP9808_REG_SIZE], (flags != NULL) ? &flags[i] : NULL));
+    }
+    MCP9808_DecodeQ4Scalar(&frames[i * MCP9808_REG_SIZE], n - i, &out[i], (flags != NULL) ? &flags[i] : NULL);
+}
+#endif /* __SSE2__ */
+
+#if defined(__AVX2__)
+/**
+ * @brief AVX2 kernel. Same as the SSE2 one, with 16 frames per step.
+ *
+ * @return __m256i 16 decoded Q4 values.
+ */
+static inline __m256i MCP9808_DecodeAVX2( const uint8_t* frames, uint8_t* flags )
+{
+    __m256i raw = _mm256_loadu_si256((const __m256i*)frames);
+
+    raw = _mm256_or_si256(_mm256_slli_epi16(raw, 8), _mm256_srli_epi16(raw, 8));
+    if( flags != NULL )
+    {
+        __m256i f = _mm256_srli_epi16(raw, 13);
+        _mm_storeu_si128((__m128i*)flags, _mm_packus_epi16(_mm256_castsi256_si128(f),
+                                                           _mm256_extracti128_si256(f, 1)));
+    }
+
+    return _mm256_srai_epi16(_mm256_slli_epi16(raw, 3), 3);
+}
+
+/**
+ * @brief AVX2 Q4 kernel.
+ */
+static void MCP9808_DecodeQ4AVX2( const uint8_t* frames, size_t n, int16_t* out, uint8_t* flags )
+{
+    size_t i = 0;
+
+    for( i = 0; (i + 16U) <= n; i += 16U )
+    {
+        _mm256_storeu_si256((__m256i*)&out[i],
+                            MCP9808_DecodeAVX2(&frames[i * MCP9808_REG_SIZE], (flags != NULL) ? &flags[i] : NULL));
+    }
+    MCP9808_DecodeQ4Scalar(&frames[i * MCP9808_REG_SIZE], n - i, &out[i], (flags != NULL) ? &flags[i] : NULL);
+}
+#endif /* __AVX2__ */
+
+#if defined(MCP9808_HAS_NEON)
+/**
+ * @brief NEON kernel: byte swap with vrev16 and sign extend with a shift pair.
+ *
+ * @return int16x8_t 8 decoded Q4 values.
+ */
+static inline int16x8_t MCP9808_DecodeNEON( const uint8_t* frames, uint8_t* flags )
+{
+    uint16x8_t raw = vreinterpretq_u16_u8(vrev16q_u8(vld1q_u8(frames)));
+
+    if( flags != NULL )
+    {
+        vst1_u8(flags, vmovn_u16(vshrq_n_u16(raw, 13)));
+    }
+
+    return vshrq_n_s16(vshlq_n_s16(vreinterpretq_s16_u16(raw), 3), 3);
+}
+
+/**
+ * @brief NEON Q4 kernel.
+ */
+static void MCP9808_DecodeQ4NEON( const uint8_t* frames, size_t n, int16_t* out, uint8_t* flags )
+{
+    size_t i = 0;
+
+    for( i = 0; (i + 8U) <= n; i += 8U )
+    {
+        vst1q_s16(&out[i], MCP9808_DecodeNEON(&frames[i * MCP9808_REG_SIZE], (flags != NULL) ? &flags[i] : NULL));
+    }
+    MCP9808_DecodeQ4Scalar(&frames[i * MCP9808_REG_SIZE], n - i, &out[i], (flags != NULL) ? &flags[i] : NULL);
+}
+#endif /* MCP9808_HAS_NEON */
+
+/**
+ * @brief Check if a decoder kernel has been built in.
+ *
+ * @param kernel Decoder kernel.
+ * @return true if the kernel can be used.
+ */
+bool MCP9808_IsKernelAvailable( MCP9808_Kernel_t kernel )
+{
+    bool result = false;
+
+    switch( kernel )
+    {
+        case MCP9808_KERNEL_AUTO:
+        case MCP9808_KERNEL_SCALAR:
+            result = true;
+            break;
+#if defined(__SSE2__)
+        case MCP9808_KERNEL_SSE2:
+            result = true;
+            break;
+#endif
+#if defined(__AVX2__)
+        case MCP9808_KERNEL_AVX2:
+            result = true;
+            break;
+#endif
+#if defined(MCP9808_HAS_NEON)
+        case MCP9808_KERNEL_NEON:
+            result = true;
+            break;
+#endif
+        default:
+            break;
+    }
+
+    return result;
+}
+
+/**
+ * @brief Decode raw TA frames to sixteenths of a degree with a given kernel.
+ *
+ * @param kernel Decoder kernel.
+ * @param frames Raw frames, 2 bytes each (MSB first), as read from the bus.
+ * @param n Number of frames.
+ * @param out Temperature storage (1/16 °C), n entries.
+ * @param flags Alert flags storage (MCP9808_FLAG_*), n entries. Can be NULL.
+ * @return MCP9808_Error_t A number lower than '0' if something was wrong.
+ */
+MCP9808_Error_t MCP9808_DecodeBatchQ4Kernel( MCP9808_Kernel_t kernel, const uint8_t* frames, size_t n,
+                                             int16_t* out, uint8_t* flags )
+{
+    MCP9808_Error_t error = MCP9808_ERROR;
+
+    if( (frames != NULL) && (out != NULL) && MCP9808_IsKernelAvailable(kernel) )
+    {
+        error = MCP9808_OK;
+
+        switch( kernel )
+        {
+#if defined(__SSE2__)
+            case MCP9808_KERNEL_SSE2:
+                MCP9808_DecodeQ4SSE2(frames, n, out, flags);
+                break;
+#endif
+#if defined(__AVX2__)
+            case MCP9808_KERNEL_AVX2:
+                MCP9808_DecodeQ4AVX2(frames, n, out, flags);
+                break;
+#endif
+#if defined(MCP9808_HAS_NEON)
+            case MCP9808_KERNEL_NEON:
+                MCP9808_DecodeQ4NEON(frames, n, out, flags);
+                break;
+#endif
+            case MCP9808_KERNEL_AUTO:
+#if defined(__AVX2__)
+                MCP9808_DecodeQ4AVX2(frames, n, out, flags);
+#elif defined(__SSE2__)
+                MCP9808_DecodeQ4SSE2(frames, n, out, flags);
+#elif defined(MCP9808_HAS_NEON)
+                MCP9808_DecodeQ4NEON(frames, n, out, flags);
+#else
+                MCP9808_DecodeQ4Scalar(frames, n, out, flags);
+#endif
+                break;
+            default:
+                MCP9808_DecodeQ4Scalar(frames, n, out, flags);
+                break;
+        }
+    }
+
+    return error;
+}
+
+/**
+ * @brief Decode raw TA frames to sixteenths of a degree with the best kernel.
+ *
+ * @param frames Raw frames, 2 bytes each (MSB first), as read from the bus.
+ * @param n Number of frames.
+ * @param out Temperature storage (1/16 °C), n entries.
+ * @param flags Alert flags storage (MCP9808_FLAG_*), n entries. Can be NULL.
+ * @return MCP9808_Error_t A number lower than '0' if something was wrong.
+ */
+MCP9808_Error_t MCP9808_DecodeBatchQ4( const uint8_t* frames, size_t n, int16_t* out, uint8_t* flags )
+{
+    return MCP9808_DecodeBatchQ4Kernel(MCP9808_KERNEL_AUTO, frames, n, out, flags);
+}
+
+#if MCP9808_USE_FLOAT
+/**
+ * @brief Scalar float kernel.
+ */
+static void MCP9808_DecodeFloatScalar( const uint8_t* frames, size_t n, float* out, uint8_t* flags )
+{
+    size_t i = 0;
+
+    for( i = 0; i < n; i++ )
+    {
+        out[i] = MCP9808_DecodeFrame(&frames[i * MCP9808_REG_SIZE], (flags != NULL) ? &flags[i] : NULL) *
+                 MCP9808_Q4_SCALE;
+    }
+}
+
+#if defined(__SSE2__)
+/**
+ * @brief SSE2 float kernel.
+ */
+static void MCP9808_DecodeFloatSSE2( const uint8_t* frames, size_t n, float* out, uint8_t* flags )
+{
+    const __m128 scale = _mm_set1_ps(MCP9808_Q4_SCALE);
+    __m128i q4;
+    size_t i = 0;
+
+    for( i = 0; (i + 8U) <= n; i += 8U )
+    {
+        q4 = MCP9808_DecodeSSE2(&frames[i * MCP9808_REG_SIZE], (flags != NULL) ? &flags[i] : NULL);
+        _mm_storeu_ps(&out[i], _mm_mul_ps(_mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpacklo_epi16(q4, q4), 16)), scale));
+        _mm_storeu_ps(&out[i + 4U], _mm_mul_ps(_mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpackhi_epi16(q4, q4), 16)), scale));
+    }
+    MCP9808_DecodeFloatScalar(&frames[i * MCP9808_REG_SIZE], n - i, &out[i], (flags != NULL) ? &flags[i] : NULL);
+}
+#endif /* __SSE2__ */
+
+#if defined(__AVX2__)
+/**
+ * @brief AVX2 float kernel.
+ */
+static void MCP9808_DecodeFloatAVX2( const uint8_t* frames, size_t n, float* out, uint8_t* flags )
+{
+    const __m256 scale = _mm256_set1_ps(MCP9808_Q4_SCALE);
+    __m256i q4;
+    size_t i = 0;
+
+    for( i = 0; (i + 16U) <= n; i += 16U )
+    {
+        q4 = MCP9808_DecodeAVX2(&frames[i * MCP9808_REG_SIZE], (flags != NULL) ? &flags[i] : NULL);
+        _mm256_storeu_ps(&out[i], _mm256_mul_ps(_mm256_cvtepi32_ps(
+                         _mm256_cvtepi16_epi32(_mm256_castsi256_si128(q4))), scale));
+        _mm256_storeu_ps(&out[i + 8U], _mm256_mul_ps(_mm256_cvtepi32_ps(
+                         _mm256_cvtepi16_epi32(_mm256_extracti128_si256(q4, 1))), scale));
+    }
+    MCP9808_DecodeFloatScalar(&frames[i * MCP9808_REG_SIZE], n - i, &out[i], (flags != NULL) ? &flags[i] : NULL);
+}
+#endif /* __AVX2__ */
+
+#if defined(MCP9808_HAS_NEON)
+/**
+ * @brief NEON float kernel.
+ */
+static void MCP9808_DecodeFloatNEON( const uint8_t* frames, size_t n, float* out, uint8_t* flags )
+{
+    int16x8_t q4;
+    size_t i = 0;
+
+    for( i = 0; (i + 8U) <= n; i += 8U )
+    {
+        q4 = MCP9808_DecodeNEON(&frames[i * MCP9808_REG_SIZE], (flags != NULL) ? &flags[i] : NULL);
+        vst1q_f32(&out[i], vmulq_n_f32(vcvtq_f32_s32(vmovl_s16(vget_low_s16(q4))), MCP9808_Q4_SCALE));
+        vst1q_f32(&out[i + 4U], vmulq_n_f32(vcvtq_f32_s32(vmovl_s16(vget_high_s16(q4))), MCP9808_Q4_SCALE));
+    }
+    MCP9808_DecodeFloatScalar(&frames[i * MCP9808_REG_SIZE], n - i, &out[i], (flags != NULL) ? &flags[i] : NULL);
+}
+#endif /* MCP9808_HAS_NEON */
+
+/**
+ * @brief Decode raw TA frames to degrees with a given kernel.
+ *
+ * @param kernel Decoder kernel.
+ * @param frames Raw frames, 2 bytes each (MSB first), as read from the bus.
+ * @param n Number of frames.
+ * @param out Temperature storage (°C), n entries.
+ * @param flags Alert flags storage (MCP9808_FLAG_*), n entries. Can be NULL.
+ * @return MCP9808_Error_t A number lower than '0' if something was wrong.
+ */
+MCP9808_Error_t MCP9808_DecodeBatchKernel( MCP9808_Kernel_t kernel, const uint8_t* frames, size_t n,
+                                           float* out, uint8_t* flags )
+{
+    MCP9808_Error_t error = MCP9808_ERROR;
+
+    if( (frames != NULL) && (out != NULL) && MCP9808_IsKernelAvailable(kernel) )
+    {
+        error = MCP9808_OK;
+
+        switch( kernel )
+        {
+#if defined(__SSE2__)
+            case MCP9808_KERNEL_SSE2:
+                MCP9808_DecodeFloatSSE2(frames, n, out, flags);
+                break;
+#endif
+#if defined(__AVX2__)
+            case MCP9808_KERNEL_AVX2:
+                MCP9808_DecodeFloatAVX2(frames, n, out, flags);
+                break;
+#endif
+#if defined(MCP9808_HAS_NEON)
+            case MCP9808_KERNEL_NEON:
+                MCP9808_DecodeFloatNEON(frames, n, out, flags);
+                break;
+#endif
+            case MCP9808_KERNEL_AUTO:
+#if defined(__AVX2__)
+                MCP9808_DecodeFloatAVX2(frames, n, out, flags);
+#elif defined(__SSE2__)
+                MCP9808_DecodeFloatSSE2(frames, n, out, flags);
+#elif defined(MCP9808_HAS_NEON)
+                MCP9808_DecodeFloatNEON(frames, n, out, flags);
+#else
+                MCP9808_DecodeFloatScalar(frames, n, out, flags);
+#endif
+                break;
+            default:
+                MCP9808_DecodeFloatScalar(frames, n, out, flags);
+                break;
+        }
+    }
+
+    return error;
+}
+
+/**
+ * @brief Decode raw TA frames to degrees with the best kernel.
+ *
+ * @param frames Raw frames, 2 bytes each (MSB first), as read from the bus.
+ * @param n Number of frames.
+ * @param out Temperature storage (°C), n entries.
+ * @param flags Alert flags storage (MCP9808_FLAG_*), n entries. Can be NULL.
+ * @return MCP9808_Error_t A number lower than '0' if something was wrong.
+ */
+MCP9808_Error_t MCP9808_DecodeBatch( const uint8_t* frames, size_t n, float* out, uint8_t* flags )
+{
+    return MCP9808_DecodeBatchKernel(MCP9808_KERNEL_AUTO, frames, n, out, flags);
+}
+#endif /* MCP9808_USE_FLOAT */
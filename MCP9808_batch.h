@@ -0,0 +1,87 @@
+/**                             _____________
+ *              /\      /\     /             \
+ *             //\\____//\\   |   MAUUUU!!    |
+ *            /     '      \   \  ___________/
+ *           /   /\ '  /\    \ /_/                  / /  ___    / __\ |__   __ _| |_
+ *          |    == o ==      |       /|         / /  / _ \  / /  | '_ \ / _` | __|
+ *           \      '        /       | |        / /__|  __/ / /___| | | | (_| | |_
+ *             \           /         \ \        \____/\___| \____/|_| |_|\__,_|\__|
+ *             /----<o>---- \         / /
+ *             |            ' \       \ \
+ *             |    |    | '   '\      \ \
+ *  _________  | ´´ |  ' |     '  \    / /
+ *  |  MAYA  | |  ' |    | '       |__/ /
+ *   \______/   \__/ \__/ \_______/____/
+ * 
+ * @file MCP9808_batch.h
+ * @author Alejandro Gomez Molina (@Alejo2312)
+ * @brief Bulk decoder for raw temperature register frames.
+ * @version 0.1
+ * @date Mar 22, 2022
+ * 
+ * @copyright Copyright (c) 2022
+ * 
+ */
+#ifndef DRIVERS_INC_MCP9808_BATCH_H_
+#define DRIVERS_INC_MCP9808_BATCH_H_
+
+
+/************************************************************************
+    INCLUDES
+************************************************************************/
+#include "MCP9808.h"
+
+/************************************************************************
+    DEFINES AND TYPES
+************************************************************************/
+
+/** Alert flags reported by the batch decoder (TA bits 15 to 13) */
+#define MCP9808_FLAG_TLOWER     0x01U   /**< TA < TLOWER */
+#define MCP9808_FLAG_TUPPER     0x02U   /**< TA > TUPPER */
+#define MCP9808_FLAG_TCRIT      0x04U   /**< TA >= TCRIT */
+
+/** Decoder kernels */
+typedef enum
+{
+    MCP9808_KERNEL_AUTO     = 0,    /**< Best kernel available in this build */
+    MCP9808_KERNEL_SCALAR   = 1,    /**< Portable C */
+    MCP9808_KERNEL_SSE2     = 2,    /**< x86 SSE2, 8 frames per step */
+    MCP9808_KERNEL_AVX2     = 3,    /**< x86 AVX2, 16 frames per step */
+    MCP9808_KERNEL_NEON     = 4,    /**< ARM NEON, 8 frames per step */
+}MCP9808_Kernel_t;
+
+/************************************************************************
+    FUNCTIONS
+************************************************************************/
+
+/**
+  See "MCP9808_batch.c" for details of how to use this function.
+ */
+bool MCP9808_IsKernelAvailable( MCP9808_Kernel_t kernel );
+
+/**
+  See "MCP9808_batch.c" for details of how to use this function.
+ */
+MCP9808_Error_t MCP9808_DecodeBatchQ4( const uint8_t* frames, size_t n, int16_t* out, uint8_t* flags );
+
+/**
+  See "MCP9808_batch.c" for details of how to use this function.
+ */
+MCP9808_Error_t MCP9808_DecodeBatchQ4Kernel( MCP9808_Kernel_t kernel, const uint8_t* frames, size_t n,
+                                             int16_t* out, uint8_t* flags );
+
+#if MCP9808_USE_FLOAT
+/**
+  See "MCP9808_batch.c" for details of how to use this function.
+ */
+MCP9808_Error_t MCP9808_DecodeBatch( const uint8_t* frames, size_t n, float* out, uint8_t* flags );
+
+/**
+  See "MCP9808_batch.c" for details of how to use this function.
+ */
+MCP9808_Error_t MCP9808_DecodeBatchKernel( MCP9808_Kernel_t kernel, const uint8_t* frames, size_t n,
+                                           float* out, uint8_t* flags );
+#endif /* MCP9808_USE_FLOAT */
+
+
+#endif /* DRIVERS_INC_MCP9808_BATCH_H_ */
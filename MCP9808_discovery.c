@@ -0,0 +1,189 @@
+/**                             _____________
+ *              /\      /\     /             \
+ *             //\\____//\\   |   MAUUUU!!    |
+ *            /     '      \   \  ___________/
+ *           /   /\ '  /\    \ /_/                  / /  ___    / __\ |__   __ _| |_
+ *          |    == o ==      |       /|         / /  / _ \  / /  | '_ \ / _` | __|
+ *           \      '        /       | |        / /__|  __/ / /___| | | | (_| | |_
+ *             \           /         \ \        \____/\___| \____/|_| |_|\__,_|\__|
+ *             /----<o>---- \         / /
+ *             |            ' \       \ \
+ *             |    |    | '   '\      \ \
+ *  _________  | ´´ |  ' |     '  \    / /
+ *  |  MAYA  | |  ' |    | '       |__/ /
+ *   \______/   \__/ \__/ \_______/____/
+ * @file MCP9808_discovery.c
+ * @author Alejandro Gomez Molina (@Alejo2312)
+ * @brief Bus discovery: probe every MCP9808 address of several buses.
+ *        Each bus is probed by its own worker thread, so the boot time
+ *        is the one of the slowest bus instead of the sum of all of them.
+ *        The port layer must allow concurrent calls on different buses.
+ * @version 0.1
+ * @date Mar 22, 2022
+ * 
+ * @copyright Copyright (c) 2022
+ * 
+ */
+
+/************************************************************************
+    INCLUDES
+************************************************************************/
+#include "MCP9808_discovery.h"
+#include "MCP9808_port.h"
+
+#if MCP9808_DISCOVERY_THREADS
+#include <pthread.h>
+#endif /* MCP9808_DISCOVERY_THREADS */
+
+/************************************************************************
+     DEFINES AND TYPES
+************************************************************************/
+
+/** Per bus worker. Only the addresses found are kept: the handles are built in the table. */
+typedef struct
+{
+    void*                   bus;                                /**< Bus to probe */
+    size_t                  busIndex;                           /**< Bus index */
+    uint8_t                 address[MCP9808_ADDRESS_COUNT];     /**< Addresses of the devices found */
+    uint8_t                 revision[MCP9808_ADDRESS_COUNT];    /**< Revisions of the devices found */
+    uint8_t                 count;                              /**< Number of devices found */
+#if MCP9808_DISCOVERY_THREADS
+    pthread_t               thread;                         /**< Worker thread */
+    bool                    started;                        /**< Set if the thread is running */
+#endif /* MCP9808_DISCOVERY_THREADS */
+}MCP9808_Worker_t;
+
+/************************************************************************
+    FUNCTIONS
+************************************************************************/
+
+/**
+ * @brief Probe the MCP9808 addresses of one bus. The bus is initialized
+ *        once, then every address gets plain register reads (no device
+ *        handle). A device is reported if it answers with the MCP9808
+ *        manufacturer and device IDs.
+ *
+ * @param worker Worker (bus to probe and results).
+ */
+static void MCP9808_ProbeBus( MCP9808_Worker_t* worker )
+{
+    MCP9808_Error_t error = MCP9808_ERROR;
+    uint8_t regData[MCP9808_REG_SIZE] = { 0, 0 };
+    uint16_t manufacturer = 0;
+    uint8_t address = 0;
+
+    worker->count = 0U;
+
+    if( !IS_MCP9808_ERROR(MCP9808_PORT_Init(worker->bus)) )
+    {
+        for( address = MCP9808_ADDRESS_FIRST; address <= MCP9808_ADDRESS_LAST; address++ )
+        {
+            error = MCP9808_PORT_Read(worker->bus, address, MCP9808_REG_ID_1, MCP9808_REG_SIZE, regData);
+            manufacturer = (regData[MCP9808_MSB] << 8) | regData[MCP9808_LSB];
+            if( !IS_MCP9808_ERROR(error) && (manufacturer == MCP9808_MANUFACTURER_ID) )
+            {
+                error = MCP9808_PORT_Read(worker->bus, address, MCP9808_REG_ID_2, MCP9808_REG_SIZE, regData);
+            }
+            if( !IS_MCP9808_ERROR(error) && (manufacturer == MCP9808_MANUFACTURER_ID) &&
+                (regData[MCP9808_MSB] == MCP9808_DEVICE_ID) )
+            {
+                worker->address[worker->count] = address;
+                worker->revision[worker->count] = regData[MCP9808_LSB];
+                worker->count++;
+            }
+        }
+    }
+}
+
+#if MCP9808_DISCOVERY_THREADS
+/**
+ * @brief Worker thread entry point.
+ *
+ * @param arg Worker.
+ * @return void* NULL.
+ */
+static void* MCP9808_DiscoveryThread( void* arg )
+{
+    MCP9808_ProbeBus((MCP9808_Worker_t*)arg);
+    return NULL;
+}
+#endif /* MCP9808_DISCOVERY_THREADS */
+
+/**
+ * @brief     Find the MCP9808 devices (0x18 to 0x1F) of several buses. Up to
+ *            MCP9808_DISCOVERY_WORKERS buses are probed in parallel, one
+ *            thread per bus. The table is sorted by bus index, then address,
+ *            and its handles are initialized and ready to use.
+ *
+ * @param buses Port bus contexts (as given to MCP9808_Init()).
+ * @param nBuses Number of buses.
+ * @param table Discovered devices storage.
+ * @param max Table size.
+ * @param found Number of devices stored in the table.
+ * @return MCP9808_Error_t A number lower than '0' if something was wrong
+ *         (the table is filled up to "max" if it is too small).
+ */
+MCP9808_Error_t MCP9808_Discover( void* const* buses, size_t nBuses, MCP9808_Discovered_t* table,
+                                  size_t max, size_t* found )
+{
+    MCP9808_Error_t error = MCP9808_ERROR;
+    MCP9808_Worker_t workers[MCP9808_DISCOVERY_WORKERS];
+    size_t first = 0;
+    size_t chunk = 0;
+    size_t i = 0;
+    uint8_t j = 0;
+
+    if( (buses != NULL) && (table != NULL) && (found != NULL) )
+    {
+        error = MCP9808_OK;
+        *found = 0U;
+
+        for( first = 0; first < nBuses; first += chunk )
+        {
+            chunk = nBuses - first;
+            chunk = (chunk < MCP9808_DISCOVERY_WORKERS) ? chunk : MCP9808_DISCOVERY_WORKERS;
+
+            for( i = 0; i < chunk; i++ )
+            {
+                workers[i].bus = buses[first + i];
+                workers[i].busIndex = first + i;
+                workers[i].count = 0U;
+#if MCP9808_DISCOVERY_THREADS
+                workers[i].started = (pthread_create(&workers[i].thread, NULL,
+                                                     MCP9808_DiscoveryThread, &workers[i]) == 0);
+                if( !workers[i].started )
+#endif /* MCP9808_DISCOVERY_THREADS */
+                {
+                    /* No thread: probe it from here */
+                    MCP9808_ProbeBus(&workers[i]);
+                }
+            }
+
+            for( i = 0; i < chunk; i++ )
+            {
+#if MCP9808_DISCOVERY_THREADS
+                if( workers[i].started )
+                {
+                    pthread_join(workers[i].thread, NULL);
+                }
+#endif /* MCP9808_DISCOVERY_THREADS */
+                for( j = 0; j < workers[i].count; j++ )
+                {
+                    if( (*found < max) &&
+                        !IS_MCP9808_ERROR(MCP9808_Init(&table[*found].device, workers[i].bus, workers[i].address[j])) )
+                    {
+                        table[*found].busIndex = workers[i].busIndex;
+                        table[*found].revision = workers[i].revision[j];
+                        (*found)++;
+                    }
+                    else
+                    {
+                        error = MCP9808_ERROR;
+                    }
+                }
+            }
+        }
+    }
+
+    return error;
+}
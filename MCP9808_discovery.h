@@ -0,0 +1,70 @@
+/**                             _____________
+ *              /\      /\     /             \
+ *             //\\____//\\   |   MAUUUU!!    |
+ *            /     '      \   \  ___________/
+ *           /   /\ '  /\    \ /_/                  / /  ___    / __\ |__   __ _| |_
+ *          |    == o ==      |       /|         / /  / _ \  / /  | '_ \ / _` | __|
+ *           \      '        /       | |        / /__|  __/ / /___| | | | (_| | |_
+ *             \           /         \ \        \____/\___| \____/|_| |_|\__,_|\__|
+ *             /----<o>---- \         / /
+ *             |            ' \       \ \
+ *             |    |    | '   '\      \ \
+ *  _________  | ´´ |  ' |     '  \    / /
+ *  |  MAYA  | |  ' |    | '       |__/ /
+ *   \______/   \__/ \__/ \_______/____/
+ * @file MCP9808_discovery.h
+ * @author Alejandro Gomez Molina (@Alejo2312)
+ * @brief Bus discovery: probe every MCP9808 address of several buses.
+ * @version 0.1
+ * @date Mar 22, 2022
+ * 
+ * @copyright Copyright (c) 2022
+ * 
+ */
+#ifndef DRIVERS_INC_MCP9808_DISCOVERY_H_
+#define DRIVERS_INC_MCP9808_DISCOVERY_H_
+
+
+/************************************************************************
+    INCLUDES
+************************************************************************/
+#include "MCP9808.h"
+
+/************************************************************************
+    DEFINES AND TYPES
+************************************************************************/
+
+/** Set to 0 to probe the buses one after the other (no pthreads) */
+#ifndef MCP9808_DISCOVERY_THREADS
+#define MCP9808_DISCOVERY_THREADS   1
+#endif /* MCP9808_DISCOVERY_THREADS */
+
+/** Buses probed at the same time (one worker each) */
+#ifndef MCP9808_DISCOVERY_WORKERS
+#define MCP9808_DISCOVERY_WORKERS   16U
+#endif /* MCP9808_DISCOVERY_WORKERS */
+
+#define MCP9808_ADDRESS_FIRST       0x18U   /**< A2..A0 = 000 */
+#define MCP9808_ADDRESS_LAST        0x1FU   /**< A2..A0 = 111 */
+#define MCP9808_ADDRESS_COUNT       8U
+
+/** Discovered device */
+typedef struct
+{
+    MCP9808_Device_t    device;     /**< Initialized device handle */
+    size_t              busIndex;   /**< Index of the bus in the list given to MCP9808_Discover() */
+    uint8_t             revision;   /**< Device revision */
+}MCP9808_Discovered_t;
+
+/************************************************************************
+    FUNCTIONS
+************************************************************************/
+
+/**
+  See "MCP9808_discovery.c" for details of how to use this function.
+ */
+MCP9808_Error_t MCP9808_Discover( void* const* buses, size_t nBuses, MCP9808_Discovered_t* table,
+                                  size_t max, size_t* found );
+
+
+#endif /* DRIVERS_INC_MCP9808_DISCOVERY_H_ */
@@ -0,0 +1,347 @@
+/**                             _____________
+ *              /\      /\     /             \
+ *             //\\____//\\   |   MAUUUU!!    |
+ *            /     '      \   \  ___________/
+ *           /   /\ '  /\    \ /_/                  / /  ___    / __\ |__   __ _| |_
+ *          |    == o ==      |       /|         / /  / _ \  / /  | '_ \ / _` | __|
+ *           \      '        /       | |        / /__|  __/ / /___| | | | (_| | |_
+ *             \           /         \ \        \____/\___| \____/|_| |_|\__,_|\__|
+ *             /----<o>---- \         / /
+ *             |            ' \       \ \
+ *             |    |    | '   '\      \ \
+ *  _________  | ´´ |  ' |     '  \    / /
+ *  |  MAYA  | |  ' |    | '       |__/ /
+ *   \______/   \__/ \__/ \_______/____/
+ * @file MCP9808_engine.c
+ * @author Alejandro Gomez Molina (@Alejo2312)
+ * @brief Multi-bus acquisition engine. Every bus gets its own thread that
+ *        reads, once per period, the TA register of the devices on that
+ *        bus (round robin). Results go to a table protected by one
+ *        seqlock per entry: the only writer is the bus worker, readers
+ *        never block it and only retry if they race with a write
+ *        (lock-free, not wait-free). Entries are cache line aligned.
+ *        The port layer must allow concurrent calls on different buses.
+ * @version 0.1
+ * @date Mar 22, 2022
+ * 
+ * @copyright Copyright (c) 2022
+ * 
+ */
+
+/************************************************************************
+    INCLUDES
+************************************************************************/
+#include <time.h>
+#include "MCP9808_engine.h"
+
+/************************************************************************
+     DEFINES AND TYPES
+************************************************************************/
+#define MCP9808_NS_PER_US       1000ULL
+#define MCP9808_NS_PER_S        1000000000ULL
+
+/************************************************************************
+    FUNCTIONS
+************************************************************************/
+
+/**
+ * @brief Get the monotonic time.
+ *
+ * @return uint64_t Time (ns).
+ */
+static uint64_t MCP9808_EngineNow( void )
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return (uint64_t)now.tv_sec * MCP9808_NS_PER_S + (uint64_t)now.tv_nsec;
+}
+
+/**
+ * @brief Publish a read result (single writer).
+ *
+ * @param entry Table entry.
+ * @param error Read result.
+ * @param raw Raw TA register.
+ * @param timeNs Read time (ns).
+ */
+static void MCP9808_EnginePublish( MCP9808_Engine_Entry_t* entry, MCP9808_Error_t error, uint16_t raw,
+                                   uint64_t timeNs )
+{
+    uint32_t sequence = atomic_load_explicit(&entry->sequence, memory_order_relaxed);
+
+    atomic_store_explicit(&entry->sequence, sequence + 1U, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+
+    atomic_store_explicit(&entry->timeNs, timeNs, memory_order_relaxed);
+    atomic_store_explicit(&entry->error, error, memory_order_relaxed);
+    if( IS_MCP9808_ERROR(error) )
+    {
+        atomic_store_explicit(&entry->errors, atomic_load_explicit(&entry->errors, memory_order_relaxed) + 1U,
+                              memory_order_relaxed);
+    }
+    else
+    {
+        atomic_store_explicit(&entry->raw, raw, memory_order_relaxed);
+        atomic_store_explicit(&entry->temperature, MCP9808_RegToQ4(raw), memory_order_relaxed);
+        atomic_store_explicit(&entry->samples, atomic_load_explicit(&entry->samples, memory_order_relaxed) + 1U,
+                              memory_order_relaxed);
+    }
+
+    atomic_store_explicit(&entry->sequence, sequence + 2U, memory_order_release);
+}
+
+/**
+ * @brief Bus worker: read every device of the bus once per period.
+ *
+ * @param arg Worker.
+ * @return void* NULL.
+ */
+static void* MCP9808_EngineWorker( void* arg )
+{
+    MCP9808_Engine_Worker_t* worker = (MCP9808_Engine_Worker_t*)arg;
+    MCP9808_Engine_t* engine = worker->engine;
+    uint64_t periodNs = (uint64_t)engine->periodUs * MCP9808_NS_PER_US;
+    uint64_t deadline = MCP9808_EngineNow();
+    uint64_t now = 0;
+    struct timespec wake;
+    MCP9808_Error_t error = MCP9808_ERROR;
+    uint16_t raw = 0;
+    size_t i = 0;
+
+    while( !atomic_load_explicit(&engine->stop, memory_order_relaxed) )
+    {
+        for( i = 0; i < engine->count; i++ )
+        {
+            if( engine->devices[i]->bus == worker->bus )
+            {
+                raw = 0U;
+                error = MCP9808_ReadTemperatureRaw(engine->devices[i], &raw);
+                MCP9808_EnginePublish(&engine->entries[i], error, raw, MCP9808_EngineNow());
+            }
+        }
+
+        deadline += periodNs;
+        now = MCP9808_EngineNow();
+        if( now > deadline )
+        {
+            /* Bus too slow for the period: restart from now, do not burst */
+            atomic_store_explicit(&worker->overruns,
+                                  atomic_load_explicit(&worker->overruns, memory_order_relaxed) + 1U,
+                                  memory_order_relaxed);
+            deadline = now;
+        }
+        else
+        {
+            wake.tv_sec = (time_t)(deadline / MCP9808_NS_PER_S);
+            wake.tv_nsec = (long)(deadline % MCP9808_NS_PER_S);
+            clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &wake, NULL);
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief     Initialize an acquisition engine. Devices are grouped by bus
+ *            (MCP9808_Device_t bus context), one worker per bus.
+ *
+ * @param engine Engine storage.
+ * @param devices Initialized device handles. The list must stay valid while the engine runs.
+ * @param n Number of devices.
+ * @param entries Result table storage, n entries (entry i belongs to devices[i]),
+ *        MCP9808_ENGINE_CACHE_LINE aligned (e.g. aligned_alloc() if it is allocated).
+ * @param periodUs Acquisition period (us).
+ * @return MCP9808_Error_t A number lower than '0' if something was wrong.
+ */
+MCP9808_Error_t MCP9808_EngineInit( MCP9808_Engine_t* engine, MCP9808_Device_t* const* devices, size_t n,
+                                    MCP9808_Engine_Entry_t* entries, uint32_t periodUs )
+{
+    MCP9808_Error_t error = MCP9808_ERROR;
+    size_t i = 0;
+    uint8_t j = 0;
+
+    if( (engine != NULL) && (devices != NULL) && (entries != NULL) )
+    {
+        error = MCP9808_OK;
+        engine->devices = devices;
+        engine->entries = entries;
+        engine->count = n;
+        engine->periodUs = periodUs;
+        engine->nWorkers = 0U;
+        atomic_init(&engine->stop, false);
+
+        for( i = 0; (i < n) && !IS_MCP9808_ERROR(error); i++ )
+        {
+            atomic_init(&entries[i].sequence, 0U);
+            atomic_init(&entries[i].timeNs, 0U);
+            atomic_init(&entries[i].samples, 0U);
+            atomic_init(&entries[i].errors, 0U);
+            atomic_init(&entries[i].error, MCP9808_ERROR);
+            atomic_init(&entries[i].raw, 0U);
+            atomic_init(&entries[i].temperature, 0);
+
+            if( devices[i] == NULL )
+            {
+                error = MCP9808_ERROR;
+            }
+            else
+            {
+                for( j = 0; (j < engine->nWorkers) && (engine->workers[j].bus != devices[i]->bus); j++ )
+                {
+                    /* Look for the bus worker */
+                }
+
+                if( j == engine->nWorkers )
+                {
+                    if( j < MCP9808_ENGINE_MAX_BUSES )
+                    {
+                        engine->workers[j].engine = engine;
+                        engine->workers[j].bus = devices[i]->bus;
+                        engine->workers[j].started = false;
+                        atomic_init(&engine->workers[j].overruns, 0U);
+                        engine->nWorkers++;
+                    }
+                    else
+                    {
+                        error = MCP9808_ERROR;
+                    }
+                }
+            }
+        }
+    }
+
+    return error;
+}
+
+/**
+ * @brief Start the bus workers.
+ *
+ * @param engine Engine.
+ * @return MCP9808_Error_t A number lower than '0' if something was wrong
+ *         (the workers already started are stopped).
+ */
+MCP9808_Error_t MCP9808_EngineStart( MCP9808_Engine_t* engine )
+{
+    MCP9808_Error_t error = MCP9808_ERROR;
+    uint8_t j = 0;
+
+    if( engine != NULL )
+    {
+        error = MCP9808_OK;
+        atomic_store(&engine->stop, false);
+
+        for( j = 0; (j < engine->nWorkers) && !IS_MCP9808_ERROR(error); j++ )
+        {
+            engine->workers[j].started = (pthread_create(&engine->workers[j].thread, NULL,
+                                                         MCP9808_EngineWorker, &engine->workers[j]) == 0);
+            error = engine->workers[j].started ? MCP9808_OK : MCP9808_ERROR;
+        }
+
+        if( IS_MCP9808_ERROR(error) )
+        {
+            MCP9808_EngineStop(engine);
+        }
+    }
+
+    return error;
+}
+
+/**
+ * @brief Stop the bus workers and wait for them. The result table keeps
+ *        the last samples.
+ *
+ * @param engine Engine.
+ * @return MCP9808_Error_t A number lower than '0' if something was wrong.
+ */
+MCP9808_Error_t MCP9808_EngineStop( MCP9808_Engine_t* engine )
+{
+    MCP9808_Error_t error = MCP9808_ERROR;
+    uint8_t j = 0;
+
+    if( engine != NULL )
+    {
+        atomic_store(&engine->stop, true);
+
+        for( j = 0; j < engine->nWorkers; j++ )
+        {
+            if( engine->workers[j].started )
+            {
+                pthread_join(engine->workers[j].thread, NULL);
+                engine->workers[j].started = false;
+            }
+        }
+        error = MCP9808_OK;
+    }
+
+    return error;
+}
+
+/**
+ * @brief     Get the latest sample of a device. It never blocks the bus
+ *            workers; it only retries if the entry is updated while it is
+ *            being copied (lock-free, not wait-free). Can be called from
+ *            any thread.
+ *
+ * @param engine Engine.
+ * @param index Device index (position in the list given to MCP9808_EngineInit()).
+ * @param sample Sample storage.
+ * @return MCP9808_Error_t A number lower than '0' if something was wrong.
+ */
+MCP9808_Error_t MCP9808_EngineRead( MCP9808_Engine_t* engine, size_t index, MCP9808_Engine_Sample_t* sample )
+{
+    MCP9808_Error_t error = MCP9808_ERROR;
+    MCP9808_Engine_Entry_t* entry = NULL;
+    uint32_t before = 0;
+    uint32_t after = 0;
+
+    if( (engine != NULL) && (sample != NULL) && (index < engine->count) )
+    {
+        entry = &engine->entries[index];
+
+        do
+        {
+            before = atomic_load_explicit(&entry->sequence, memory_order_acquire);
+
+            sample->timeNs = atomic_load_explicit(&entry->timeNs, memory_order_relaxed);
+            sample->samples = atomic_load_explicit(&entry->samples, memory_order_relaxed);
+            sample->errors = atomic_load_explicit(&entry->errors, memory_order_relaxed);
+            sample->error = atomic_load_explicit(&entry->error, memory_order_relaxed);
+            sample->raw = atomic_load_explicit(&entry->raw, memory_order_relaxed);
+            sample->temperature = atomic_load_explicit(&entry->temperature, memory_order_relaxed);
+
+            atomic_thread_fence(memory_order_acquire);
+            after = atomic_load_explicit(&entry->sequence, memory_order_relaxed);
+        }
+        while( (before != after) || (before & 1U) );
+
+        error = MCP9808_OK;
+    }
+
+    return error;
+}
+
+/**
+ * @brief Get the acquisition periods missed so far, all buses together
+ *        (a bus worker could not read its devices within the period).
+ *        Can be called from any thread.
+ *
+ * @param engine Engine.
+ * @return uint32_t Missed periods.
+ */
+uint32_t MCP9808_EngineOverruns( const MCP9808_Engine_t* engine )
+{
+    uint32_t overruns = 0;
+    uint8_t j = 0;
+
+    if( engine != NULL )
+    {
+        for( j = 0; j < engine->nWorkers; j++ )
+        {
+            overruns += (uint32_t)atomic_load_explicit(&engine->workers[j].overruns, memory_order_relaxed);
+        }
+    }
+
+    return overruns;
+}
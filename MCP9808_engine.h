@@ -0,0 +1,129 @@
+/**                             _____________
+ *              /\      /\     /             \
+ *             //\\____//\\   |   MAUUUU!!    |
+ *            /     '      \   \  ___________/
+ *           /   /\ '  /\    \ /_/                  / /  ___    / __\ |__   __ _| |_
+ *          |    == o ==      |       /|         / /  / _ \  / /  | '_ \ / _` | __|
+ *           \      '        /       | |        / /__|  __/ / /___| | | | (_| | |_
+ *             \           /         \ \        \____/\___| \____/|_| |_|\__,_|\__|
+ *             /----<o>---- \         / /
+ *             |            ' \       \ \
+ *             |    |    | '   '\      \ \
+ *  _________  | ´´ |  ' |     '  \    / /
+ *  |  MAYA  | |  ' |    | '       |__/ /
+ *   \______/   \__/ \__/ \_______/____/
+ * @file MCP9808_engine.h
+ * @author Alejandro Gomez Molina (@Alejo2312)
+ * @brief Multi-bus acquisition engine: one thread per bus, latest samples
+ *        published in a seqlock table.
+ * @version 0.1
+ * @date Mar 22, 2022
+ * 
+ * @copyright Copyright (c) 2022
+ * 
+ */
+#ifndef DRIVERS_INC_MCP9808_ENGINE_H_
+#define DRIVERS_INC_MCP9808_ENGINE_H_
+
+
+/************************************************************************
+    INCLUDES
+************************************************************************/
+#include <pthread.h>
+#include <stdatomic.h>
+#include "MCP9808.h"
+
+/************************************************************************
+    DEFINES AND TYPES
+************************************************************************/
+
+/** Maximum number of buses (worker threads) per engine */
+#ifndef MCP9808_ENGINE_MAX_BUSES
+#define MCP9808_ENGINE_MAX_BUSES    16U
+#endif /* MCP9808_ENGINE_MAX_BUSES */
+
+/** Cache line size: each result table entry gets its own line */
+#ifndef MCP9808_ENGINE_CACHE_LINE
+#define MCP9808_ENGINE_CACHE_LINE   64U
+#endif /* MCP9808_ENGINE_CACHE_LINE */
+
+/** Latest sample of a device, as returned by MCP9808_EngineRead() */
+typedef struct
+{
+    uint64_t        timeNs;         /**< Read time (CLOCK_MONOTONIC, ns) */
+    uint32_t        samples;        /**< Successful reads since start */
+    uint32_t        errors;         /**< Failed reads since start */
+    MCP9808_Error_t error;          /**< Last read result */
+    uint16_t        raw;            /**< Last raw TA register (MSB << 8 | LSB) */
+    int16_t         temperature;    /**< Last temperature (1/16 °C) */
+}MCP9808_Engine_Sample_t;
+
+/** Result table entry. Written by one bus worker, read by anyone (seqlock).
+    Cache line aligned, so workers and readers of neighbouring devices do not share lines. */
+typedef struct
+{
+    _Alignas(MCP9808_ENGINE_CACHE_LINE) atomic_uint_least32_t sequence; /**< Odd while the entry is being written */
+    atomic_uint_least64_t   timeNs;
+    atomic_uint_least32_t   samples;
+    atomic_uint_least32_t   errors;
+    atomic_int              error;
+    atomic_uint_least16_t   raw;
+    atomic_int_least16_t    temperature;
+}MCP9808_Engine_Entry_t;
+
+typedef struct MCP9808_Engine_s MCP9808_Engine_t;
+
+/** Bus worker */
+typedef struct
+{
+    MCP9808_Engine_t*   engine;     /**< Owner engine */
+    void*               bus;        /**< Bus polled by this worker */
+    pthread_t           thread;     /**< Worker thread */
+    bool                started;    /**< Set while the thread runs */
+    atomic_uint_least32_t overruns; /**< Periods missed because the bus was too slow (written by the worker only) */
+}MCP9808_Engine_Worker_t;
+
+/** Acquisition engine */
+struct MCP9808_Engine_s
+{
+    MCP9808_Device_t* const*    devices;    /**< Device handles */
+    MCP9808_Engine_Entry_t*     entries;    /**< Result table, one entry per device */
+    size_t                      count;      /**< Number of devices */
+    uint32_t                    periodUs;   /**< Acquisition period */
+    atomic_bool                 stop;       /**< Set to stop the workers */
+    MCP9808_Engine_Worker_t     workers[MCP9808_ENGINE_MAX_BUSES];  /**< Bus workers */
+    uint8_t                     nWorkers;   /**< Number of buses */
+};
+
+/************************************************************************
+    FUNCTIONS
+************************************************************************/
+
+/**
+  See "MCP9808_engine.c" for details of how to use this function.
+ */
+MCP9808_Error_t MCP9808_EngineInit( MCP9808_Engine_t* engine, MCP9808_Device_t* const* devices, size_t n,
+                                    MCP9808_Engine_Entry_t* entries, uint32_t periodUs );
+
+/**
+  See "MCP9808_engine.c" for details of how to use this function.
+ */
+MCP9808_Error_t MCP9808_EngineStart( MCP9808_Engine_t* engine );
+
+/**
+  See "MCP9808_engine.c" for details of how to use this function.
+ */
+MCP9808_Error_t MCP9808_EngineStop( MCP9808_Engine_t* engine );
+
+/**
+  See "MCP9808_engine.c" for details of how to use this function.
+ */
+MCP9808_Error_t MCP9808_EngineRead( MCP9808_Engine_t* engine, size_t index, MCP9808_Engine_Sample_t* sample );
+
+/**
+  See "MCP9808_engine.c" for details of how to use this function.
+ */
+uint32_t MCP9808_EngineOverruns( const MCP9808_Engine_t* engine );
+
+
+#endif /* DRIVERS_INC_MCP9808_ENGINE_H_ */
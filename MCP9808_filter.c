@@ -0,0 +1,142 @@
+/**                             _____________
+ *              /\      /\     /             \
+ *             //\\____//\\   |   MAUUUU!!    |
+ *            /     '      \   \  ___________/
+ *           /   /\ '  /\    \ /_/                  / /  ___    / __\ |__   __ _| |_
+ *          |    == o ==      |       /|         / /  / _ \  / /  | '_ \ / _` | __|
+ *           \      '        /       | |        / /__|  __/ / /___| | | | (_| | |_
+ *             \           /         \ \        \____/\___| \____/|_| |_|\__,_|\__|
+ *             /----<o>---- \         / /
+ *             |            ' \       \ \
+ *             |    |    | '   '\      \ \
+ *  _________  | ´´ |  ' |     '  \    / /
+ *  |  MAYA  | |  ' |    | '       |__/ /
+ *   \______/   \__/ \__/ \_______/____/
+ * @file MCP9808_filter.c
+ * @author Alejandro Gomez Molina (@Alejo2312)
+ * @brief Change-only reporting filter, placed between acquisition and
+ *        publishing. A sample is reported when it moved more than the
+ *        deadband away from the last reported one, when the alert flags
+ *        of TA (TCRIT/TUPPER/TLOWER) change, or when nothing was reported
+ *        for the heartbeat interval. An optional median of the last N
+ *        samples rejects single-sample spikes before the deadband test.
+ * @version 0.1
+ * @date Mar 22, 2022
+ * 
+ * @copyright Copyright (c) 2022
+ * 
+ */
+
+/************************************************************************
+    INCLUDES
+************************************************************************/
+#include "MCP9808_filter.h"
+
+/************************************************************************
+    FUNCTIONS
+************************************************************************/
+
+/**
+ * @brief Initialize a reporting filter.
+ *
+ * @param filter Filter storage.
+ * @param deadband Changes up to this many LSB (1/16 °C) are not reported (0 reports every change).
+ * @param heartbeatUs Longest time without report (us, 0 to disable).
+ * @param median Median window: 1 (disabled), 3, 5... up to MCP9808_FILTER_MEDIAN_MAX.
+ * @return MCP9808_Error_t A number lower than '0' if something was wrong.
+ */
+MCP9808_Error_t MCP9808_FilterInit( MCP9808_Filter_t* filter, uint16_t deadband, uint32_t heartbeatUs,
+                                    uint8_t median )
+{
+    MCP9808_Error_t error = MCP9808_ERROR;
+
+    if( (filter != NULL) && ((median & 1U) != 0U) && (median <= MCP9808_FILTER_MEDIAN_MAX) )
+    {
+        filter->deadband = deadband;
+        filter->heartbeatUs = heartbeatUs;
+        filter->median = median;
+        filter->fill = 0U;
+        filter->next = 0U;
+        filter->reported = false;
+        filter->lastTemperature = 0;
+        filter->lastFlags = 0U;
+        filter->lastTimeUs = 0U;
+        filter->samples = 0U;
+        filter->reports = 0U;
+        error = MCP9808_OK;
+    }
+
+    return error;
+}
+
+/**
+ * @brief Get the median of the samples in the window.
+ *
+ * @param filter Filter.
+ * @return int16_t Median (1/16 °C). With an even number of samples (window
+ *         still filling) the lower middle one.
+ */
+static int16_t MCP9808_FilterMedian( const MCP9808_Filter_t* filter )
+{
+    int16_t sorted[MCP9808_FILTER_MEDIAN_MAX];
+    int16_t value = 0;
+    uint8_t i = 0;
+    uint8_t j = 0;
+
+    for( i = 0; i < filter->fill; i++ )
+    {
+        value = filter->window[i];
+        for( j = i; (j > 0U) && (sorted[j - 1U] > value); j-- )
+        {
+            sorted[j] = sorted[j - 1U];
+        }
+        sorted[j] = value;
+    }
+
+    return sorted[(filter->fill - 1U) / 2U];
+}
+
+/**
+ * @brief Feed a sample and tell whether it has to be reported.
+ *
+ * @param filter Filter.
+ * @param nowUs Sample time (us, free running, may wrap around).
+ * @param raw Raw TA register (MSB << 8 | LSB), alert flags included.
+ * @param temperature Filtered temperature (1/16 °C): the value to report.
+ * @param report Set to true if the sample has to be reported.
+ * @return MCP9808_Error_t A number lower than '0' if something was wrong.
+ */
+MCP9808_Error_t MCP9808_FilterUpdate( MCP9808_Filter_t* filter, uint32_t nowUs, uint16_t raw,
+                                      int16_t* temperature, bool* report )
+{
+    MCP9808_Error_t error = MCP9808_ERROR;
+    uint16_t flags = raw & MCP9808_TA_FLAGS_MSK;
+    int32_t change = 0;
+
+    if( (filter != NULL) && (temperature != NULL) && (report != NULL) )
+    {
+        filter->window[filter->next] = MCP9808_RegToQ4(raw);
+        filter->next = (uint8_t)((filter->next + 1U) % filter->median);
+        filter->fill = (filter->fill < filter->median) ? (uint8_t)(filter->fill + 1U) : filter->fill;
+        filter->samples++;
+
+        *temperature = MCP9808_FilterMedian(filter);
+        change = (int32_t)*temperature - filter->lastTemperature;
+
+        *report = !filter->reported || (flags != filter->lastFlags) ||
+                  (change > (int32_t)filter->deadband) || (-change > (int32_t)filter->deadband) ||
+                  ((filter->heartbeatUs != 0U) && ((nowUs - filter->lastTimeUs) >= filter->heartbeatUs));
+
+        if( *report )
+        {
+            filter->reported = true;
+            filter->lastTemperature = *temperature;
+            filter->lastFlags = flags;
+            filter->lastTimeUs = nowUs;
+            filter->reports++;
+        }
+        error = MCP9808_OK;
+    }
+
+    return error;
+}
@@ -0,0 +1,76 @@
+/**                             _____________
+ *              /\      /\     /             \
+ *             //\\____//\\   |   MAUUUU!!    |
+ *            /     '      \   \  ___________/
+ *           /   /\ '  /\    \ /_/                  / /  ___    / __\ |__   __ _| |_
+ *          |    == o ==      |       /|         / /  / _ \  / /  | '_ \ / _` | __|
+ *           \      '        /       | |        / /__|  __/ / /___| | | | (_| | |_
+ *             \           /         \ \        \____/\___| \____/|_| |_|\__,_|\__|
+ *             /----<o>---- \         / /
+ *             |            ' \       \ \
+ *             |    |    | '   '\      \ \
+ *  _________  | ´´ |  ' |     '  \    / /
+ *  |  MAYA  | |  ' |    | '       |__/ /
+ *   \______/   \__/ \__/ \_______/____/
+ * @file MCP9808_filter.h
+ * @author Alejandro Gomez Molina (@Alejo2312)
+ * @brief Change-only reporting filter (deadband, heartbeat, median).
+ * @version 0.1
+ * @date Mar 22, 2022
+ * 
+ * @copyright Copyright (c) 2022
+ * 
+ */
+#ifndef DRIVERS_INC_MCP9808_FILTER_H_
+#define DRIVERS_INC_MCP9808_FILTER_H_
+
+
+/************************************************************************
+    INCLUDES
+************************************************************************/
+#include "MCP9808.h"
+
+/************************************************************************
+    DEFINES AND TYPES
+************************************************************************/
+
+/** Largest median window (samples, odd) */
+#ifndef MCP9808_FILTER_MEDIAN_MAX
+#define MCP9808_FILTER_MEDIAN_MAX   7U
+#endif /* MCP9808_FILTER_MEDIAN_MAX */
+
+/** Per-device reporting filter */
+typedef struct
+{
+    uint16_t    deadband;       /**< Changes up to this many LSB (1/16 °C) are not reported */
+    uint32_t    heartbeatUs;    /**< Longest time without report (us, 0 to disable) */
+    uint8_t     median;         /**< Median window (1 to disable spike rejection) */
+    uint8_t     fill;           /**< Samples in the median window */
+    uint8_t     next;           /**< Next median window slot */
+    int16_t     window[MCP9808_FILTER_MEDIAN_MAX];  /**< Last samples (1/16 °C) */
+    bool        reported;       /**< Set after the first report */
+    int16_t     lastTemperature;    /**< Last reported temperature (1/16 °C) */
+    uint16_t    lastFlags;      /**< Last reported TCRIT/TUPPER/TLOWER flags */
+    uint32_t    lastTimeUs;     /**< Last report time (us) */
+    uint32_t    samples;        /**< Samples seen */
+    uint32_t    reports;        /**< Samples reported */
+}MCP9808_Filter_t;
+
+/************************************************************************
+    FUNCTIONS
+************************************************************************/
+
+/**
+  See "MCP9808_filter.c" for details of how to use this function.
+ */
+MCP9808_Error_t MCP9808_FilterInit( MCP9808_Filter_t* filter, uint16_t deadband, uint32_t heartbeatUs,
+                                    uint8_t median );
+
+/**
+  See "MCP9808_filter.c" for details of how to use this function.
+ */
+MCP9808_Error_t MCP9808_FilterUpdate( MCP9808_Filter_t* filter, uint32_t nowUs, uint16_t raw,
+                                      int16_t* temperature, bool* report );
+
+
+#endif /* DRIVERS_INC_MCP9808_FILTER_H_ */
@@ -0,0 +1,641 @@
+/**                             _____________
+ *              /\      /\     /             \
+ *             //\\____//\\   |   MAUUUU!!    |
+ *            /     '      \   \  ___________/
+ *           /   /\ '  /\    \ /_/                  / /  ___    / __\ |__   __ _| |_
+ *          |    == o ==      |       /|         / /  / _ \  / /  | '_ \ / _` | __|
+ *           \      '        /       | |        / /__|  __/ / /___| | | | (_| | |_
+ *             \           /         \ \        \____/\___| \____/|_| |_|\__,_|\__|
+ *             /----<o>---- \         / /
+ *             |            ' \       \ \
+ *             |    |    | '   '\      \ \
+ *  _________  | ´´ |  ' |     '  \    / /
+ *  |  MAYA  | |  ' |    | '       |__/ /
+ *   \______/   \__/ \__/ \_______/____/
+ * @file MCP9808_log.c
+ * @author Alejandro Gomez Molina (@Alejo2312)
+ * @brief Compact binary log of temperature samples. Samples are grouped
+ *        in per-sensor blocks; inside a block the first sample is stored
+ *        as is and the next ones as zigzag varints of the timestamp
+ *        delta-of-delta and the temperature delta (13-bit TA value, alert
+ *        flags are not stored). A regular 4 Hz stream of a slowly moving
+ *        temperature takes 2 bytes per sample.
+ *
+ *        | "MCPL" | version | 0 | 0 | 0 |                    file header
+ *        | sensor | count | size | temperature | time | payload |   block (repeated)
+ *        | offset | key | ... |                          index footer
+ *        | index offset | entries | "MCPI" |               trailer
+ *
+ *        All fields are little endian. The index is written when the log
+ *        is closed; a log without it can still be read sequentially.
+ * @version 0.1
+ * @date Mar 22, 2022
+ * 
+ * @copyright Copyright (c) 2022
+ * 
+ */
+
+/************************************************************************
+    INCLUDES
+************************************************************************/
+#include <string.h>
+#include "MCP9808_log.h"
+
+/************************************************************************
+    DEFINES AND TYPES
+************************************************************************/
+#define MCP9808_LOG_DELTA_MAX   0xFFFFFFFFULL   /**< Longest time delta inside a block (us) */
+
+static const uint8_t MCP9808_LOG_Magic[4] = { 'M', 'C', 'P', 'L' };
+static const uint8_t MCP9808_LOG_IndexMagic[4] = { 'M', 'C', 'P', 'I' };
+
+/************************************************************************
+    FUNCTIONS
+************************************************************************/
+
+/**
+ * @brief Store a little endian value.
+ *
+ * @param buffer Output.
+ * @param value Value.
+ * @param size Value size in bytes.
+ */
+static void MCP9808_LogPut( uint8_t* buffer, uint64_t value, uint8_t size )
+{
+    uint8_t i = 0;
+
+    for( i = 0; i < size; i++ )
+    {
+        buffer[i] = (uint8_t)(value >> (8U * i));
+    }
+}
+
+/**
+ * @brief Load a little endian value.
+ *
+ * @param buffer Input.
+ * @param size Value size in bytes.
+ * @return uint64_t Value.
+ */
+static uint64_t MCP9808_LogGet( const uint8_t* buffer, uint8_t size )
+{
+    uint64_t value = 0;
+    uint8_t i = 0;
+
+    for( i = 0; i < size; i++ )
+    {
+        value |= (uint64_t)buffer[i] << (8U * i);
+    }
+
+    return value;
+}
+
+/**
+ * @brief Encode a signed value as a zigzag varint (7 bits per byte,
+ *        lowest first, small magnitudes take one byte).
+ *
+ * @param buffer Output, up to 10 bytes.
+ * @param value Value.
+ * @return uint8_t Bytes written.
+ */
+static uint8_t MCP9808_LogPutVarint( uint8_t* buffer, int64_t value )
+{
+    uint64_t zigzag = (value < 0) ? ~((uint64_t)value << 1) : ((uint64_t)value << 1);
+    uint8_t size = 0;
+
+    while( zigzag >= 0x80U )
+    {
+        buffer[size++] = (uint8_t)(zigzag | 0x80U);
+        zigzag >>= 7;
+    }
+    buffer[size++] = (uint8_t)zigzag;
+
+    return size;
+}
+
+/**
+ * @brief Decode a zigzag varint.
+ *
+ * @param buffer Input.
+ * @param size Input size.
+ * @param position Read position, updated.
+ * @param value Decoded value.
+ * @return MCP9808_Error_t A number lower than '0' if the varint is truncated or too long.
+ */
+static MCP9808_Error_t MCP9808_LogGetVarint( const uint8_t* buffer, uint16_t size, uint16_t* position,
+                                             int64_t* value )
+{
+    MCP9808_Error_t error = MCP9808_ERROR;
+    uint64_t zigzag = 0;
+    uint8_t shift = 0;
+
+    while( (*position < size) && (shift < 64U) && IS_MCP9808_ERROR(error) )
+    {
+        zigzag |= (uint64_t)(buffer[*position] & 0x7FU) << shift;
+        shift += 7U;
+        if( (buffer[(*position)++] & 0x80U) == 0U )
+        {
+            *value = (zigzag & 1U) ? (int64_t)~(zigzag >> 1) : (int64_t)(zigzag >> 1);
+            error = MCP9808_OK;
+        }
+    }
+
+    return error;
+}
+
+/**
+ * @brief Write bytes to the log file.
+ *
+ * @param writer Log writer.
+ * @param data Bytes.
+ * @param size Number of bytes.
+ * @return MCP9808_Error_t A number lower than '0' if something was wrong.
+ */
+static MCP9808_Error_t MCP9808_LogWrite( MCP9808_Log_Writer_t* writer, const uint8_t* data, size_t size )
+{
+    MCP9808_Error_t error = MCP9808_ERROR;
+
+    if( fwrite(data, 1, size, writer->file) == size )
+    {
+        writer->offset += size;
+        error = MCP9808_OK;
+    }
+
+    return error;
+}
+
+/**
+ * @brief Add a block to the index. When the index is full every other
+ *        entry is dropped and only one block out of "stride" is indexed
+ *        from then on; the reader scans the blocks in between.
+ *
+ * @param writer Log writer.
+ * @param offset Block offset.
+ */
+static void MCP9808_LogIndexAdd( MCP9808_Log_Writer_t* writer, uint64_t offset )
+{
+    uint32_t i = 0;
+
+    if( (writer->indexMax > 1U) && ((writer->blocks % writer->stride) == 0U) )
+    {
+        if( writer->indexCount == writer->indexMax )
+        {
+            for( i = 0; (2U * i) < writer->indexCount; i++ )
+            {
+                writer->index[i] = writer->index[2U * i];
+            }
+            writer->indexCount = i;
+            writer->stride *= 2U;
+        }
+
+        if( (writer->blocks % writer->stride) == 0U )
+        {
+            writer->index[writer->indexCount].offset = offset;
+            writer->index[writer->indexCount].keyUs = writer->latestUs;
+            writer->indexCount++;
+        }
+    }
+
+    writer->blocks++;
+}
+
+/**
+ * @brief Write the open block of a sensor, if any.
+ *
+ * @param writer Log writer.
+ * @param sensor Sensor number.
+ * @return MCP9808_Error_t A number lower than '0' if something was wrong.
+ */
+static MCP9808_Error_t MCP9808_LogWriteBlock( MCP9808_Log_Writer_t* writer, uint16_t sensor )
+{
+    MCP9808_Error_t error = MCP9808_OK;
+    MCP9808_Log_Stream_t* stream = &writer->streams[sensor];
+    uint8_t header[MCP9808_LOG_BLOCK_HEADER];
+    uint64_t offset = writer->offset;
+
+    if( stream->count != 0U )
+    {
+        MCP9808_LogPut(&header[0], sensor, 2U);
+        MCP9808_LogPut(&header[2], stream->count, 2U);
+        MCP9808_LogPut(&header[4], stream->size, 2U);
+        MCP9808_LogPut(&header[6], (uint16_t)stream->firstTemperature, 2U);
+        MCP9808_LogPut(&header[8], stream->firstTimeUs, 8U);
+
+        error = MCP9808_LogWrite(writer, header, sizeof(header));
+        if( !IS_MCP9808_ERROR(error) )
+        {
+            error = MCP9808_LogWrite(writer, stream->payload, stream->size);
+        }
+        if( !IS_MCP9808_ERROR(error) )
+        {
+            MCP9808_LogIndexAdd(writer, offset);
+        }
+        stream->count = 0U;
+    }
+
+    return error;
+}
+
+/**
+ * @brief     Start a log: write the file header. Memory use is fixed by
+ *            the storage given here: one open block per sensor
+ *            (MCP9808_LOG_BLOCK_SIZE bytes each) and "indexMax" index
+ *            entries.
+ *
+ * @param writer Log writer storage.
+ * @param file Output file, opened for binary writing.
+ * @param streams Open blocks storage, one per sensor.
+ * @param nStreams Number of sensors (sensor numbers go from 0 to nStreams - 1).
+ * @param index Index storage (can be NULL for a log without index).
+ * @param indexMax Index capacity.
+ * @return MCP9808_Error_t A number lower than '0' if something was wrong.
+ */
+MCP9808_Error_t MCP9808_LogWriterOpen( MCP9808_Log_Writer_t* writer, FILE* file, MCP9808_Log_Stream_t* streams,
+                                       uint16_t nStreams, MCP9808_Log_Index_t* index, uint32_t indexMax )
+{
+    MCP9808_Error_t error = MCP9808_ERROR;
+    uint8_t header[MCP9808_LOG_HEADER_SIZE] = { 0 };
+    uint16_t i = 0;
+
+    if( (writer != NULL) && (file != NULL) && (streams != NULL) && (nStreams != 0U) )
+    {
+        writer->file = file;
+        writer->offset = 0U;
+        writer->latestUs = 0U;
+        writer->streams = streams;
+        writer->nStreams = nStreams;
+        writer->index = index;
+        writer->indexMax = (index != NULL) ? indexMax : 0U;
+        writer->indexCount = 0U;
+        writer->stride = 1U;
+        writer->blocks = 0U;
+
+        for( i = 0; i < nStreams; i++ )
+        {
+            streams[i].count = 0U;
+        }
+
+        memcpy(header, MCP9808_LOG_Magic, sizeof(MCP9808_LOG_Magic));
+        header[4] = MCP9808_LOG_VERSION;
+        error = MCP9808_LogWrite(writer, header, sizeof(header));
+    }
+
+    return error;
+}
+
+/**
+ * @brief     Append a sample to the block of its sensor. Blocks are written
+ *            to the file when full, so the cost does not depend on the log
+ *            length. A new block is started if the time goes backwards or
+ *            jumps more than MCP9808_LOG_DELTA_MAX.
+ *
+ * @param writer Log writer.
+ * @param sensor Sensor number (0 to nStreams - 1).
+ * @param timeUs Sample time (us).
+ * @param raw Raw TA register (MSB << 8 | LSB).
+ * @return MCP9808_Error_t A number lower than '0' if something was wrong.
+ */
+MCP9808_Error_t MCP9808_LogAppend( MCP9808_Log_Writer_t* writer, uint16_t sensor, uint64_t timeUs, uint16_t raw )
+{
+    MCP9808_Error_t error = MCP9808_ERROR;
+    MCP9808_Log_Stream_t* stream = NULL;
+    int16_t temperature = MCP9808_RegToQ4(raw);
+    uint8_t encoded[2U * 10U];
+    uint8_t size = 0;
+    int64_t delta = 0;
+
+    if( (writer != NULL) && (sensor < writer->nStreams) )
+    {
+        stream = &writer->streams[sensor];
+        writer->latestUs = (timeUs > writer->latestUs) ? timeUs : writer->latestUs;
+        error = MCP9808_OK;
+
+        if( stream->count != 0U )
+        {
+            delta = (int64_t)(timeUs - stream->lastTimeUs);
+            if( (timeUs >= stream->lastTimeUs) && ((uint64_t)delta <= MCP9808_LOG_DELTA_MAX) )
+            {
+                size = MCP9808_LogPutVarint(&encoded[0], delta - stream->lastDeltaUs);
+                size += MCP9808_LogPutVarint(&encoded[size], temperature - stream->lastTemperature);
+            }
+
+            if( (size == 0U) || ((stream->size + size) > MCP9808_LOG_BLOCK_SIZE) || (stream->count == UINT16_MAX) )
+            {
+                error = MCP9808_LogWriteBlock(writer, sensor);
+            }
+            else
+            {
+                memcpy(&stream->payload[stream->size], encoded, size);
+                stream->size += size;
+                stream->count++;
+                stream->lastDeltaUs = delta;
+                stream->lastTimeUs = timeUs;
+                stream->lastTemperature = temperature;
+            }
+        }
+
+        if( stream->count == 0U )
+        {
+            stream->count = 1U;
+            stream->size = 0U;
+            stream->firstTemperature = temperature;
+            stream->lastTemperature = temperature;
+            stream->firstTimeUs = timeUs;
+            stream->lastTimeUs = timeUs;
+            stream->lastDeltaUs = 0;
+        }
+    }
+
+    return error;
+}
+
+/**
+ * @brief Write every open block and flush the file. Call it before a
+ *        power loss is likely; it makes blocks shorter.
+ *
+ * @param writer Log writer.
+ * @return MCP9808_Error_t A number lower than '0' if something was wrong.
+ */
+MCP9808_Error_t MCP9808_LogFlush( MCP9808_Log_Writer_t* writer )
+{
+    MCP9808_Error_t error = MCP9808_ERROR;
+    uint16_t i = 0;
+
+    if( writer != NULL )
+    {
+        error = MCP9808_OK;
+        for( i = 0; (i < writer->nStreams) && !IS_MCP9808_ERROR(error); i++ )
+        {
+            error = MCP9808_LogWriteBlock(writer, i);
+        }
+        if( !IS_MCP9808_ERROR(error) && (fflush(writer->file) != 0) )
+        {
+            error = MCP9808_ERROR;
+        }
+    }
+
+    return error;
+}
+
+/**
+ * @brief Write the open blocks, the index footer and the trailer. The
+ *        file is not closed.
+ *
+ * @param writer Log writer.
+ * @return MCP9808_Error_t A number lower than '0' if something was wrong.
+ */
+MCP9808_Error_t MCP9808_LogWriterClose( MCP9808_Log_Writer_t* writer )
+{
+    MCP9808_Error_t error = MCP9808_LogFlush(writer);
+    uint8_t buffer[MCP9808_LOG_INDEX_ENTRY];
+    uint64_t indexOffset = 0;
+    uint32_t i = 0;
+
+    if( !IS_MCP9808_ERROR(error) )
+    {
+        indexOffset = writer->offset;
+        for( i = 0; (i < writer->indexCount) && !IS_MCP9808_ERROR(error); i++ )
+        {
+            MCP9808_LogPut(&buffer[0], writer->index[i].offset, 8U);
+            MCP9808_LogPut(&buffer[8], writer->index[i].keyUs, 8U);
+            error = MCP9808_LogWrite(writer, buffer, MCP9808_LOG_INDEX_ENTRY);
+        }
+    }
+
+    if( !IS_MCP9808_ERROR(error) )
+    {
+        MCP9808_LogPut(&buffer[0], indexOffset, 8U);
+        MCP9808_LogPut(&buffer[8], writer->indexCount, 4U);
+        memcpy(&buffer[12], MCP9808_LOG_IndexMagic, sizeof(MCP9808_LOG_IndexMagic));
+        error = MCP9808_LogWrite(writer, buffer, MCP9808_LOG_TRAILER_SIZE);
+    }
+
+    if( !IS_MCP9808_ERROR(error) && (fflush(writer->file) != 0) )
+    {
+        error = MCP9808_ERROR;
+    }
+
+    return error;
+}
+
+/**
+ * @brief Read bytes at a given offset.
+ *
+ * @param file Input file.
+ * @param offset File offset.
+ * @param data Output.
+ * @param size Number of bytes.
+ * @return MCP9808_Error_t A number lower than '0' if they could not be read.
+ */
+static MCP9808_Error_t MCP9808_LogReadAt( FILE* file, uint64_t offset, uint8_t* data, size_t size )
+{
+    MCP9808_Error_t error = MCP9808_ERROR;
+
+    if( (fseek(file, (long)offset, SEEK_SET) == 0) && (fread(data, 1, size, file) == size) )
+    {
+        error = MCP9808_OK;
+    }
+
+    return error;
+}
+
+/**
+ * @brief Open a log for reading. If the log has an index footer it is used
+ *        by MCP9808_LogSeek(); otherwise (log not closed) the blocks can
+ *        still be read up to the end of the file. Nothing is allocated.
+ *
+ * @param reader Log reader storage.
+ * @param file Input file, opened for binary reading.
+ * @return MCP9808_Error_t A number lower than '0' if something was wrong.
+ */
+MCP9808_Error_t MCP9808_LogReaderOpen( MCP9808_Log_Reader_t* reader, FILE* file )
+{
+    MCP9808_Error_t error = MCP9808_ERROR;
+    uint8_t buffer[MCP9808_LOG_TRAILER_SIZE];
+    uint64_t indexOffset = 0;
+    uint32_t count = 0;
+    long size = 0;
+
+    if( (reader != NULL) && (file != NULL) && (fseek(file, 0, SEEK_END) == 0) )
+    {
+        size = ftell(file);
+        error = (size >= (long)MCP9808_LOG_HEADER_SIZE) ?
+                MCP9808_LogReadAt(file, 0U, buffer, MCP9808_LOG_HEADER_SIZE) : MCP9808_ERROR;
+    }
+
+    if( !IS_MCP9808_ERROR(error) &&
+        ((memcmp(buffer, MCP9808_LOG_Magic, sizeof(MCP9808_LOG_Magic)) != 0) || (buffer[4] != MCP9808_LOG_VERSION)) )
+    {
+        error = MCP9808_ERROR;
+    }
+
+    if( !IS_MCP9808_ERROR(error) )
+    {
+        reader->file = file;
+        reader->position = MCP9808_LOG_HEADER_SIZE;
+        reader->end = (uint64_t)size;
+        reader->indexCount = 0U;
+
+        if( (size >= (long)(MCP9808_LOG_HEADER_SIZE + MCP9808_LOG_TRAILER_SIZE)) &&
+            !IS_MCP9808_ERROR(MCP9808_LogReadAt(file, (uint64_t)size - MCP9808_LOG_TRAILER_SIZE, buffer,
+                                                MCP9808_LOG_TRAILER_SIZE)) &&
+            (memcmp(&buffer[12], MCP9808_LOG_IndexMagic, sizeof(MCP9808_LOG_IndexMagic)) == 0) )
+        {
+            indexOffset = MCP9808_LogGet(&buffer[0], 8U);
+            count = (uint32_t)MCP9808_LogGet(&buffer[8], 4U);
+            if( (indexOffset + (uint64_t)count * MCP9808_LOG_INDEX_ENTRY + MCP9808_LOG_TRAILER_SIZE) ==
+                (uint64_t)size )
+            {
+                reader->end = indexOffset;
+                reader->indexCount = count;
+            }
+        }
+    }
+
+    return error;
+}
+
+/**
+ * @brief     Move the reader before the first block that can hold samples
+ *            taken at or after "timeUs" (binary search on the index, read
+ *            from the file). Following MCP9808_LogReadBlock() calls can
+ *            still return a few older samples; without index the reader
+ *            goes back to the first block.
+ *
+ * @param reader Log reader.
+ * @param timeUs Time to seek (us).
+ * @return MCP9808_Error_t A number lower than '0' if something was wrong.
+ */
+MCP9808_Error_t MCP9808_LogSeek( MCP9808_Log_Reader_t* reader, uint64_t timeUs )
+{
+    MCP9808_Error_t error = MCP9808_ERROR;
+    uint8_t entry[MCP9808_LOG_INDEX_ENTRY];
+    uint32_t low = 0;
+    uint32_t high = 0;
+    uint32_t middle = 0;
+
+    if( reader != NULL )
+    {
+        error = MCP9808_OK;
+        high = reader->indexCount;
+
+        /* First entry with key >= timeUs */
+        while( (low < high) && !IS_MCP9808_ERROR(error) )
+        {
+            middle = low + (high - low) / 2U;
+            error = MCP9808_LogReadAt(reader->file, reader->end + (uint64_t)middle * MCP9808_LOG_INDEX_ENTRY,
+                                      entry, MCP9808_LOG_INDEX_ENTRY);
+            if( MCP9808_LogGet(&entry[8], 8U) < timeUs )
+            {
+                low = middle + 1U;
+            }
+            else
+            {
+                high = middle;
+            }
+        }
+
+        /* Blocks between the previous entry and this one are not indexed */
+        reader->position = MCP9808_LOG_HEADER_SIZE;
+        if( !IS_MCP9808_ERROR(error) && (low > 0U) )
+        {
+            error = MCP9808_LogReadAt(reader->file, reader->end + (uint64_t)(low - 1U) * MCP9808_LOG_INDEX_ENTRY,
+                                      entry, MCP9808_LOG_INDEX_ENTRY);
+            reader->position = MCP9808_LogGet(&entry[0], 8U);
+        }
+    }
+
+    return error;
+}
+
+/**
+ * @brief Read the next block (any sensor) into "block".
+ *
+ * @param reader Log reader.
+ * @param block Block storage.
+ * @return MCP9808_Error_t MCP9808_LOG_END after the last block, a number lower than '0' if something was wrong.
+ */
+MCP9808_Error_t MCP9808_LogReadBlock( MCP9808_Log_Reader_t* reader, MCP9808_Log_Block_t* block )
+{
+    MCP9808_Error_t error = MCP9808_ERROR;
+    uint8_t header[MCP9808_LOG_BLOCK_HEADER];
+
+    if( (reader != NULL) && (block != NULL) )
+    {
+        error = MCP9808_LOG_END;
+        if( ((reader->position + MCP9808_LOG_BLOCK_HEADER) <= reader->end) &&
+            !IS_MCP9808_ERROR(MCP9808_LogReadAt(reader->file, reader->position, header, sizeof(header))) )
+        {
+            block->sensor = (uint16_t)MCP9808_LogGet(&header[0], 2U);
+            block->count = (uint16_t)MCP9808_LogGet(&header[2], 2U);
+            block->size = (uint16_t)MCP9808_LogGet(&header[4], 2U);
+            block->temperature = (int16_t)MCP9808_LogGet(&header[6], 2U);
+            block->timeUs = MCP9808_LogGet(&header[8], 8U);
+
+            if( (block->count == 0U) || (block->size > MCP9808_LOG_BLOCK_SIZE) )
+            {
+                error = MCP9808_ERROR;
+            }
+            else if( ((reader->position + MCP9808_LOG_BLOCK_HEADER + block->size) <= reader->end) &&
+                     (fread(block->payload, 1, block->size, reader->file) == block->size) )
+            {
+                reader->position += MCP9808_LOG_BLOCK_HEADER + block->size;
+                error = MCP9808_OK;
+            }
+        }
+    }
+
+    return error;
+}
+
+/**
+ * @brief Decode the samples of a block.
+ *
+ * @param block Block read by MCP9808_LogReadBlock().
+ * @param samples Output, at least block->count entries (MCP9808_LOG_BLOCK_SAMPLES is always enough).
+ * @param max Output capacity.
+ * @param n Number of samples decoded.
+ * @return MCP9808_Error_t A number lower than '0' if something was wrong.
+ */
+MCP9808_Error_t MCP9808_LogDecode( const MCP9808_Log_Block_t* block, MCP9808_Log_Sample_t* samples, size_t max,
+                                   size_t* n )
+{
+    MCP9808_Error_t error = MCP9808_ERROR;
+    uint16_t position = 0;
+    uint16_t i = 0;
+    int64_t deltaUs = 0;
+    int64_t value = 0;
+    int64_t temperature = 0;
+    uint64_t timeUs = 0;
+
+    if( (block != NULL) && (samples != NULL) && (n != NULL) && (block->count != 0U) && (block->count <= max) )
+    {
+        timeUs = block->timeUs;
+        temperature = block->temperature;
+        samples[0].timeUs = timeUs;
+        samples[0].temperature = (int16_t)temperature;
+        error = MCP9808_OK;
+
+        for( i = 1; (i < block->count) && !IS_MCP9808_ERROR(error); i++ )
+        {
+            error = MCP9808_LogGetVarint(block->payload, block->size, &position, &value);
+            deltaUs += value;
+            timeUs += (uint64_t)deltaUs;
+            if( !IS_MCP9808_ERROR(error) )
+            {
+                error = MCP9808_LogGetVarint(block->payload, block->size, &position, &value);
+            }
+            temperature += value;
+            samples[i].timeUs = timeUs;
+            samples[i].temperature = (int16_t)temperature;
+        }
+
+        if( position != block->size )
+        {
+            error = MCP9808_ERROR;
+        }
+        *n = IS_MCP9808_ERROR(error) ? 0U : block->count;
+    }
+
+    return error;
+}
@@ -0,0 +1,166 @@
+/**                             _____________
+ *              /\      /\     /             \
+ *             //\\____//\\   |   MAUUUU!!    |
+ *            /     '      \   \  ___________/
+ *           /   /\ '  /\    \ /_/                  / /  ___    / __\ |__   __ _| |_
+ *          |    == o ==      |       /|         / /  / _ \  / /  | '_ \ / _` | __|
+ *           \      '        /       | |        / /__|  __/ / /___| | | | (_| | |_
+ *             \           /         \ \        \____/\___| \____/|_| |_|\__,_|\__|
+ *             /----<o>---- \         / /
+ *             |            ' \       \ \
+ *             |    |    | '   '\      \ \
+ *  _________  | ´´ |  ' |     '  \    / /
+ *  |  MAYA  | |  ' |    | '       |__/ /
+ *   \______/   \__/ \__/ \_______/____/
+ * @file MCP9808_log.h
+ * @author Alejandro Gomez Molina (@Alejo2312)
+ * @brief Compact binary log of temperature samples.
+ * @version 0.1
+ * @date Mar 22, 2022
+ * 
+ * @copyright Copyright (c) 2022
+ * 
+ */
+#ifndef DRIVERS_INC_MCP9808_LOG_H_
+#define DRIVERS_INC_MCP9808_LOG_H_
+
+
+/************************************************************************
+    INCLUDES
+************************************************************************/
+#include <stdio.h>
+#include "MCP9808.h"
+
+/************************************************************************
+    DEFINES AND TYPES
+************************************************************************/
+
+/** Block payload size (bytes). A sensor block is written when it is full. */
+#ifndef MCP9808_LOG_BLOCK_SIZE
+#define MCP9808_LOG_BLOCK_SIZE      256U
+#endif /* MCP9808_LOG_BLOCK_SIZE */
+
+#define MCP9808_LOG_VERSION         1U
+#define MCP9808_LOG_HEADER_SIZE     8U      /**< "MCPL", version, reserved */
+#define MCP9808_LOG_BLOCK_HEADER    16U     /**< Sensor, count, size, temperature, time */
+#define MCP9808_LOG_INDEX_ENTRY     16U     /**< Block offset, time key */
+#define MCP9808_LOG_TRAILER_SIZE    16U     /**< Index offset, entries, "MCPI" */
+#define MCP9808_LOG_SAMPLE_MAX      7U      /**< Worst case encoded sample (5 + 2 bytes) */
+#define MCP9808_LOG_BLOCK_SAMPLES   (MCP9808_LOG_BLOCK_SIZE / 2U + 1U) /**< Most samples in a block */
+
+#define MCP9808_LOG_END             1       /**< No more blocks (MCP9808_LogReadBlock()) */
+
+/** Decoded sample */
+typedef struct
+{
+    uint64_t    timeUs;         /**< Sample time (us) */
+    int16_t     temperature;    /**< Temperature (1/16 °C) */
+}MCP9808_Log_Sample_t;
+
+/** Open block of a sensor (writer side) */
+typedef struct
+{
+    uint16_t    count;              /**< Samples in the block (0 if not open) */
+    uint16_t    size;               /**< Payload bytes used */
+    int16_t     firstTemperature;   /**< First sample temperature (1/16 °C) */
+    int16_t     lastTemperature;    /**< Last sample temperature (1/16 °C) */
+    uint64_t    firstTimeUs;        /**< First sample time (us) */
+    uint64_t    lastTimeUs;         /**< Last sample time (us) */
+    int64_t     lastDeltaUs;        /**< Last time delta (us) */
+    uint8_t     payload[MCP9808_LOG_BLOCK_SIZE]; /**< Encoded samples */
+}MCP9808_Log_Stream_t;
+
+/** Block index entry (writer side) */
+typedef struct
+{
+    uint64_t    offset;         /**< Block offset in the file */
+    uint64_t    keyUs;          /**< Latest sample time written when the block was flushed */
+}MCP9808_Log_Index_t;
+
+/**
+ * Log writer. Memory is bounded by the storage given to
+ * MCP9808_LogWriterOpen(): one open block per sensor and a fixed size index
+ * (when full, every other entry is dropped).
+ */
+typedef struct
+{
+    FILE*                   file;       /**< Output file */
+    uint64_t                offset;     /**< Current file offset */
+    uint64_t                latestUs;   /**< Latest sample time seen */
+    MCP9808_Log_Stream_t*   streams;    /**< Open blocks, one per sensor */
+    uint16_t                nStreams;   /**< Number of sensors */
+    MCP9808_Log_Index_t*    index;      /**< Index storage */
+    uint32_t                indexMax;   /**< Index capacity */
+    uint32_t                indexCount; /**< Index entries used */
+    uint32_t                stride;     /**< Blocks per index entry */
+    uint32_t                blocks;     /**< Blocks written */
+}MCP9808_Log_Writer_t;
+
+/** Block read by MCP9808_LogReadBlock() */
+typedef struct
+{
+    uint16_t    sensor;         /**< Sensor number given to MCP9808_LogAppend() */
+    uint16_t    count;          /**< Number of samples */
+    uint16_t    size;           /**< Payload bytes */
+    int16_t     temperature;    /**< First sample temperature (1/16 °C) */
+    uint64_t    timeUs;         /**< First sample time (us) */
+    uint8_t     payload[MCP9808_LOG_BLOCK_SIZE]; /**< Encoded samples */
+}MCP9808_Log_Block_t;
+
+/** Log reader */
+typedef struct
+{
+    FILE*       file;           /**< Input file */
+    uint64_t    position;       /**< Next block offset */
+    uint64_t    end;            /**< End of the blocks (index offset or file size) */
+    uint32_t    indexCount;     /**< Index entries (0 if the log was not closed) */
+}MCP9808_Log_Reader_t;
+
+/************************************************************************
+    FUNCTIONS
+************************************************************************/
+
+/**
+  See "MCP9808_log.c" for details of how to use this function.
+ */
+MCP9808_Error_t MCP9808_LogWriterOpen( MCP9808_Log_Writer_t* writer, FILE* file, MCP9808_Log_Stream_t* streams,
+                                       uint16_t nStreams, MCP9808_Log_Index_t* index, uint32_t indexMax );
+
+/**
+  See "MCP9808_log.c" for details of how to use this function.
+ */
+MCP9808_Error_t MCP9808_LogAppend( MCP9808_Log_Writer_t* writer, uint16_t sensor, uint64_t timeUs, uint16_t raw );
+
+/**
+  See "MCP9808_log.c" for details of how to use this function.
+ */
+MCP9808_Error_t MCP9808_LogFlush( MCP9808_Log_Writer_t* writer );
+
+/**
+  See "MCP9808_log.c" for details of how to use this function.
+ */
+MCP9808_Error_t MCP9808_LogWriterClose( MCP9808_Log_Writer_t* writer );
+
+/**
+  See "MCP9808_log.c" for details of how to use this function.
+ */
+MCP9808_Error_t MCP9808_LogReaderOpen( MCP9808_Log_Reader_t* reader, FILE* file );
+
+/**
+  See "MCP9808_log.c" for details of how to use this function.
+ */
+MCP9808_Error_t MCP9808_LogSeek( MCP9808_Log_Reader_t* reader, uint64_t timeUs );
+
+/**
+  See "MCP9808_log.c" for details of how to use this function.
+ */
+MCP9808_Error_t MCP9808_LogReadBlock( MCP9808_Log_Reader_t* reader, MCP9808_Log_Block_t* block );
+
+/**
+  See "MCP9808_log.c" for details of how to use this function.
+ */
+MCP9808_Error_t MCP9808_LogDecode( const MCP9808_Log_Block_t* block, MCP9808_Log_Sample_t* samples, size_t max,
+                                   size_t* n );
+
+
+#endif /* DRIVERS_INC_MCP9808_LOG_H_ */
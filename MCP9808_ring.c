@@ -0,0 +1,207 @@
+/**                             _____________
+ *              /\      /\     /             \
+ *             //\\____//\\   |   MAUUUU!!    |
+ *            /     '      \   \  ___________/
+ *           /   /\ '  /\    \ /_/                  / /  ___    / __\ |__   __ _| |_
+ *          |    == o ==      |       /|         / /  / _ \  / /  | '_ \ / _` | __|
+ *           \      '        /       | |        / /__|  __/ / /___| | | | (_| | |_
+ *             \           /         \ \        \____/\___| \____/|_| |_|\__,_|\__|
+ *             /----<o>---- \         / /
+ *             |            ' \       \ \
+ *             |    |    | '   '\      \ \
+ *  _________  | ´´ |  ' |     '  \    / /
+ *  |  MAYA  | |  ' |    | '       |__/ /
+ *   \______/   \__/ \__/ \_______/____/
+ * @file MCP9808_ring.c
+ * @author Alejandro Gomez Molina (@Alejo2312)
+ * @brief Lock-free single-producer/single-consumer sample queue. The
+ *        producer (I2C completion ISR, acquisition thread) only writes
+ *        "head", the consumer only writes "tail"; each side keeps a
+ *        private copy of the other index and reloads it only when the
+ *        ring looks full (producer) or empty (consumer).
+ * @version 0.1
+ * @date Mar 22, 2022
+ * 
+ * @copyright Copyright (c) 2022
+ * 
+ */
+
+/************************************************************************
+    INCLUDES
+************************************************************************/
+#include <string.h>
+#include "MCP9808_ring.h"
+
+/************************************************************************
+    FUNCTIONS
+************************************************************************/
+
+/**
+ * @brief Initialize an empty ring.
+ *
+ * @param ring Ring storage.
+ * @param buffer Sample storage, "capacity" entries.
+ * @param capacity Number of samples, power of two.
+ * @return MCP9808_Error_t A number lower than '0' if something was wrong.
+ */
+MCP9808_Error_t MCP9808_RingInit( MCP9808_Ring_t* ring, MCP9808_Sample_t* buffer, uint32_t capacity )
+{
+    MCP9808_Error_t error = MCP9808_ERROR;
+
+    if( (ring != NULL) && (buffer != NULL) && (capacity != 0U) && ((capacity & (capacity - 1U)) == 0U) )
+    {
+        atomic_init(&ring->head, 0U);
+        atomic_init(&ring->tail, 0U);
+        atomic_init(&ring->dropped, 0U);
+        ring->tailCache = 0U;
+        ring->headCache = 0U;
+        ring->buffer = buffer;
+        ring->mask = capacity - 1U;
+        error = MCP9808_OK;
+    }
+
+    return error;
+}
+
+/**
+ * @brief Push a sample (producer side). If the ring is full the sample is
+ *        dropped and counted, older samples are kept.
+ *
+ * @param ring Ring.
+ * @param sample Sample to push.
+ * @return MCP9808_Error_t A number lower than '0' if the ring was full.
+ */
+MCP9808_Error_t MCP9808_RingPush( MCP9808_Ring_t* ring, const MCP9808_Sample_t* sample )
+{
+    MCP9808_Error_t error = MCP9808_ERROR;
+    uint32_t head = 0;
+
+    if( (ring != NULL) && (sample != NULL) )
+    {
+        head = (uint32_t)atomic_load_explicit(&ring->head, memory_order_relaxed);
+
+        if( (head - ring->tailCache) > ring->mask )
+        {
+            ring->tailCache = (uint32_t)atomic_load_explicit(&ring->tail, memory_order_acquire);
+        }
+
+        if( (head - ring->tailCache) <= ring->mask )
+        {
+            ring->buffer[head & ring->mask] = *sample;
+            atomic_store_explicit(&ring->head, head + 1U, memory_order_release);
+            error = MCP9808_OK;
+        }
+        else
+        {
+            /* Only the producer writes it: no read-modify-write (libatomic on Cortex-M0) */
+            atomic_store_explicit(&ring->dropped,
+                                  atomic_load_explicit(&ring->dropped, memory_order_relaxed) + 1U,
+                                  memory_order_relaxed);
+        }
+    }
+
+    return error;
+}
+
+/**
+ * @brief Decode and push a raw TA register (producer side), e.g. from a
+ *        MCP9808_ReadTemperatureAsync() completion callback.
+ *
+ * @param ring Ring.
+ * @param timeUs Sample time (us).
+ * @param address Device I2C address.
+ * @param raw Raw TA register (MSB << 8 | LSB).
+ * @return MCP9808_Error_t A number lower than '0' if the ring was full.
+ */
+MCP9808_Error_t MCP9808_RingPushRaw( MCP9808_Ring_t* ring, uint32_t timeUs, uint8_t address, uint16_t raw )
+{
+    MCP9808_Sample_t sample;
+
+    sample.timeUs = timeUs;
+    sample.raw = raw;
+    sample.temperature = MCP9808_RegToQ4(raw);
+    sample.address = address;
+
+    return MCP9808_RingPush(ring, &sample);
+}
+
+/**
+ * @brief Pop up to "max" samples (consumer side), oldest first.
+ *
+ * @param ring Ring.
+ * @param samples Samples storage.
+ * @param max Maximum number of samples to pop.
+ * @return size_t Number of samples popped.
+ */
+size_t MCP9808_RingPop( MCP9808_Ring_t* ring, MCP9808_Sample_t* samples, size_t max )
+{
+    size_t count = 0;
+    size_t first = 0;
+    uint32_t tail = 0;
+    uint32_t index = 0;
+
+    if( (ring != NULL) && (samples != NULL) )
+    {
+        tail = (uint32_t)atomic_load_explicit(&ring->tail, memory_order_relaxed);
+
+        if( (uint32_t)(ring->headCache - tail) < max )
+        {
+            ring->headCache = (uint32_t)atomic_load_explicit(&ring->head, memory_order_acquire);
+        }
+
+        count = ring->headCache - tail;
+        count = (count < max) ? count : max;
+
+        if( count > 0U )
+        {
+            /* Up to two copies: end of the buffer, then its start */
+            index = tail & ring->mask;
+            first = ((ring->mask + 1U) - index);
+            first = (first < count) ? first : count;
+            memcpy(samples, &ring->buffer[index], first * sizeof(*samples));
+            memcpy(&samples[first], ring->buffer, (count - first) * sizeof(*samples));
+
+            atomic_store_explicit(&ring->tail, tail + (uint32_t)count, memory_order_release);
+        }
+    }
+
+    return count;
+}
+
+/**
+ * @brief Get the number of samples waiting. It is a snapshot: the
+ *        producer may have pushed more by the time it is used.
+ *
+ * @param ring Ring.
+ * @return uint32_t Number of samples in the ring.
+ */
+uint32_t MCP9808_RingCount( MCP9808_Ring_t* ring )
+{
+    uint32_t count = 0;
+
+    if( ring != NULL )
+    {
+        count = (uint32_t)atomic_load_explicit(&ring->head, memory_order_acquire) -
+                (uint32_t)atomic_load_explicit(&ring->tail, memory_order_acquire);
+    }
+
+    return count;
+}
+
+/**
+ * @brief Get the number of samples dropped because the ring was full.
+ *
+ * @param ring Ring.
+ * @return uint32_t Dropped samples since init.
+ */
+uint32_t MCP9808_RingDropped( MCP9808_Ring_t* ring )
+{
+    uint32_t dropped = 0;
+
+    if( ring != NULL )
+    {
+        dropped = (uint32_t)atomic_load_explicit(&ring->dropped, memory_order_relaxed);
+    }
+
+    return dropped;
+}
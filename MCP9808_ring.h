@@ -0,0 +1,108 @@
+/**                             _____________
+ *              /\      /\     /             \
+ *             //\\____//\\   |   MAUUUU!!    |
+ *            /     '      \   \  ___________/
+ *           /   /\ '  /\    \ /_/                  / /  ___    / __\ |__   __ _| |_
+ *          |    == o ==      |       /|         / /  / _ \  / /  | '_ \ / _` | __|
+ *           \      '        /       | |        / /__|  __/ / /___| | | | (_| | |_
+ *             \           /         \ \        \____/\___| \____/|_| |_|\__,_|\__|
+ *             /----<o>---- \         / /
+ *             |            ' \       \ \
+ *             |    |    | '   '\      \ \
+ *  _________  | ´´ |  ' |     '  \    / /
+ *  |  MAYA  | |  ' |    | '       |__/ /
+ *   \______/   \__/ \__/ \_______/____/
+ * @file MCP9808_ring.h
+ * @author Alejandro Gomez Molina (@Alejo2312)
+ * @brief Lock-free single-producer/single-consumer sample queue.
+ * @version 0.1
+ * @date Mar 22, 2022
+ * 
+ * @copyright Copyright (c) 2022
+ * 
+ */
+#ifndef DRIVERS_INC_MCP9808_RING_H_
+#define DRIVERS_INC_MCP9808_RING_H_
+
+
+/************************************************************************
+    INCLUDES
+************************************************************************/
+#include <stdatomic.h>
+#include "MCP9808.h"
+
+/************************************************************************
+    DEFINES AND TYPES
+************************************************************************/
+
+/** Producer and consumer indexes are kept on different cache lines */
+#ifndef MCP9808_RING_CACHE_LINE
+#define MCP9808_RING_CACHE_LINE 64U
+#endif /* MCP9808_RING_CACHE_LINE */
+
+/** Timestamped temperature sample */
+typedef struct
+{
+    uint32_t    timeUs;         /**< Sample time (us) */
+    uint16_t    raw;            /**< Raw TA register (MSB << 8 | LSB), alert flags included */
+    int16_t     temperature;    /**< Temperature (1/16 °C) */
+    uint8_t     address;        /**< Device I2C address */
+}MCP9808_Sample_t;
+
+/**
+ * Single-producer/single-consumer ring. One context (ISR or thread) pushes,
+ * another one pops; no lock is taken on either side. Indexes are free
+ * running and the capacity is a power of two.
+ */
+typedef struct
+{
+    /* Producer side */
+    _Alignas(MCP9808_RING_CACHE_LINE) atomic_uint_fast32_t head;   /**< Next slot to write */
+    uint32_t                        tailCache;  /**< Producer copy of tail */
+    atomic_uint_fast32_t            dropped;    /**< Samples lost because the ring was full (written by the producer only) */
+
+    /* Consumer side */
+    _Alignas(MCP9808_RING_CACHE_LINE) atomic_uint_fast32_t tail;   /**< Next slot to read */
+    uint32_t                        headCache;  /**< Consumer copy of head */
+
+    /* Read only after init */
+    _Alignas(MCP9808_RING_CACHE_LINE) MCP9808_Sample_t* buffer;    /**< Sample storage */
+    uint32_t                        mask;       /**< Capacity - 1 */
+}MCP9808_Ring_t;
+
+/************************************************************************
+    FUNCTIONS
+************************************************************************/
+
+/**
+  See "MCP9808_ring.c" for details of how to use this function.
+ */
+MCP9808_Error_t MCP9808_RingInit( MCP9808_Ring_t* ring, MCP9808_Sample_t* buffer, uint32_t capacity );
+
+/**
+  See "MCP9808_ring.c" for details of how to use this function.
+ */
+MCP9808_Error_t MCP9808_RingPush( MCP9808_Ring_t* ring, const MCP9808_Sample_t* sample );
+
+/**
+  See "MCP9808_ring.c" for details of how to use this function.
+ */
+MCP9808_Error_t MCP9808_RingPushRaw( MCP9808_Ring_t* ring, uint32_t timeUs, uint8_t address, uint16_t raw );
+
+/**
+  See "MCP9808_ring.c" for details of how to use this function.
+ */
+size_t MCP9808_RingPop( MCP9808_Ring_t* ring, MCP9808_Sample_t* samples, size_t max );
+
+/**
+  See "MCP9808_ring.c" for details of how to use this function.
+ */
+uint32_t MCP9808_RingCount( MCP9808_Ring_t* ring );
+
+/**
+  See "MCP9808_ring.c" for details of how to use this function.
+ */
+uint32_t MCP9808_RingDropped( MCP9808_Ring_t* ring );
+
+
+#endif /* DRIVERS_INC_MCP9808_RING_H_ */
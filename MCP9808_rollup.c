@@ -0,0 +1,368 @@
+/**                             _____________
+ *              /\      /\     /             \
+ *             //\\____//\\   |   MAUUUU!!    |
+ *            /     '      \   \  ___________/
+ *           /   /\ '  /\    \ /_/                  / /  ___    / __\ |__   __ _| |_
+ *          |    == o ==      |       /|         / /  / _ \  / /  | '_ \ / _` | __|
+ *           \      '        /       | |        / /__|  __/ / /___| | | | (_| | |_
+ *             \           /         \ \        \____/\___| \____/|_| |_|\__,_|\__|
+ *             /----<o>---- \         / /
+ *             |            ' \       \ \
+ *             |    |    | '   '\      \ \
+ *  _________  | ´´ |  ' |     '  \    / /
+ *  |  MAYA  | |  ' |    | '       |__/ /
+ *   \______/   \__/ \__/ \_______/____/
+ * @file MCP9808_rollup.c
+ * @author Alejandro Gomez Molina (@Alejo2312)
+ * @brief Incremental per-sensor statistics and multi-resolution rollups.
+ *        Samples are accumulated in 1/16 °C units (the TA LSB) as exact
+ *        integer sums (count, sum, sum of squares, min, max): updates are
+ *        O(1), no rounding error builds up and windows merge by adding
+ *        their sums. Each level closes its window on the period boundary
+ *        and merges it into the next (coarser) level, so 1 s, 1 min and
+ *        1 h rollups never scan stored samples.
+ * @version 0.1
+ * @date Mar 22, 2022
+ * 
+ * @copyright Copyright (c) 2022
+ * 
+ */
+
+/************************************************************************
+    INCLUDES
+************************************************************************/
+#include <string.h>
+#include "MCP9808_rollup.h"
+
+/************************************************************************
+    FUNCTIONS
+************************************************************************/
+
+/**
+ * @brief Get the start of the window holding a time.
+ *
+ * @param level Rollup level.
+ * @param timeUs Time (us).
+ * @return uint64_t Window start (us).
+ */
+static uint64_t MCP9808_RollupAlign( const MCP9808_Rollup_Level_t* level, uint64_t timeUs )
+{
+    return (timeUs / level->periodUs) * level->periodUs;
+}
+
+/**
+ * @brief Close the open window of a level: store it in the level history
+ *        and merge it into the next level.
+ *
+ * @param rollup Rollup.
+ * @param index Level index.
+ */
+static void MCP9808_RollupClose( MCP9808_Rollup_t* rollup, uint8_t index )
+{
+    MCP9808_Rollup_Level_t* level = &rollup->levels[index];
+    MCP9808_Rollup_Level_t* parent = NULL;
+    uint64_t startUs = 0;
+
+    if( rollup->depth != 0U )
+    {
+        level->history[level->next] = level->current;
+        level->next = (uint16_t)((level->next + 1U) % rollup->depth);
+        level->count = (level->count < rollup->depth) ? (uint16_t)(level->count + 1U) : level->count;
+    }
+
+    if( (index + 1U) < rollup->nLevels )
+    {
+        parent = &rollup->levels[index + 1U];
+        startUs = MCP9808_RollupAlign(parent, level->current.startUs);
+
+        /* Time went backwards: the parent window does not match anymore */
+        if( (parent->current.stats.count != 0U) && (parent->current.startUs != startUs) )
+        {
+            MCP9808_RollupClose(rollup, (uint8_t)(index + 1U));
+        }
+        if( parent->current.stats.count == 0U )
+        {
+            parent->current.startUs = startUs;
+        }
+        MCP9808_RollupMerge(&parent->current.stats, &level->current.stats);
+    }
+
+    level->current.stats.count = 0U;
+}
+
+/**
+ * @brief     Initialize a rollup. Each period must be a multiple of the
+ *            previous one (e.g. 1 s, 60 s, 3600 s). Memory use is fixed:
+ *            "depth" closed windows are kept per level in "history".
+ *
+ * @param rollup Rollup storage.
+ * @param periodsUs Window length of each level (us), finest first.
+ * @param nLevels Number of levels (up to MCP9808_ROLLUP_LEVELS).
+ * @param history Closed windows storage, nLevels * depth entries (can be NULL if depth is 0).
+ * @param depth Closed windows kept per level.
+ * @return MCP9808_Error_t A number lower than '0' if something was wrong.
+ */
+MCP9808_Error_t MCP9808_RollupInit( MCP9808_Rollup_t* rollup, const uint64_t* periodsUs, uint8_t nLevels,
+                                    MCP9808_Rollup_Window_t* history, uint16_t depth )
+{
+    MCP9808_Error_t error = MCP9808_ERROR;
+    uint8_t i = 0;
+
+    if( (rollup != NULL) && (periodsUs != NULL) && (nLevels != 0U) && (nLevels <= MCP9808_ROLLUP_LEVELS) &&
+        ((history != NULL) || (depth == 0U)) )
+    {
+        error = MCP9808_OK;
+        for( i = 0; (i < nLevels) && !IS_MCP9808_ERROR(error); i++ )
+        {
+            if( (periodsUs[i] == 0U) || ((i > 0U) && ((periodsUs[i] % periodsUs[i - 1U]) != 0U)) )
+            {
+                error = MCP9808_ERROR;
+            }
+        }
+    }
+
+    if( !IS_MCP9808_ERROR(error) )
+    {
+        memset(rollup, 0, sizeof(*rollup));
+        rollup->nLevels = nLevels;
+        rollup->depth = depth;
+        for( i = 0; i < nLevels; i++ )
+        {
+            rollup->levels[i].periodUs = periodsUs[i];
+            rollup->levels[i].history = (history != NULL) ? &history[(size_t)i * depth] : NULL;
+        }
+    }
+
+    return error;
+}
+
+/**
+ * @brief Add a sample (e.g. a MCP9808_ReadTemperatureQ4() result). Windows
+ *        whose period ended are closed first.
+ *
+ * @param rollup Rollup.
+ * @param timeUs Sample time (us).
+ * @param temperature Temperature (1/16 °C).
+ * @return MCP9808_Error_t A number lower than '0' if something was wrong.
+ */
+MCP9808_Error_t MCP9808_RollupAdd( MCP9808_Rollup_t* rollup, uint64_t timeUs, int16_t temperature )
+{
+    MCP9808_Error_t error = MCP9808_ERROR;
+    MCP9808_Rollup_Stats_t* stats = NULL;
+    uint8_t i = 0;
+
+    if( rollup != NULL )
+    {
+        for( i = 0; i < rollup->nLevels; i++ )
+        {
+            if( (rollup->levels[i].current.stats.count != 0U) &&
+                (rollup->levels[i].current.startUs != MCP9808_RollupAlign(&rollup->levels[i], timeUs)) )
+            {
+                MCP9808_RollupClose(rollup, i);
+            }
+        }
+
+        stats = &rollup->levels[0].current.stats;
+        if( stats->count == 0U )
+        {
+            rollup->levels[0].current.startUs = MCP9808_RollupAlign(&rollup->levels[0], timeUs);
+            stats->min = temperature;
+            stats->max = temperature;
+            stats->sum = 0;
+            stats->sumSq = 0U;
+        }
+        stats->count++;
+        stats->min = (temperature < stats->min) ? temperature : stats->min;
+        stats->max = (temperature > stats->max) ? temperature : stats->max;
+        stats->sum += temperature;
+        stats->sumSq += (uint64_t)((int32_t)temperature * temperature);
+        error = MCP9808_OK;
+    }
+
+    return error;
+}
+
+/**
+ * @brief Get a closed window.
+ *
+ * @param rollup Rollup.
+ * @param level Level index (0 is the finest).
+ * @param age 0 for the last closed window, 1 for the one before...
+ * @param window Window storage.
+ * @return MCP9808_Error_t A number lower than '0' if the window is not kept.
+ */
+MCP9808_Error_t MCP9808_RollupGet( const MCP9808_Rollup_t* rollup, uint8_t level, uint16_t age,
+                                   MCP9808_Rollup_Window_t* window )
+{
+    MCP9808_Error_t error = MCP9808_ERROR;
+    const MCP9808_Rollup_Level_t* entry = NULL;
+
+    if( (rollup != NULL) && (window != NULL) && (level < rollup->nLevels) &&
+        (age < rollup->levels[level].count) )
+    {
+        entry = &rollup->levels[level];
+        *window = entry->history[(entry->next + rollup->depth - 1U - age) % rollup->depth];
+        error = MCP9808_OK;
+    }
+
+    return error;
+}
+
+/**
+ * @brief Get the open window of a level, including the samples still in
+ *        the open windows of the finer levels.
+ *
+ * @param rollup Rollup.
+ * @param level Level index (0 is the finest).
+ * @param window Window storage (count is 0 if there is no sample yet).
+ * @return MCP9808_Error_t A number lower than '0' if something was wrong.
+ */
+MCP9808_Error_t MCP9808_RollupCurrent( const MCP9808_Rollup_t* rollup, uint8_t level,
+                                       MCP9808_Rollup_Window_t* window )
+{
+    MCP9808_Error_t error = MCP9808_ERROR;
+    uint8_t i = 0;
+
+    if( (rollup != NULL) && (window != NULL) && (level < rollup->nLevels) )
+    {
+        memset(window, 0, sizeof(*window));
+        for( i = 0; i <= level; i++ )
+        {
+            if( (rollup->levels[i].current.stats.count != 0U) && (window->stats.count == 0U) )
+            {
+                window->startUs = MCP9808_RollupAlign(&rollup->levels[level], rollup->levels[i].current.startUs);
+            }
+            MCP9808_RollupMerge(&window->stats, &rollup->levels[i].current.stats);
+        }
+        error = MCP9808_OK;
+    }
+
+    return error;
+}
+
+/**
+ * @brief Merge statistics (e.g. the same window of several sensors).
+ *
+ * @param stats Statistics updated.
+ * @param other Statistics to add.
+ */
+void MCP9808_RollupMerge( MCP9808_Rollup_Stats_t* stats, const MCP9808_Rollup_Stats_t* other )
+{
+    if( (stats != NULL) && (other != NULL) && (other->count != 0U) )
+    {
+        if( stats->count == 0U )
+        {
+            *stats = *other;
+        }
+        else
+        {
+            stats->count += other->count;
+            stats->min = (other->min < stats->min) ? other->min : stats->min;
+            stats->max = (other->max > stats->max) ? other->max : stats->max;
+            stats->sum += other->sum;
+            stats->sumSq += other->sumSq;
+        }
+    }
+}
+
+/**
+ * @brief Integer square root, rounded to nearest.
+ *
+ * @param value Value.
+ * @return uint32_t Square root.
+ */
+static uint32_t MCP9808_RollupSqrt( uint64_t value )
+{
+    uint64_t root = 0;
+    uint64_t bit = 1ULL << 62;
+
+    while( bit > value )
+    {
+        bit >>= 2;
+    }
+    while( bit != 0U )
+    {
+        if( value >= (root + bit) )
+        {
+            value -= root + bit;
+            root = (root >> 1) + bit;
+        }
+        else
+        {
+            root >>= 1;
+        }
+        bit >>= 2;
+    }
+
+    return (uint32_t)((value > root) ? (root + 1U) : root);
+}
+
+/**
+ * @brief Floor division by a positive divisor.
+ *
+ * @param value Dividend.
+ * @param divisor Divisor (> 0).
+ * @return int64_t Largest integer not above value / divisor.
+ */
+static int64_t MCP9808_RollupFloorDiv( int64_t value, int64_t divisor )
+{
+    return (value >= 0) ? (value / divisor) : -((-value + divisor - 1) / divisor);
+}
+
+/**
+ * @brief     Get min, max, mean and sample standard deviation. The mean and
+ *            the deviation are given in 1/256 °C, rounded. The variance is
+ *            computed exactly from the integer sums, for any number of
+ *            samples: no intermediate value leaves 64 bits.
+ *
+ * @param stats Statistics.
+ * @param summary Summary storage.
+ * @return MCP9808_Error_t A number lower than '0' if there are no samples.
+ */
+MCP9808_Error_t MCP9808_RollupSummary( const MCP9808_Rollup_Stats_t* stats, MCP9808_Rollup_Summary_t* summary )
+{
+    MCP9808_Error_t error = MCP9808_ERROR;
+    int64_t n = 0;
+    int64_t scaled = 0;
+    int64_t quotient = 0;
+    int64_t remainder = 0;
+    int64_t centred = 0;
+    int64_t inner = 0;
+    uint64_t square = 0;
+    uint64_t correction = 0;
+    bool fraction = false;
+
+    if( (stats != NULL) && (summary != NULL) && (stats->count != 0U) )
+    {
+        n = stats->count;
+        scaled = stats->sum * 16;
+        summary->count = stats->count;
+        summary->min = stats->min;
+        summary->max = stats->max;
+        summary->mean = (int32_t)((scaled >= 0) ? ((scaled + n / 2) / n) : -((-scaled + n / 2) / n));
+        summary->stddev = 0U;
+
+        if( n > 1 )
+        {
+            /* sum = quotient * n + remainder (0 <= remainder < n), so the sum of squared
+               deviations is M2 = centred - remainder^2 / n, with
+               centred = sum(x^2) - n * quotient^2 - 2 * quotient * remainder */
+            quotient = MCP9808_RollupFloorDiv(stats->sum, n);
+            remainder = stats->sum - quotient * n;
+            centred = (int64_t)stats->sumSq - n * quotient * quotient - 2 * quotient * remainder;
+
+            /* 256 * remainder^2 / n: integer part, and whether a fraction is left */
+            square = (uint64_t)remainder * (uint64_t)remainder;
+            correction = 256U * (square / (uint64_t)n) + (256U * (square % (uint64_t)n)) / (uint64_t)n;
+            fraction = ((256U * (square % (uint64_t)n)) % (uint64_t)n) != 0U;
+
+            /* Variance in (1/256 °C)^2, floored: 256 * M2 / (n - 1) */
+            inner = 256 * (centred % (n - 1)) - (int64_t)correction - (fraction ? 1 : 0);
+            summary->stddev = MCP9808_RollupSqrt((uint64_t)(256 * (centred / (n - 1)) +
+                                                            MCP9808_RollupFloorDiv(inner, n - 1)));
+        }
+        error = MCP9808_OK;
+    }
+
+    return error;
+}
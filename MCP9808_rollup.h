@@ -0,0 +1,125 @@
+/**                             _____________
+ *              /\      /\     /             \
+ *             //\\____//\\   |   MAUUUU!!    |
+ *            /     '      \   \  ___________/
+ *           /   /\ '  /\    \ /_/                  / /  ___    / __\ |__   __ _| |_
+ *          |    == o ==      |       /|         / /  / _ \  / /  | '_ \ / _` | __|
+ *           \      '        /       | |        / /__|  __/ / /___| | | | (_| | |_
+ *             \           /         \ \        \____/\___| \____/|_| |_|\__,_|\__|
+ *             /----<o>---- \         / /
+ *             |            ' \       \ \
+ *             |    |    | '   '\      \ \
+ *  _________  | ´´ |  ' |     '  \    / /
+ *  |  MAYA  | |  ' |    | '       |__/ /
+ *   \______/   \__/ \__/ \_______/____/
+ * @file MCP9808_rollup.h
+ * @author Alejandro Gomez Molina (@Alejo2312)
+ * @brief Incremental per-sensor statistics and multi-resolution rollups.
+ * @version 0.1
+ * @date Mar 22, 2022
+ * 
+ * @copyright Copyright (c) 2022
+ * 
+ */
+#ifndef DRIVERS_INC_MCP9808_ROLLUP_H_
+#define DRIVERS_INC_MCP9808_ROLLUP_H_
+
+
+/************************************************************************
+    INCLUDES
+************************************************************************/
+#include "MCP9808.h"
+
+/************************************************************************
+    DEFINES AND TYPES
+************************************************************************/
+
+/** Maximum number of rollup levels (e.g. 1 s, 1 min, 1 h) */
+#ifndef MCP9808_ROLLUP_LEVELS
+#define MCP9808_ROLLUP_LEVELS       4U
+#endif /* MCP9808_ROLLUP_LEVELS */
+
+/** Running statistics, exact integer sums of 1/16 °C values */
+typedef struct
+{
+    uint32_t    count;          /**< Number of samples */
+    int16_t     min;            /**< Lowest temperature (1/16 °C) */
+    int16_t     max;            /**< Highest temperature (1/16 °C) */
+    int64_t     sum;            /**< Sum of temperatures (1/16 °C) */
+    uint64_t    sumSq;          /**< Sum of squared temperatures ((1/16 °C)^2) */
+}MCP9808_Rollup_Stats_t;
+
+/** Rollup window */
+typedef struct
+{
+    uint64_t                startUs;    /**< Window start (multiple of the level period) */
+    MCP9808_Rollup_Stats_t  stats;      /**< Window statistics */
+}MCP9808_Rollup_Window_t;
+
+/** Rollup level: the open window and the last "depth" closed ones */
+typedef struct
+{
+    uint64_t                    periodUs;   /**< Window length (us) */
+    MCP9808_Rollup_Window_t     current;    /**< Open window (closed windows of the level below) */
+    MCP9808_Rollup_Window_t*    history;    /**< Closed windows ring */
+    uint16_t                    next;       /**< Next history slot */
+    uint16_t                    count;      /**< Closed windows kept */
+}MCP9808_Rollup_Level_t;
+
+/** Per-sensor rollup */
+typedef struct
+{
+    MCP9808_Rollup_Level_t  levels[MCP9808_ROLLUP_LEVELS];  /**< Levels, finest first */
+    uint8_t                 nLevels;    /**< Number of levels */
+    uint16_t                depth;      /**< Closed windows kept per level */
+}MCP9808_Rollup_t;
+
+/** Statistics summary */
+typedef struct
+{
+    uint32_t    count;          /**< Number of samples */
+    int16_t     min;            /**< Lowest temperature (1/16 °C) */
+    int16_t     max;            /**< Highest temperature (1/16 °C) */
+    int32_t     mean;           /**< Mean (1/256 °C) */
+    uint32_t    stddev;         /**< Sample standard deviation (1/256 °C) */
+}MCP9808_Rollup_Summary_t;
+
+/************************************************************************
+    FUNCTIONS
+************************************************************************/
+
+/**
+  See "MCP9808_rollup.c" for details of how to use this function.
+ */
+MCP9808_Error_t MCP9808_RollupInit( MCP9808_Rollup_t* rollup, const uint64_t* periodsUs, uint8_t nLevels,
+                                    MCP9808_Rollup_Window_t* history, uint16_t depth );
+
+/**
+  See "MCP9808_rollup.c" for details of how to use this function.
+ */
+MCP9808_Error_t MCP9808_RollupAdd( MCP9808_Rollup_t* rollup, uint64_t timeUs, int16_t temperature );
+
+/**
+  See "MCP9808_rollup.c" for details of how to use this function.
+ */
+MCP9808_Error_t MCP9808_RollupGet( const MCP9808_Rollup_t* rollup, uint8_t level, uint16_t age,
+                                   MCP9808_Rollup_Window_t* window );
+
+/**
+  See "MCP9808_rollup.c" for details of how to use this function.
+ */
+MCP9808_Error_t MCP9808_RollupCurrent( const MCP9808_Rollup_t* rollup, uint8_t level,
+                                       MCP9808_Rollup_Window_t* window );
+
+/**
+  See "MCP9808_rollup.c" for details of how to use this function.
+ */
+void MCP9808_RollupMerge( MCP9808_Rollup_Stats_t* stats, const MCP9808_Rollup_Stats_t* other );
+
+/**
+  See "MCP9808_rollup.c" for details of how to use this function.
+ */
+MCP9808_Error_t MCP9808_RollupSummary( const MCP9808_Rollup_Stats_t* stats, MCP9808_Rollup_Summary_t* summary );
+
+
+#endif /* DRIVERS_INC_MCP9808_ROLLUP_H_ */
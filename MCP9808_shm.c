@@ -0,0 +1,410 @@
+/**                             _____________
+ *              /\      /\     /             \
+ *             //\\____//\\   |   MAUUUU!!    |
+ *            /     '      \   \  ___________/
+ *           /   /\ '  /\    \ /_/                  / /  ___    / __\ |__   __ _| |_
+ *          |    == o ==      |       /|         / /  / _ \  / /  | '_ \ / _` | __|
+ *           \      '        /       | |        / /__|  __/ / /___| | | | (_| | |_
+ *             \           /         \ \        \____/\___| \____/|_| |_|\__,_|\__|
+ *             /----<o>---- \         / /
+ *             |            ' \       \ \
+ *             |    |    | '   '\      \ \
+ *  _________  | ´´ |  ' |     '  \    / /
+ *  |  MAYA  | |  ' |    | '       |__/ /
+ *   \______/   \__/ \__/ \_______/____/
+ * @file MCP9808_shm.c
+ * @author Alejandro Gomez Molina (@Alejo2312)
+ * @brief Memory mapped sample history shared between processes. One
+ *        publisher writes decoded samples into a ring of slots in a file
+ *        (e.g. under /dev/shm); any number of readers map it read-only and
+ *        read samples with plain loads: no syscall, no lock, no IPC. Each
+ *        slot carries a sequence number, so a reader detects samples that
+ *        were overwritten while it was reading them. The header keeps the
+ *        latest sample of each sensor apart from the ring, so it stays
+ *        readable however fast the other sensors fill the history.
+ * @version 0.1
+ * @date Mar 22, 2022
+ * 
+ * @copyright Copyright (c) 2022
+ * 
+ */
+
+/************************************************************************
+    INCLUDES
+************************************************************************/
+#include <fcntl.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "MCP9808_shm.h"
+
+/************************************************************************
+    DEFINES AND TYPES
+************************************************************************/
+#define MCP9808_SHM_SLOTS_OFFSET    ((sizeof(MCP9808_Shm_Header_t) + MCP9808_SHM_ALIGN - 1U) & \
+                                     ~(size_t)(MCP9808_SHM_ALIGN - 1U))
+
+/************************************************************************
+    FUNCTIONS
+************************************************************************/
+
+/**
+ * @brief Get the file size of a history.
+ *
+ * @param capacity Number of slots.
+ * @return size_t File size (bytes).
+ */
+static size_t MCP9808_ShmSize( uint32_t capacity )
+{
+    return MCP9808_SHM_SLOTS_OFFSET + (size_t)capacity * sizeof(MCP9808_Shm_Slot_t);
+}
+
+/**
+ * @brief Write a sample into a slot (single writer). The sequence is odd
+ *        while the fields are being written.
+ *
+ * @param slot Slot.
+ * @param sequence Sample number.
+ * @param sensor Sensor number.
+ * @param timeUs Sample time (us).
+ * @param raw Raw TA register (MSB << 8 | LSB).
+ */
+static void MCP9808_ShmSlotWrite( MCP9808_Shm_Slot_t* slot, uint64_t sequence, uint16_t sensor, uint64_t timeUs,
+                                  uint16_t raw )
+{
+    atomic_store_explicit(&slot->sequence, 2U * sequence + 1U, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+
+    atomic_store_explicit(&slot->timeUs, timeUs, memory_order_relaxed);
+    atomic_store_explicit(&slot->sensor, sensor, memory_order_relaxed);
+    atomic_store_explicit(&slot->raw, raw, memory_order_relaxed);
+    atomic_store_explicit(&slot->temperature, MCP9808_RegToQ4(raw), memory_order_relaxed);
+
+    atomic_store_explicit(&slot->sequence, 2U * sequence + 2U, memory_order_release);
+}
+
+/**
+ * @brief Copy a slot (any process).
+ *
+ * @param slot Slot.
+ * @param sample Sample storage ("sequence" not set).
+ * @return uint64_t Slot sequence, odd if the copy is torn (written meanwhile).
+ */
+static uint64_t MCP9808_ShmSlotRead( const MCP9808_Shm_Slot_t* slot, MCP9808_Shm_Sample_t* sample )
+{
+    uint64_t before = atomic_load_explicit(&slot->sequence, memory_order_acquire);
+
+    sample->timeUs = atomic_load_explicit(&slot->timeUs, memory_order_relaxed);
+    sample->sensor = atomic_load_explicit(&slot->sensor, memory_order_relaxed);
+    sample->raw = atomic_load_explicit(&slot->raw, memory_order_relaxed);
+    sample->temperature = atomic_load_explicit(&slot->temperature, memory_order_relaxed);
+
+    atomic_thread_fence(memory_order_acquire);
+    return (atomic_load_explicit(&slot->sequence, memory_order_relaxed) == before) ? before : 1U;
+}
+
+/**
+ * @brief Map an open history file and check its header.
+ *
+ * @param shm Handle, "fd" set.
+ * @param write True for the publisher (read/write mapping).
+ * @param size Mapping size.
+ * @return MCP9808_Error_t A number lower than '0' if something was wrong.
+ */
+static MCP9808_Error_t MCP9808_ShmMap( MCP9808_Shm_t* shm, bool write, size_t size )
+{
+    MCP9808_Error_t error = MCP9808_ERROR;
+
+    shm->map = mmap(NULL, size, write ? (PROT_READ | PROT_WRITE) : PROT_READ, MAP_SHARED, shm->fd, 0);
+    if( shm->map != MAP_FAILED )
+    {
+        shm->size = size;
+        shm->header = (MCP9808_Shm_Header_t*)shm->map;
+        shm->slots = (MCP9808_Shm_Slot_t*)((uint8_t*)shm->map + MCP9808_SHM_SLOTS_OFFSET);
+        error = MCP9808_OK;
+    }
+    else
+    {
+        shm->map = NULL;
+    }
+
+    return error;
+}
+
+/**
+ * @brief Check if a mapped header describes a valid history of "size" bytes.
+ *
+ * @param header Mapped header.
+ * @param size File size.
+ * @return true if the layout matches this build.
+ */
+static bool MCP9808_ShmValid( const MCP9808_Shm_Header_t* header, size_t size )
+{
+    return (atomic_load_explicit(&header->magic, memory_order_acquire) == MCP9808_SHM_MAGIC) &&
+           (header->version == MCP9808_SHM_VERSION) && (header->slotSize == sizeof(MCP9808_Shm_Slot_t)) &&
+           (header->sensors == MCP9808_SHM_SENSORS) && (header->capacity != 0U) &&
+           ((header->capacity & (header->capacity - 1U)) == 0U) && (MCP9808_ShmSize(header->capacity) == size);
+}
+
+/**
+ * @brief     Create (publisher side) a shared history of "capacity" samples.
+ *            If the file already holds a history with the same layout it is
+ *            kept and sample numbers go on, so readers that mapped it keep
+ *            working across publisher restarts. Only one publisher per file.
+ *
+ * @param shm Handle storage.
+ * @param path File path (e.g. "/dev/shm/mcp9808").
+ * @param capacity Number of samples kept, power of two.
+ * @return MCP9808_Error_t A number lower than '0' if something was wrong.
+ */
+MCP9808_Error_t MCP9808_ShmCreate( MCP9808_Shm_t* shm, const char* path, uint32_t capacity )
+{
+    MCP9808_Error_t error = MCP9808_ERROR;
+    MCP9808_Shm_Header_t* header = NULL;
+    struct stat st;
+    size_t size = MCP9808_ShmSize(capacity);
+    bool keep = false;
+    uint32_t i = 0;
+
+    if( shm != NULL )
+    {
+        /* Nothing of the caller storage is closed on an invalid argument */
+        shm->fd = -1;
+        shm->map = NULL;
+    }
+
+    if( (shm != NULL) && (path != NULL) && (capacity != 0U) && ((capacity & (capacity - 1U)) == 0U) )
+    {
+        shm->fd = open(path, O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+        if( shm->fd >= 0 )
+        {
+            keep = (fstat(shm->fd, &st) == 0) && ((size_t)st.st_size == size);
+            if( keep || (ftruncate(shm->fd, (off_t)size) == 0) )
+            {
+                error = MCP9808_ShmMap(shm, true, size);
+            }
+        }
+    }
+
+    if( !IS_MCP9808_ERROR(error) )
+    {
+        header = shm->header;
+        shm->mask = capacity - 1U;
+
+        if( !keep || !MCP9808_ShmValid(header, size) )
+        {
+            /* Readers wait for the magic number, written last */
+            atomic_store_explicit(&header->magic, 0U, memory_order_relaxed);
+            atomic_thread_fence(memory_order_release);
+            header->version = MCP9808_SHM_VERSION;
+            header->slotSize = sizeof(MCP9808_Shm_Slot_t);
+            header->capacity = capacity;
+            header->sensors = MCP9808_SHM_SENSORS;
+            atomic_store_explicit(&header->head, 0U, memory_order_relaxed);
+            for( i = 0; i < MCP9808_SHM_SENSORS; i++ )
+            {
+                atomic_store_explicit(&header->latest[i].sequence, 0U, memory_order_relaxed);
+            }
+            for( i = 0; i < capacity; i++ )
+            {
+                atomic_store_explicit(&shm->slots[i].sequence, 0U, memory_order_relaxed);
+            }
+            atomic_store_explicit(&header->magic, MCP9808_SHM_MAGIC, memory_order_release);
+        }
+        else
+        {
+            /* A previous publisher stopped in the middle of a latest entry write: drop it */
+            for( i = 0; i < MCP9808_SHM_SENSORS; i++ )
+            {
+                if( atomic_load_explicit(&header->latest[i].sequence, memory_order_relaxed) & 1U )
+                {
+                    atomic_store_explicit(&header->latest[i].sequence, 0U, memory_order_release);
+                }
+            }
+        }
+    }
+    else if( (shm != NULL) && (shm->fd >= 0) )
+    {
+        close(shm->fd);
+        shm->fd = -1;
+    }
+
+    return error;
+}
+
+/**
+ * @brief Map an existing shared history (reader side, read-only).
+ *
+ * @param shm Handle storage.
+ * @param path File path given to the publisher.
+ * @return MCP9808_Error_t A number lower than '0' if the file is not a valid history (yet).
+ */
+MCP9808_Error_t MCP9808_ShmOpen( MCP9808_Shm_t* shm, const char* path )
+{
+    MCP9808_Error_t error = MCP9808_ERROR;
+    struct stat st;
+
+    if( shm != NULL )
+    {
+        /* Nothing of the caller storage is closed on an invalid argument */
+        shm->fd = -1;
+        shm->map = NULL;
+    }
+
+    if( (shm != NULL) && (path != NULL) )
+    {
+        shm->fd = open(path, O_RDONLY | O_CLOEXEC);
+        if( (shm->fd >= 0) && (fstat(shm->fd, &st) == 0) && ((size_t)st.st_size > MCP9808_SHM_SLOTS_OFFSET) )
+        {
+            error = MCP9808_ShmMap(shm, false, (size_t)st.st_size);
+        }
+    }
+
+    if( !IS_MCP9808_ERROR(error) )
+    {
+        if( MCP9808_ShmValid(shm->header, shm->size) )
+        {
+            shm->mask = shm->header->capacity - 1U;
+        }
+        else
+        {
+            MCP9808_ShmClose(shm);
+            error = MCP9808_ERROR;
+        }
+    }
+    else if( (shm != NULL) && (shm->fd >= 0) )
+    {
+        close(shm->fd);
+        shm->fd = -1;
+    }
+
+    return error;
+}
+
+/**
+ * @brief Unmap a shared history. The file is left in place.
+ *
+ * @param shm Handle.
+ * @return MCP9808_Error_t A number lower than '0' if something was wrong.
+ */
+MCP9808_Error_t MCP9808_ShmClose( MCP9808_Shm_t* shm )
+{
+    MCP9808_Error_t error = MCP9808_ERROR;
+
+    if( (shm != NULL) && (shm->map != NULL) )
+    {
+        munmap(shm->map, shm->size);
+        close(shm->fd);
+        shm->map = NULL;
+        shm->fd = -1;
+        error = MCP9808_OK;
+    }
+
+    return error;
+}
+
+/**
+ * @brief Publish a sample (publisher side, single writer). The oldest
+ *        sample is overwritten when the history is full.
+ *
+ * @param shm Handle opened with MCP9808_ShmCreate().
+ * @param sensor Sensor number. Sensors from MCP9808_SHM_SENSORS up only go to the
+ *        history (no latest sample entry).
+ * @param timeUs Sample time (us).
+ * @param raw Raw TA register (MSB << 8 | LSB).
+ * @return MCP9808_Error_t A number lower than '0' if something was wrong.
+ */
+MCP9808_Error_t MCP9808_ShmPublish( MCP9808_Shm_t* shm, uint16_t sensor, uint64_t timeUs, uint16_t raw )
+{
+    MCP9808_Error_t error = MCP9808_ERROR;
+    uint64_t head = 0;
+
+    if( (shm != NULL) && (shm->map != NULL) )
+    {
+        head = atomic_load_explicit(&shm->header->head, memory_order_relaxed);
+
+        MCP9808_ShmSlotWrite(&shm->slots[head & shm->mask], head, sensor, timeUs, raw);
+        if( sensor < MCP9808_SHM_SENSORS )
+        {
+            MCP9808_ShmSlotWrite(&shm->header->latest[sensor], head, sensor, timeUs, raw);
+        }
+        atomic_store_explicit(&shm->header->head, head + 1U, memory_order_release);
+        error = MCP9808_OK;
+    }
+
+    return error;
+}
+
+/**
+ * @brief Get the number of samples published so far. Samples from
+ *        head - capacity to head - 1 can be read.
+ *
+ * @param shm Handle.
+ * @return uint64_t Next sample number.
+ */
+uint64_t MCP9808_ShmHead( const MCP9808_Shm_t* shm )
+{
+    return ((shm != NULL) && (shm->map != NULL)) ?
+           atomic_load_explicit(&shm->header->head, memory_order_acquire) : 0U;
+}
+
+/**
+ * @brief Read a sample from the history (any process).
+ *
+ * @param shm Handle.
+ * @param sequence Sample number.
+ * @param sample Sample storage.
+ * @return MCP9808_Error_t A number lower than '0' if the sample is not published yet or was overwritten.
+ */
+MCP9808_Error_t MCP9808_ShmRead( const MCP9808_Shm_t* shm, uint64_t sequence, MCP9808_Shm_Sample_t* sample )
+{
+    MCP9808_Error_t error = MCP9808_ERROR;
+
+    if( (shm != NULL) && (shm->map != NULL) && (sample != NULL) )
+    {
+        sample->sequence = sequence;
+        if( MCP9808_ShmSlotRead(&shm->slots[sequence & shm->mask], sample) == (2U * sequence + 2U) )
+        {
+            error = MCP9808_OK;
+        }
+    }
+
+    return error;
+}
+
+/**
+ * @brief Read the latest sample of a sensor (any process). It is kept in
+ *        the header, so it is available even after the ring wrapped over it.
+ *        An entry being written is retried up to MCP9808_SHM_RETRIES times:
+ *        if the publisher died in the middle of the write the entry stays
+ *        busy until a restarted publisher (MCP9808_ShmCreate()) resets it.
+ *
+ * @param shm Handle.
+ * @param sensor Sensor number.
+ * @param sample Sample storage.
+ * @return MCP9808_Error_t A number lower than '0' if the sensor has no sample or its entry stays busy.
+ */
+MCP9808_Error_t MCP9808_ShmLatest( const MCP9808_Shm_t* shm, uint16_t sensor, MCP9808_Shm_Sample_t* sample )
+{
+    MCP9808_Error_t error = MCP9808_ERROR;
+    uint64_t latest = 1U;
+    uint32_t retries = 0;
+
+    if( (shm != NULL) && (shm->map != NULL) && (sensor < MCP9808_SHM_SENSORS) && (sample != NULL) )
+    {
+        /* Lock-free: retry only while the publisher is rewriting this sensor entry */
+        for( retries = 0; (retries < MCP9808_SHM_RETRIES) && (latest & 1U); retries++ )
+        {
+            latest = MCP9808_ShmSlotRead(&shm->header->latest[sensor], sample);
+        }
+
+        if( (latest != 0U) && !(latest & 1U) )
+        {
+            sample->sequence = latest / 2U - 1U;
+            error = MCP9808_OK;
+        }
+    }
+
+    return error;
+}
@@ -0,0 +1,137 @@
+/**                             _____________
+ *              /\      /\     /             \
+ *             //\\____//\\   |   MAUUUU!!    |
+ *            /     '      \   \  ___________/
+ *           /   /\ '  /\    \ /_/                  / /  ___    / __\ |__   __ _| |_
+ *          |    == o ==      |       /|         / /  / _ \  / /  | '_ \ / _` | __|
+ *           \      '        /       | |        / /__|  __/ / /___| | | | (_| | |_
+ *             \           /         \ \        \____/\___| \____/|_| |_|\__,_|\__|
+ *             /----<o>---- \         / /
+ *             |            ' \       \ \
+ *             |    |    | '   '\      \ \
+ *  _________  | ´´ |  ' |     '  \    / /
+ *  |  MAYA  | |  ' |    | '       |__/ /
+ *   \______/   \__/ \__/ \_______/____/
+ * @file MCP9808_shm.h
+ * @author Alejandro Gomez Molina (@Alejo2312)
+ * @brief Memory mapped sample history shared between processes.
+ * @version 0.1
+ * @date Mar 22, 2022
+ * 
+ * @copyright Copyright (c) 2022
+ * 
+ */
+#ifndef DRIVERS_INC_MCP9808_SHM_H_
+#define DRIVERS_INC_MCP9808_SHM_H_
+
+
+/************************************************************************
+    INCLUDES
+************************************************************************/
+#include <stdatomic.h>
+#include "MCP9808.h"
+
+/************************************************************************
+    DEFINES AND TYPES
+************************************************************************/
+
+/** Sensors with a "latest sample" entry in the header (sensor numbers 0 to MCP9808_SHM_SENSORS - 1).
+    Build time setting, stored in the header: publisher and readers must agree on it. Higher sensor
+    numbers are still published into the history. */
+#ifndef MCP9808_SHM_SENSORS
+#define MCP9808_SHM_SENSORS     64U
+#endif /* MCP9808_SHM_SENSORS */
+
+/** Attempts of MCP9808_ShmLatest() on an entry being written before giving up (dead publisher) */
+#ifndef MCP9808_SHM_RETRIES
+#define MCP9808_SHM_RETRIES     1000U
+#endif /* MCP9808_SHM_RETRIES */
+
+#define MCP9808_SHM_MAGIC       0x4D435053UL    /**< "MCPS" */
+#define MCP9808_SHM_VERSION     2U
+#define MCP9808_SHM_ALIGN       64U             /**< Slots start on a cache line */
+
+/** Sample read from the history */
+typedef struct
+{
+    uint64_t    sequence;       /**< Sample number (0 for the first sample ever published) */
+    uint64_t    timeUs;         /**< Sample time (us) */
+    uint16_t    sensor;         /**< Sensor number */
+    uint16_t    raw;            /**< Raw TA register (MSB << 8 | LSB) */
+    int16_t     temperature;    /**< Temperature (1/16 °C) */
+}MCP9808_Shm_Sample_t;
+
+/** History slot, also used for the latest sample of each sensor (seqlock: odd sequence while written) */
+typedef struct
+{
+    atomic_uint_least64_t   sequence;   /**< 2 * n + 2 when it holds sample n */
+    atomic_uint_least64_t   timeUs;
+    atomic_uint_least16_t   sensor;
+    atomic_uint_least16_t   raw;
+    atomic_int_least16_t    temperature;
+}MCP9808_Shm_Slot_t;
+
+/** File header (shared memory layout, version MCP9808_SHM_VERSION) */
+typedef struct
+{
+    atomic_uint_least32_t   magic;      /**< MCP9808_SHM_MAGIC once the file is initialized */
+    uint16_t                version;    /**< MCP9808_SHM_VERSION */
+    uint16_t                slotSize;   /**< sizeof(MCP9808_Shm_Slot_t) */
+    uint32_t                capacity;   /**< Number of slots (power of two) */
+    uint32_t                sensors;    /**< MCP9808_SHM_SENSORS */
+    atomic_uint_least64_t   head;       /**< Samples published so far */
+    MCP9808_Shm_Slot_t      latest[MCP9808_SHM_SENSORS]; /**< Latest sample of each sensor (sequence 0: none) */
+}MCP9808_Shm_Header_t;
+
+/** Shared history handle (publisher or reader) */
+typedef struct
+{
+    int                     fd;         /**< Backing file */
+    void*                   map;        /**< Mapping */
+    size_t                  size;       /**< Mapping size */
+    MCP9808_Shm_Header_t*   header;     /**< Shared header */
+    MCP9808_Shm_Slot_t*     slots;      /**< Shared slots */
+    uint64_t                mask;       /**< Capacity - 1 */
+}MCP9808_Shm_t;
+
+/************************************************************************
+    FUNCTIONS
+************************************************************************/
+
+/**
+  See "MCP9808_shm.c" for details of how to use this function.
+ */
+MCP9808_Error_t MCP9808_ShmCreate( MCP9808_Shm_t* shm, const char* path, uint32_t capacity );
+
+/**
+  See "MCP9808_shm.c" for details of how to use this function.
+ */
+MCP9808_Error_t MCP9808_ShmOpen( MCP9808_Shm_t* shm, const char* path );
+
+/**
+  See "MCP9808_shm.c" for details of how to use this function.
+ */
+MCP9808_Error_t MCP9808_ShmClose( MCP9808_Shm_t* shm );
+
+/**
+  See "MCP9808_shm.c" for details of how to use this function.
+ */
+MCP9808_Error_t MCP9808_ShmPublish( MCP9808_Shm_t* shm, uint16_t sensor, uint64_t timeUs, uint16_t raw );
+
+/**
+  See "MCP9808_shm.c" for details of how to use this function.
+ */
+uint64_t MCP9808_ShmHead( const MCP9808_Shm_t* shm );
+
+/**
+  See "MCP9808_shm.c" for details of how to use this function.
+ */
+MCP9808_Error_t MCP9808_ShmRead( const MCP9808_Shm_t* shm, uint64_t sequence, MCP9808_Shm_Sample_t* sample );
+
+/**
+  See "MCP9808_shm.c" for details of how to use this function.
+ */
+MCP9808_Error_t MCP9808_ShmLatest( const MCP9808_Shm_t* shm, uint16_t sensor, MCP9808_Shm_Sample_t* sample );
+
+
+#endif /* DRIVERS_INC_MCP9808_SHM_H_ */
@@ -0,0 +1,515 @@
+/**                             _____________
+ *              /\      /\     /             \
+ *             //\\____//\\   |   MAUUUU!!    |
+ *            /     '      \   \  ___________/
+ *           /   /\ '  /\    \ /_/                  / /  ___    / __\ |__   __ _| |_
+ *          |    == o ==      |       /|         / /  / _ \  / /  | '_ \ / _` | __|
+ *           \      '        /       | |        / /__|  __/ / /___| | | | (_| | |_
+ *             \           /         \ \        \____/\___| \____/|_| |_|\__,_|\__|
+ *             /----<o>---- \         / /
+ *             |            ' \       \ \
+ *             |    |    | '   '\      \ \
+ *  _________  | ´´ |  ' |     '  \    / /
+ *  |  MAYA  | |  ' |    | '       |__/ /
+ *   \______/   \__/ \__/ \_______/____/
+ * @file MCP9808_bench.c
+ * @author Alejandro Gomez Molina (@Alejo2312)
+ * @brief Driver hot paths benchmark, run against the simulated port.
+ *        Prints one JSON object per line: time per call and bus
+ *        transactions/bytes per call, for 1 to N virtual sensors.
+ *
+ *        gcc -O2 -I. -Itemplate -Iport/sim bench/MCP9808_bench.c MCP9808_batch.c port/sim/MCP9808_port_sim.c -o mcp9808_bench
+ *        ./mcp9808_bench [-l latencyNs] [-n maxSensors] [-i iterations]
+ *
+ *        The driver source is included so the static float kernels can be
+ *        measured too. Build with the same MCP9808_USE_* flags as the target.
+ * @version 0.1
+ * @date Mar 22, 2022
+ * 
+ * @copyright Copyright (c) 2022
+ * 
+ */
+
+/************************************************************************
+    INCLUDES
+************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "MCP9808.c"
+#include "MCP9808_batch.h"
+#include "MCP9808_port_sim.h"
+
+/************************************************************************
+    DEFINES AND TYPES
+************************************************************************/
+#define BENCH_MAX_SENSORS       10000U  /**< Default largest sensor count */
+#define BENCH_ITERATIONS        200000U /**< Default calls per benchmark */
+#define BENCH_BATCH             1024U   /**< Frames per batch decode call */
+
+/** Benchmark context */
+typedef struct
+{
+    MCP9808_SIM_Bus_t*  buses;      /**< Simulated buses */
+    size_t              nBuses;     /**< Number of buses */
+    MCP9808_Device_t*   devices;    /**< Sensor handles */
+    MCP9808_Device_t**  handles;    /**< Sensor handle pointers (multi reads) */
+    size_t              nSensors;   /**< Number of sensors */
+    uint32_t            latencyNs;  /**< Transfer latency */
+}Bench_t;
+
+/** Benchmarked operation: call "i" on sensor "i % nSensors" */
+typedef MCP9808_Error_t (*Bench_Op_t)( Bench_t* bench, uint32_t i );
+
+/** Benchmark entry */
+typedef struct
+{
+    const char* name;       /**< Name in the report */
+    Bench_Op_t  op;         /**< Operation */
+    bool        bus;        /**< Uses the bus (run for every sensor count) */
+}Bench_Entry_t;
+
+/************************************************************************
+    FUNCTIONS
+************************************************************************/
+
+/**
+ * @brief Get a monotonic time stamp.
+ *
+ * @return uint64_t Time (ns).
+ */
+static uint64_t Bench_Now( void )
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000000000ULL + (uint64_t)now.tv_nsec;
+}
+
+/**
+ * @brief Get the sensor used by call "i".
+ *
+ * @param bench Context.
+ * @param i Call number.
+ * @return MCP9808_Device_t* Sensor handle.
+ */
+static MCP9808_Device_t* Bench_Device( Bench_t* bench, uint32_t i )
+{
+    return &bench->devices[i % bench->nSensors];
+}
+
+/**
+ * @brief Get the value flag of call "i": it changes on every pass over the
+ *        sensors, so setters always write something new.
+ *
+ * @param bench Context.
+ * @param i Call number.
+ * @return uint32_t 0 or 1.
+ */
+static uint32_t Bench_Toggle( Bench_t* bench, uint32_t i )
+{
+    return (uint32_t)((i / bench->nSensors) & 1U);
+}
+
+/* Pure computation */
+#if MCP9808_USE_FLOAT
+static MCP9808_Error_t Bench_RegToTemp( Bench_t* bench, uint32_t i )
+{
+    uint8_t regData[MCP9808_REG_SIZE] = { (uint8_t)((i >> 8) & 0x1F), (uint8_t)i };
+    volatile float temperature = 0.0f;
+    float value = 0.0f;
+    MCP9808_Error_t error = MCP9808_RegToTemp(regData, &value);
+
+    (void)bench;
+    temperature = value;
+    (void)temperature;
+    return error;
+}
+
+static MCP9808_Error_t Bench_TempToReg( Bench_t* bench, uint32_t i )
+{
+    volatile uint8_t sink = 0;
+    uint8_t regData[MCP9808_REG_SIZE] = { 0, 0 };
+    float temperature = (float)(i % 4000U) * 0.0625f + 1.0f;
+    MCP9808_Error_t error = MCP9808_TempToReg(regData, &temperature);
+
+    (void)bench;
+    sink = regData[MCP9808_MSB] ^ regData[MCP9808_LSB];
+    (void)sink;
+    return error;
+}
+#endif /* MCP9808_USE_FLOAT */
+
+static MCP9808_Error_t Bench_RegToQ4( Bench_t* bench, uint32_t i )
+{
+    volatile int16_t temperature = MCP9808_RegToQ4((uint16_t)i);
+
+    (void)bench;
+    (void)temperature;
+    return MCP9808_OK;
+}
+
+static MCP9808_Error_t Bench_Q4ToReg( Bench_t* bench, uint32_t i )
+{
+    volatile uint16_t reg = MCP9808_Q4ToReg((int16_t)(i & 0xFFFU));
+
+    (void)bench;
+    (void)reg;
+    return MCP9808_OK;
+}
+
+static MCP9808_Error_t Bench_DecodeBatchQ4( Bench_t* bench, uint32_t i )
+{
+    static uint8_t frames[BENCH_BATCH * MCP9808_REG_SIZE];
+    static int16_t out[BENCH_BATCH];
+    static uint8_t flags[BENCH_BATCH];
+
+    (void)bench;
+    frames[(i % BENCH_BATCH) * MCP9808_REG_SIZE] = (uint8_t)i;
+    return MCP9808_DecodeBatchQ4(frames, BENCH_BATCH, out, flags);
+}
+
+/* Temperature reads */
+#if MCP9808_USE_FLOAT
+static MCP9808_Error_t Bench_ReadTemperature( Bench_t* bench, uint32_t i )
+{
+    float temperature = 0.0f;
+
+    return MCP9808_ReadTemperature(Bench_Device(bench, i), &temperature);
+}
+#endif /* MCP9808_USE_FLOAT */
+
+static MCP9808_Error_t Bench_ReadTemperatureQ4( Bench_t* bench, uint32_t i )
+{
+    int16_t temperature = 0;
+
+    return MCP9808_ReadTemperatureQ4(Bench_Device(bench, i), &temperature);
+}
+
+static MCP9808_Error_t Bench_ReadTemperatureRaw( Bench_t* bench, uint32_t i )
+{
+    uint16_t raw = 0;
+
+    return MCP9808_ReadTemperatureRaw(Bench_Device(bench, i), &raw);
+}
+
+/* Same sensor list as ReadTemperatureMulti, one read per device: its baseline */
+static MCP9808_Error_t Bench_ReadTemperatureEach( Bench_t* bench, uint32_t i )
+{
+    MCP9808_Error_t error = MCP9808_OK;
+    size_t n = (bench->nSensors < BENCH_MAX_SENSORS) ? bench->nSensors : BENCH_MAX_SENSORS;
+    int16_t temperature = 0;
+    size_t j = 0;
+
+    (void)i;
+    for( j = 0; j < n; j++ )
+    {
+        if( IS_MCP9808_ERROR(MCP9808_ReadTemperatureQ4(bench->handles[j], &temperature)) )
+        {
+            error = MCP9808_ERROR;
+        }
+    }
+
+    return error;
+}
+
+static MCP9808_Error_t Bench_ReadTemperatureMulti( Bench_t* bench, uint32_t i )
+{
+    static MCP9808_Multi_Result_t results[BENCH_MAX_SENSORS];
+    size_t n = (bench->nSensors < BENCH_MAX_SENSORS) ? bench->nSensors : BENCH_MAX_SENSORS;
+
+    (void)i;
+    return MCP9808_ReadTemperatureMulti(bench->handles, n, results);
+}
+
+/* Configuration setters: values alternate so every call reaches the bus */
+#if MCP9808_USE_FLOAT
+static MCP9808_Error_t Bench_SetCriticalTemperature( Bench_t* bench, uint32_t i )
+{
+    return MCP9808_SetCriticalTemperature(Bench_Device(bench, i), Bench_Toggle(bench, i) ? 80.25f : 85.5f);
+}
+
+static MCP9808_Error_t Bench_SetWindowTemperature( Bench_t* bench, uint32_t i )
+{
+    return MCP9808_SetWindowTemperature(Bench_Device(bench, i), Bench_Toggle(bench, i) ? 30.5f : 31.75f, 12.5f);
+}
+#endif /* MCP9808_USE_FLOAT */
+
+static MCP9808_Error_t Bench_SetCriticalTemperatureQ4( Bench_t* bench, uint32_t i )
+{
+    return MCP9808_SetCriticalTemperatureQ4(Bench_Device(bench, i), Bench_Toggle(bench, i) ? 1284 : 1368);
+}
+
+static MCP9808_Error_t Bench_SetWindowTemperatureQ4( Bench_t* bench, uint32_t i )
+{
+    return MCP9808_SetWindowTemperatureQ4(Bench_Device(bench, i), Bench_Toggle(bench, i) ? 488 : 508, 200);
+}
+
+static MCP9808_Error_t Bench_SetHysteresis( Bench_t* bench, uint32_t i )
+{
+    return MCP9808_SetHysteresis(Bench_Device(bench, i), Bench_Toggle(bench, i) ? MCP9808_HYST_1C5 : MCP9808_HYST_0C5);
+}
+
+static MCP9808_Error_t Bench_SetResolution( Bench_t* bench, uint32_t i )
+{
+    return MCP9808_SetResolution(Bench_Device(bench, i), Bench_Toggle(bench, i) ? MCP9808_RESOLUTION_2 : MCP9808_RESOLUTION_4);
+}
+
+static MCP9808_Error_t Bench_SetShutdown( Bench_t* bench, uint32_t i )
+{
+    return MCP9808_SetShutdown(Bench_Device(bench, i), Bench_Toggle(bench, i) != 0U);
+}
+
+static MCP9808_Error_t Bench_EnableAlert( Bench_t* bench, uint32_t i )
+{
+    return Bench_Toggle(bench, i) ? MCP9808_EnableAlert(Bench_Device(bench, i)) : MCP9808_DisableAlert(Bench_Device(bench, i));
+}
+
+static MCP9808_Error_t Bench_SetAlertMode( Bench_t* bench, uint32_t i )
+{
+    return MCP9808_SetAlertMode(Bench_Device(bench, i), Bench_Toggle(bench, i) ? MCP9808_ALERT_MODE_TCRIT : MCP9808_ALERT_MODE_ALL);
+}
+
+static MCP9808_Error_t Bench_SetAlertPolarity( Bench_t* bench, uint32_t i )
+{
+    return MCP9808_SetAlertPolarity(Bench_Device(bench, i), Bench_Toggle(bench, i) ? MCP9808_ALERT_POL_HIGH : MCP9808_ALERT_POL_lOW);
+}
+
+static MCP9808_Error_t Bench_SetAlertOutput( Bench_t* bench, uint32_t i )
+{
+    return MCP9808_SetAlertOutput(Bench_Device(bench, i), Bench_Toggle(bench, i) ? MCP9808_ALERT_OUTPUT_IRQ : MCP9808_ALERT_OUTPUT_COMP);
+}
+
+static MCP9808_Error_t Bench_ClearInterrupt( Bench_t* bench, uint32_t i )
+{
+    return MCP9808_ClearInterrupt(Bench_Device(bench, i));
+}
+
+static const Bench_Entry_t Bench_Entries[] =
+{
+#if MCP9808_USE_FLOAT
+    { "RegToTemp",                  Bench_RegToTemp,                false },
+    { "TempToReg",                  Bench_TempToReg,                false },
+#endif /* MCP9808_USE_FLOAT */
+    { "RegToQ4",                    Bench_RegToQ4,                  false },
+    { "Q4ToReg",                    Bench_Q4ToReg,                  false },
+    { "DecodeBatchQ4",              Bench_DecodeBatchQ4,            false },
+#if MCP9808_USE_FLOAT
+    { "ReadTemperature",            Bench_ReadTemperature,          true },
+#endif /* MCP9808_USE_FLOAT */
+    { "ReadTemperatureQ4",          Bench_ReadTemperatureQ4,        true },
+    { "ReadTemperatureRaw",         Bench_ReadTemperatureRaw,       true },
+    { "ReadTemperatureEach",        Bench_ReadTemperatureEach,      true },
+    { "ReadTemperatureMulti",       Bench_ReadTemperatureMulti,     true },
+#if MCP9808_USE_FLOAT
+    { "SetCriticalTemperature",     Bench_SetCriticalTemperature,   true },
+    { "SetWindowTemperature",       Bench_SetWindowTemperature,     true },
+#endif /* MCP9808_USE_FLOAT */
+    { "SetCriticalTemperatureQ4",   Bench_SetCriticalTemperatureQ4, true },
+    { "SetWindowTemperatureQ4",     Bench_SetWindowTemperatureQ4,   true },
+    { "SetHysteresis",              Bench_SetHysteresis,            true },
+    { "SetResolution",              Bench_SetResolution,            true },
+    { "SetShutdown",                Bench_SetShutdown,              true },
+    { "EnableAlert",                Bench_EnableAlert,              true },
+    { "SetAlertMode",               Bench_SetAlertMode,             true },
+    { "SetAlertPolarity",           Bench_SetAlertPolarity,         true },
+    { "SetAlertOutput",             Bench_SetAlertOutput,           true },
+    { "ClearInterrupt",             Bench_ClearInterrupt,           true },
+};
+
+/**
+ * @brief Build "n" virtual sensors, 8 per simulated bus.
+ *
+ * @param bench Context storage.
+ * @param n Number of sensors.
+ * @param latencyNs Transfer latency.
+ * @return MCP9808_Error_t A number lower than '0' if something was wrong.
+ */
+static MCP9808_Error_t Bench_Setup( Bench_t* bench, size_t n, uint32_t latencyNs )
+{
+    MCP9808_Error_t error = MCP9808_ERROR;
+    MCP9808_SIM_Bus_t* bus = NULL;
+    uint8_t address = 0;
+    size_t i = 0;
+
+    bench->nSensors = n;
+    bench->nBuses = (n + MCP9808_SIM_DEVICES - 1U) / MCP9808_SIM_DEVICES;
+    bench->latencyNs = latencyNs;
+    bench->buses = calloc(bench->nBuses, sizeof(MCP9808_SIM_Bus_t));
+    bench->devices = calloc(n, sizeof(MCP9808_Device_t));
+    bench->handles = calloc(n, sizeof(MCP9808_Device_t*));
+
+    if( (bench->buses != NULL) && (bench->devices != NULL) && (bench->handles != NULL) )
+    {
+        error = MCP9808_OK;
+        for( i = 0; (i < n) && !IS_MCP9808_ERROR(error); i++ )
+        {
+            bus = &bench->buses[i / MCP9808_SIM_DEVICES];
+            address = (uint8_t)(MCP9808_SIM_BASE_ADDRESS + (i % MCP9808_SIM_DEVICES));
+            if( (i % MCP9808_SIM_DEVICES) == 0U )
+            {
+                MCP9808_SIM_BusInit(bus, 0U);
+            }
+            MCP9808_SIM_AddDevice(bus, address);
+            error = MCP9808_Init(&bench->devices[i], bus, address);
+            bench->handles[i] = &bench->devices[i];
+        }
+    }
+
+    return error;
+}
+
+/**
+ * @brief Set the transfer latency of every bus.
+ *
+ * @param bench Context.
+ * @param latencyNs Transfer latency (0 to disable).
+ */
+static void Bench_Latency( Bench_t* bench, uint32_t latencyNs )
+{
+    size_t i = 0;
+
+    for( i = 0; i < bench->nBuses; i++ )
+    {
+        bench->buses[i].latencyNs = latencyNs;
+    }
+}
+
+/**
+ * @brief Release the virtual sensors.
+ *
+ * @param bench Context.
+ */
+static void Bench_Teardown( Bench_t* bench )
+{
+    free(bench->buses);
+    free(bench->devices);
+    free(bench->handles);
+}
+
+/**
+ * @brief Sum the transactions and bytes of every bus.
+ *
+ * @param bench Context.
+ * @param transactions Transactions.
+ * @param bytes Bytes.
+ */
+static void Bench_Traffic( const Bench_t* bench, uint64_t* transactions, uint64_t* bytes )
+{
+    size_t i = 0;
+
+    *transactions = 0U;
+    *bytes = 0U;
+    for( i = 0; i < bench->nBuses; i++ )
+    {
+        *transactions += bench->buses[i].reads + bench->buses[i].writes;
+        *bytes += bench->buses[i].bytes;
+    }
+}
+
+/**
+ * @brief Run a benchmark and print its result line.
+ *
+ * @param bench Context.
+ * @param entry Benchmark.
+ * @param iterations Number of calls.
+ * @return MCP9808_Error_t A number lower than '0' if a call failed.
+ */
+static MCP9808_Error_t Bench_Run( Bench_t* bench, const Bench_Entry_t* entry, uint32_t iterations )
+{
+    MCP9808_Error_t error = MCP9808_OK;
+    uint64_t transactions[2];
+    uint64_t bytes[2];
+    uint64_t start = 0;
+    uint64_t elapsed = 0;
+    uint32_t i = 0;
+
+    /* Warm up: every sensor once (register caches filled) */
+    for( i = 0; entry->bus && (i < bench->nSensors) && (entry->op != Bench_ReadTemperatureMulti) &&
+                (entry->op != Bench_ReadTemperatureEach); i++ )
+    {
+        entry->op(bench, (uint32_t)(bench->nSensors + i));
+    }
+
+    /* Latency only on measured transfers (setup and warm up run without it) */
+    Bench_Latency(bench, bench->latencyNs);
+    Bench_Traffic(bench, &transactions[0], &bytes[0]);
+    start = Bench_Now();
+    for( i = 0; i < iterations; i++ )
+    {
+        if( IS_MCP9808_ERROR(entry->op(bench, i)) )
+        {
+            error = MCP9808_ERROR;
+        }
+    }
+    elapsed = Bench_Now() - start;
+    Bench_Traffic(bench, &transactions[1], &bytes[1]);
+    Bench_Latency(bench, 0U);
+
+    printf("{\"bench\":\"%s\",\"sensors\":%lu,\"latency_ns\":%lu,\"calls\":%lu,\"ns_per_call\":%.1f,"
+           "\"transactions_per_call\":%.3f,\"bytes_per_call\":%.3f,\"ok\":%s}\n",
+           entry->name, entry->bus ? (unsigned long)bench->nSensors : 0UL, (unsigned long)bench->latencyNs,
+           (unsigned long)iterations, (double)elapsed / iterations,
+           (double)(transactions[1] - transactions[0]) / iterations, (double)(bytes[1] - bytes[0]) / iterations,
+           IS_MCP9808_ERROR(error) ? "false" : "true");
+
+    return error;
+}
+
+int main( int argc, char** argv )
+{
+    uint32_t latencyNs = 0;
+    uint32_t maxSensors = BENCH_MAX_SENSORS;
+    uint32_t iterations = BENCH_ITERATIONS;
+    uint32_t calls = 0;
+    size_t sensors = 0;
+    size_t i = 0;
+    int arg = 0;
+    int result = EXIT_SUCCESS;
+    Bench_t bench;
+
+    for( arg = 1; (arg + 1) < argc; arg += 2 )
+    {
+        if( strcmp(argv[arg], "-l") == 0 )
+        {
+            latencyNs = (uint32_t)strtoul(argv[arg + 1], NULL, 0);
+        }
+        else if( strcmp(argv[arg], "-n") == 0 )
+        {
+            maxSensors = (uint32_t)strtoul(argv[arg + 1], NULL, 0);
+        }
+        else if( strcmp(argv[arg], "-i") == 0 )
+        {
+            iterations = (uint32_t)strtoul(argv[arg + 1], NULL, 0);
+        }
+    }
+    maxSensors = (maxSensors == 0U) ? 1U : ((maxSensors > BENCH_MAX_SENSORS) ? BENCH_MAX_SENSORS : maxSensors);
+
+    for( sensors = 1; (sensors <= maxSensors) && (result == EXIT_SUCCESS); sensors *= 10U )
+    {
+        if( IS_MCP9808_ERROR(Bench_Setup(&bench, sensors, latencyNs)) )
+        {
+            result = EXIT_FAILURE;
+        }
+
+        for( i = 0; (i < (sizeof(Bench_Entries) / sizeof(Bench_Entries[0]))) && (result == EXIT_SUCCESS); i++ )
+        {
+            if( Bench_Entries[i].bus || (sensors == 1U) )
+            {
+                /* A multi read covers every sensor: scale the calls down */
+                calls = ((Bench_Entries[i].op == Bench_ReadTemperatureMulti) ||
+                         (Bench_Entries[i].op == Bench_ReadTemperatureEach)) ?
+                        (uint32_t)(iterations / sensors) + 1U : iterations;
+                if( IS_MCP9808_ERROR(Bench_Run(&bench, &Bench_Entries[i], calls)) )
+                {
+                    result = EXIT_FAILURE;
+                }
+            }
+        }
+
+        Bench_Teardown(&bench);
+    }
+
+    return result;
+}
@@ -0,0 +1,558 @@
+/**                             _____________
+ *              /\      /\     /             \
+ *             //\\____//\\   |   MAUUUU!!    |
+ *            /     '      \   \  ___________/
+ *           /   /\ '  /\    \ /_/                  / /  ___    / __\ |__   __ _| |_
+ *          |    == o ==      |       /|         / /  / _ \  / /  | '_ \ / _` | __|
+ *           \      '        /       | |        / /__|  __/ / /___| | | | (_| | |_
+ *             \           /         \ \        \____/\___| \____/|_| |_|\__,_|\__|
+ *             /----<o>---- \         / /
+ *             |            ' \       \ \
+ *             |    |    | '   '\      \ \
+ *  _________  | ´´ |  ' |     '  \    / /
+ *  |  MAYA  | |  ' |    | '       |__/ /
+ *   \______/   \__/ \__/ \_______/____/
+ * @file MCP9808_conv.c
+ * @author Alejandro Gomez Molina (@Alejo2312)
+ * @brief Exhaustive check and throughput of the temperature conversion
+ *        kernels. Every register word (all 13-bit codes with every flag
+ *        combination) and every limit value goes through both directions
+ *        and is compared against an independent reference. Then every
+ *        kernel variant is timed over the same sweep.
+ *
+ *        gcc -O2 -I. -Itemplate -Iport/sim bench/MCP9808_conv.c MCP9808_batch.c port/sim/MCP9808_port_sim.c -o mcp9808_conv
+ *        ./mcp9808_conv [-r rounds]
+ *
+ *        Prints one JSON object per line and exits with a failure status if
+ *        any conversion is wrong. Build with the same MCP9808_USE_* flags and
+ *        instruction set options (-msse2, -mavx2) as the target.
+ * @version 0.1
+ * @date Mar 22, 2022
+ * 
+ * @copyright Copyright (c) 2022
+ * 
+ */
+
+/************************************************************************
+    INCLUDES
+************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "MCP9808.c"
+#include "MCP9808_batch.h"
+
+/************************************************************************
+    DEFINES AND TYPES
+************************************************************************/
+#define CONV_WORDS              0x10000U    /**< Register words (flags included) */
+#define CONV_Q4_MIN             (-8192)     /**< Q4 sweep, twice the register range */
+#define CONV_Q4_MAX             8191
+#define CONV_Q4_COUNT           ((size_t)(CONV_Q4_MAX - CONV_Q4_MIN + 1))
+#define CONV_ROUNDS             200U        /**< Default timed sweeps per kernel */
+
+/** Timed kernel: convert the whole sweep once */
+typedef void (*Conv_Sweep_t)( MCP9808_Kernel_t kernel );
+
+/** Throughput entry */
+typedef struct
+{
+    const char*         name;       /**< Name in the report */
+    Conv_Sweep_t        sweep;      /**< Sweep function */
+    MCP9808_Kernel_t    kernel;     /**< Batch kernel (AUTO if not a batch variant) */
+    size_t              count;      /**< Conversions per sweep */
+}Conv_Entry_t;
+
+/* Sweep buffers */
+static uint8_t  Conv_Frames[CONV_WORDS * MCP9808_REG_SIZE];
+static int16_t  Conv_Q4[CONV_WORDS];
+static uint16_t Conv_Reg[CONV_WORDS];
+static uint8_t  Conv_Flags[CONV_WORDS];
+#if MCP9808_USE_FLOAT
+static float    Conv_Temp[CONV_WORDS];      /* TempToReg input, set once before the sweeps */
+static float    Conv_TempOut[CONV_WORDS];   /* RegToTemp and DecodeBatch output */
+#endif /* MCP9808_USE_FLOAT */
+
+/* Keeps the timed results alive */
+static volatile uint32_t Conv_Sink;
+
+/************************************************************************
+    FUNCTIONS
+************************************************************************/
+
+/**
+ * @brief Get a monotonic time stamp.
+ *
+ * @return uint64_t Time (ns).
+ */
+static uint64_t Conv_Now( void )
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000000000ULL + (uint64_t)now.tv_nsec;
+}
+
+/**
+ * @brief Reference decoder, written from the datasheet and independent of
+ *        the driver: 13-bit two's complement, 1/16 °C per LSB.
+ *
+ * @param word Register word (flags included).
+ * @return int32_t Temperature in 1/16 °C.
+ */
+static int32_t Conv_RefQ4( uint32_t word )
+{
+    int32_t value = (int32_t)(word & 0x1FFFU);
+
+    return (value >= 0x1000) ? (value - 0x2000) : value;
+}
+
+/**
+ * @brief Reference limit encoder: nearest 0.25 °C step (halves towards
+ *        +inf), saturated to -256 °C .. +255.75 °C.
+ *
+ * @param q4 Temperature in 1/16 °C.
+ * @return uint16_t Limit register word.
+ */
+static uint16_t Conv_RefLimit( int32_t q4 )
+{
+    int32_t steps = q4 / 4;
+    int32_t rest = q4 - steps * 4;
+
+    /* Floor division, then round up on two sixteenths or more */
+    if( rest < 0 )
+    {
+        steps--;
+        rest += 4;
+    }
+    if( rest >= 2 )
+    {
+        steps++;
+    }
+    steps = (steps > 1023) ? 1023 : ((steps < -1024) ? -1024 : steps);
+
+    return (uint16_t)((uint32_t)(steps * 4) & 0x1FFCU);
+}
+
+/**
+ * @brief Print the result line of a check.
+ *
+ * @param name Check name.
+ * @param cases Number of cases.
+ * @param errors Number of wrong conversions.
+ * @return uint32_t errors.
+ */
+static uint32_t Conv_Report( const char* name, size_t cases, uint32_t errors )
+{
+    printf("{\"check\":\"%s\",\"cases\":%lu,\"errors\":%lu,\"ok\":%s}\n",
+           name, (unsigned long)cases, (unsigned long)errors, (errors == 0U) ? "true" : "false");
+    return errors;
+}
+
+/**
+ * @brief Print the first failures of a check.
+ */
+#define CONV_FAIL(errors, ...)      do { if( (errors)++ < 8U ) { fprintf(stderr, __VA_ARGS__); } } while( 0 )
+
+/**
+ * @brief Every register word: decode to Q4 and float, flags must be ignored.
+ *
+ * @return uint32_t Wrong conversions.
+ */
+static uint32_t Conv_CheckDecode( void )
+{
+    uint32_t errors = 0;
+    uint32_t word = 0;
+    int16_t q4 = 0;
+#if MCP9808_USE_FLOAT
+    uint8_t regData[MCP9808_REG_SIZE];
+    float temperature = 0.0f;
+#endif /* MCP9808_USE_FLOAT */
+
+    for( word = 0; word < CONV_WORDS; word++ )
+    {
+        q4 = MCP9808_RegToQ4((uint16_t)word);
+        if( q4 != Conv_RefQ4(word) )
+        {
+            CONV_FAIL(errors, "RegToQ4(0x%04lX) = %d, expected %ld\n",
+                      (unsigned long)word, q4, (long)Conv_RefQ4(word));
+        }
+#if MCP9808_USE_FLOAT
+        regData[MCP9808_MSB] = (uint8_t)(word >> 8);
+        regData[MCP9808_LSB] = (uint8_t)word;
+        temperature = -1000.0f;
+        if( IS_MCP9808_ERROR(MCP9808_RegToTemp(regData, &temperature)) ||
+            ((double)temperature != (double)Conv_RefQ4(word) / 16.0) ||
+            (regData[MCP9808_MSB] != (uint8_t)(word >> 8)) || (regData[MCP9808_LSB] != (uint8_t)word) )
+        {
+            CONV_FAIL(errors, "RegToTemp(0x%04lX) = %.4f, expected %.4f\n",
+                      (unsigned long)word, (double)temperature, (double)Conv_RefQ4(word) / 16.0);
+        }
+#endif /* MCP9808_USE_FLOAT */
+    }
+
+    return Conv_Report("decode", CONV_WORDS, errors);
+}
+
+/**
+ * @brief Every limit value (0.25 °C steps, -256 °C .. +255.75 °C): encode and
+ *        decode back, both paths must round trip exactly.
+ *
+ * @return uint32_t Wrong conversions.
+ */
+static uint32_t Conv_CheckLimits( void )
+{
+    uint32_t errors = 0;
+    size_t cases = 0;
+    int32_t q4 = 0;
+    uint16_t reg = 0;
+#if MCP9808_USE_FLOAT
+    uint8_t regData[MCP9808_REG_SIZE];
+    float temperature = 0.0f;
+    float back = 0.0f;
+#endif /* MCP9808_USE_FLOAT */
+
+    for( q4 = MCP9808_LIMIT_MIN_Q4; q4 <= MCP9808_LIMIT_MAX_Q4; q4 += 4 )
+    {
+        cases++;
+        reg = MCP9808_Q4ToReg((int16_t)q4);
+        if( (reg != ((uint16_t)q4 & MCP9808_LIMIT_MSK)) || (MCP9808_RegToQ4(reg) != q4) )
+        {
+            CONV_FAIL(errors, "Q4ToReg(%ld) = 0x%04X\n", (long)q4, reg);
+        }
+#if MCP9808_USE_FLOAT
+        temperature = (float)q4 / 16.0f;
+        if( IS_MCP9808_ERROR(MCP9808_TempToReg(regData, &temperature)) ||
+            (((regData[MCP9808_MSB] << 8) | regData[MCP9808_LSB]) != reg) ||
+            IS_MCP9808_ERROR(MCP9808_RegToTemp(regData, &back)) || (back != temperature) )
+        {
+            CONV_FAIL(errors, "TempToReg(%.4f) = 0x%02X%02X -> %.4f\n", (double)temperature,
+                      regData[MCP9808_MSB], regData[MCP9808_LSB], (double)back);
+        }
+#endif /* MCP9808_USE_FLOAT */
+    }
+
+    return Conv_Report("limits", cases, errors);
+}
+
+/**
+ * @brief Every Q4 value over twice the register range: rounding to the
+ *        0.25 °C grid and saturation. Both encoders must agree with the
+ *        reference.
+ *
+ * @return uint32_t Wrong conversions.
+ */
+static uint32_t Conv_CheckEncode( void )
+{
+    uint32_t errors = 0;
+    int32_t q4 = 0;
+#if MCP9808_USE_FLOAT
+    uint8_t regData[MCP9808_REG_SIZE];
+    float temperature = 0.0f;
+#endif /* MCP9808_USE_FLOAT */
+
+    for( q4 = CONV_Q4_MIN; q4 <= CONV_Q4_MAX; q4++ )
+    {
+        if( MCP9808_Q4ToReg((int16_t)q4) != Conv_RefLimit(q4) )
+        {
+            CONV_FAIL(errors, "Q4ToReg(%ld) = 0x%04X, expected 0x%04X\n",
+                      (long)q4, MCP9808_Q4ToReg((int16_t)q4), Conv_RefLimit(q4));
+        }
+#if MCP9808_USE_FLOAT
+        temperature = (float)q4 / 16.0f;
+        if( IS_MCP9808_ERROR(MCP9808_TempToReg(regData, &temperature)) ||
+            (((regData[MCP9808_MSB] << 8) | regData[MCP9808_LSB]) != Conv_RefLimit(q4)) )
+        {
+            CONV_FAIL(errors, "TempToReg(%.4f) = 0x%02X%02X, expected 0x%04X\n", (double)temperature,
+                      regData[MCP9808_MSB], regData[MCP9808_LSB], Conv_RefLimit(q4));
+        }
+#endif /* MCP9808_USE_FLOAT */
+    }
+
+    return Conv_Report("encode", CONV_Q4_COUNT, errors);
+}
+
+#if MCP9808_USE_FLOAT
+/**
+ * @brief Float inputs the Q4 sweep can not produce: values just around the
+ *        rounding points, signed zero, infinities and NaN.
+ *
+ * @return uint32_t Wrong conversions.
+ */
+static uint32_t Conv_CheckSpecial( void )
+{
+    static const struct
+    {
+        float       temperature;
+        uint16_t    reg;        /* 0xFFFF: must be rejected */
+    }cases[] =
+    {
+        {  0.0f,            0x0000U },
+        { -0.0f,            0x0000U },
+        {  0.1249999f,      0x0000U },
+        {  0.125f,          0x0004U },
+        { -0.125f,          0x0000U },
+        { -0.1250001f,      0x1FFCU },
+        {  0.4999999f,      0x0008U },
+        { -1e-30f,          0x0000U },
+        {  1e-30f,          0x0000U },
+        {  25.3f,           0x0194U },
+        { -40.1f,           0x1D80U },
+        {  255.75f,         0x0FFCU },
+        {  255.9f,          0x0FFCU },
+        {  1e9f,            0x0FFCU },
+        { -256.0f,          0x1000U },
+        { -256.2f,          0x1000U },
+        { -1e9f,            0x1000U },
+        {  1.0f / 0.0f,     0x0FFCU },
+        { -1.0f / 0.0f,     0x1000U },
+        {  0.0f / 0.0f,     0xFFFFU },
+    };
+    uint32_t errors = 0;
+    uint8_t regData[MCP9808_REG_SIZE];
+    MCP9808_Error_t error = MCP9808_ERROR;
+    size_t i = 0;
+
+    for( i = 0; i < (sizeof(cases) / sizeof(cases[0])); i++ )
+    {
+        regData[MCP9808_MSB] = 0xEE;
+        regData[MCP9808_LSB] = 0xEE;
+        error = MCP9808_TempToReg(regData, &cases[i].temperature);
+        if( (cases[i].reg == 0xFFFFU) ? !IS_MCP9808_ERROR(error) :
+            (IS_MCP9808_ERROR(error) || (((regData[MCP9808_MSB] << 8) | regData[MCP9808_LSB]) != cases[i].reg)) )
+        {
+            CONV_FAIL(errors, "TempToReg(%g) = 0x%02X%02X (%d), expected 0x%04X\n", (double)cases[i].temperature,
+                      regData[MCP9808_MSB], regData[MCP9808_LSB], (int)error, cases[i].reg);
+        }
+    }
+
+    return Conv_Report("special", sizeof(cases) / sizeof(cases[0]), errors);
+}
+#endif /* MCP9808_USE_FLOAT */
+
+/**
+ * @brief Every register word through each available batch kernel.
+ *
+ * @return uint32_t Wrong conversions.
+ */
+static uint32_t Conv_CheckBatch( void )
+{
+    static const MCP9808_Kernel_t kernels[] =
+    {
+        MCP9808_KERNEL_SCALAR, MCP9808_KERNEL_SSE2, MCP9808_KERNEL_AVX2, MCP9808_KERNEL_NEON
+    };
+    uint32_t errors = 0;
+    size_t cases = 0;
+    size_t k = 0;
+    uint32_t word = 0;
+
+    for( k = 0; k < (sizeof(kernels) / sizeof(kernels[0])); k++ )
+    {
+        if( !MCP9808_IsKernelAvailable(kernels[k]) )
+        {
+            continue;
+        }
+
+        memset(Conv_Q4, 0, sizeof(Conv_Q4));
+        memset(Conv_Flags, 0xFF, sizeof(Conv_Flags));
+        if( IS_MCP9808_ERROR(MCP9808_DecodeBatchQ4Kernel(kernels[k], Conv_Frames, CONV_WORDS, Conv_Q4, Conv_Flags)) )
+        {
+            CONV_FAIL(errors, "DecodeBatchQ4Kernel(%d) failed\n", (int)kernels[k]);
+        }
+        for( word = 0; word < CONV_WORDS; word++ )
+        {
+            if( (Conv_Q4[word] != Conv_RefQ4(word)) || (Conv_Flags[word] != (word >> 13)) )
+            {
+                CONV_FAIL(errors, "DecodeBatchQ4Kernel(%d, 0x%04lX) = %d/%u\n",
+                          (int)kernels[k], (unsigned long)word, Conv_Q4[word], Conv_Flags[word]);
+            }
+        }
+        cases += CONV_WORDS;
+
+#if MCP9808_USE_FLOAT
+        memset(Conv_TempOut, 0, sizeof(Conv_TempOut));
+        memset(Conv_Flags, 0xFF, sizeof(Conv_Flags));
+        if( IS_MCP9808_ERROR(MCP9808_DecodeBatchKernel(kernels[k], Conv_Frames, CONV_WORDS, Conv_TempOut, Conv_Flags)) )
+        {
+            CONV_FAIL(errors, "DecodeBatchKernel(%d) failed\n", (int)kernels[k]);
+        }
+        for( word = 0; word < CONV_WORDS; word++ )
+        {
+            if( ((double)Conv_TempOut[word] != (double)Conv_RefQ4(word) / 16.0) || (Conv_Flags[word] != (word >> 13)) )
+            {
+                CONV_FAIL(errors, "DecodeBatchKernel(%d, 0x%04lX) = %.4f/%u\n",
+                          (int)kernels[k], (unsigned long)word, (double)Conv_TempOut[word], Conv_Flags[word]);
+            }
+        }
+        cases += CONV_WORDS;
+#endif /* MCP9808_USE_FLOAT */
+    }
+
+    return Conv_Report("batch", cases, errors);
+}
+
+/* Timed sweeps */
+#if MCP9808_USE_FLOAT
+static void Conv_SweepRegToTemp( MCP9808_Kernel_t kernel )
+{
+    size_t i = 0;
+
+    (void)kernel;
+    for( i = 0; i < CONV_WORDS; i++ )
+    {
+        (void)MCP9808_RegToTemp(&Conv_Frames[i * MCP9808_REG_SIZE], &Conv_TempOut[i]);
+    }
+    Conv_Sink += (uint32_t)Conv_TempOut[CONV_WORDS / 3U];
+}
+
+static void Conv_SweepTempToReg( MCP9808_Kernel_t kernel )
+{
+    uint8_t regData[MCP9808_REG_SIZE] = { 0, 0 };
+    size_t i = 0;
+
+    (void)kernel;
+    for( i = 0; i < CONV_Q4_COUNT; i++ )
+    {
+        (void)MCP9808_TempToReg(regData, &Conv_Temp[i]);
+        Conv_Reg[i] = (regData[MCP9808_MSB] << 8) | regData[MCP9808_LSB];
+    }
+    Conv_Sink += Conv_Reg[CONV_Q4_COUNT / 3U];
+}
+#endif /* MCP9808_USE_FLOAT */
+
+static void Conv_SweepRegToQ4( MCP9808_Kernel_t kernel )
+{
+    size_t i = 0;
+
+    (void)kernel;
+    for( i = 0; i < CONV_WORDS; i++ )
+    {
+        Conv_Q4[i] = MCP9808_RegToQ4((uint16_t)i);
+    }
+    Conv_Sink += (uint32_t)Conv_Q4[CONV_WORDS / 3U];
+}
+
+static void Conv_SweepQ4ToReg( MCP9808_Kernel_t kernel )
+{
+    size_t i = 0;
+
+    (void)kernel;
+    for( i = 0; i < CONV_Q4_COUNT; i++ )
+    {
+        Conv_Reg[i] = MCP9808_Q4ToReg((int16_t)(CONV_Q4_MIN + (int32_t)i));
+    }
+    Conv_Sink += Conv_Reg[CONV_Q4_COUNT / 3U];
+}
+
+static void Conv_SweepBatchQ4( MCP9808_Kernel_t kernel )
+{
+    (void)MCP9808_DecodeBatchQ4Kernel(kernel, Conv_Frames, CONV_WORDS, Conv_Q4, Conv_Flags);
+    Conv_Sink += (uint32_t)Conv_Q4[CONV_WORDS / 3U];
+}
+
+#if MCP9808_USE_FLOAT
+static void Conv_SweepBatch( MCP9808_Kernel_t kernel )
+{
+    (void)MCP9808_DecodeBatchKernel(kernel, Conv_Frames, CONV_WORDS, Conv_TempOut, Conv_Flags);
+    Conv_Sink += (uint32_t)Conv_TempOut[CONV_WORDS / 3U];
+}
+#endif /* MCP9808_USE_FLOAT */
+
+static const Conv_Entry_t Conv_Entries[] =
+{
+#if MCP9808_USE_FLOAT
+    { "RegToTemp",              Conv_SweepRegToTemp,    MCP9808_KERNEL_AUTO,    CONV_WORDS },
+    { "TempToReg",              Conv_SweepTempToReg,    MCP9808_KERNEL_AUTO,    CONV_Q4_COUNT },
+#endif /* MCP9808_USE_FLOAT */
+    { "RegToQ4",                Conv_SweepRegToQ4,      MCP9808_KERNEL_AUTO,    CONV_WORDS },
+    { "Q4ToReg",                Conv_SweepQ4ToReg,      MCP9808_KERNEL_AUTO,    CONV_Q4_COUNT },
+    { "DecodeBatchQ4/scalar",   Conv_SweepBatchQ4,      MCP9808_KERNEL_SCALAR,  CONV_WORDS },
+    { "DecodeBatchQ4/sse2",     Conv_SweepBatchQ4,      MCP9808_KERNEL_SSE2,    CONV_WORDS },
+    { "DecodeBatchQ4/avx2",     Conv_SweepBatchQ4,      MCP9808_KERNEL_AVX2,    CONV_WORDS },
+    { "DecodeBatchQ4/neon",     Conv_SweepBatchQ4,      MCP9808_KERNEL_NEON,    CONV_WORDS },
+#if MCP9808_USE_FLOAT
+    { "DecodeBatch/scalar",     Conv_SweepBatch,        MCP9808_KERNEL_SCALAR,  CONV_WORDS },
+    { "DecodeBatch/sse2",       Conv_SweepBatch,        MCP9808_KERNEL_SSE2,    CONV_WORDS },
+    { "DecodeBatch/avx2",       Conv_SweepBatch,        MCP9808_KERNEL_AVX2,    CONV_WORDS },
+    { "DecodeBatch/neon",       Conv_SweepBatch,        MCP9808_KERNEL_NEON,    CONV_WORDS },
+#endif /* MCP9808_USE_FLOAT */
+};
+
+/**
+ * @brief Time a kernel variant and print its result line. Variants whose
+ *        batch kernel is not in this build are skipped.
+ *
+ * @param entry Kernel variant.
+ * @param rounds Number of sweeps.
+ */
+static void Conv_Run( const Conv_Entry_t* entry, uint32_t rounds )
+{
+    uint64_t start = 0;
+    uint64_t elapsed = 0;
+    uint64_t conversions = (uint64_t)entry->count * rounds;
+    uint32_t i = 0;
+
+    if( (entry->kernel == MCP9808_KERNEL_AUTO) || MCP9808_IsKernelAvailable(entry->kernel) )
+    {
+        /* Warm up caches and branch predictors */
+        entry->sweep(entry->kernel);
+
+        start = Conv_Now();
+        for( i = 0; i < rounds; i++ )
+        {
+            entry->sweep(entry->kernel);
+        }
+        elapsed = Conv_Now() - start;
+        elapsed = (elapsed == 0U) ? 1U : elapsed;
+
+        printf("{\"kernel\":\"%s\",\"conversions\":%llu,\"ns_per_conversion\":%.3f,\"conversions_per_s\":%.0f}\n",
+               entry->name, (unsigned long long)conversions, (double)elapsed / (double)conversions,
+               (double)conversions * 1e9 / (double)elapsed);
+    }
+}
+
+int main( int argc, char** argv )
+{
+    uint32_t rounds = CONV_ROUNDS;
+    uint32_t errors = 0;
+    size_t i = 0;
+    int arg = 0;
+
+    for( arg = 1; (arg + 1) < argc; arg += 2 )
+    {
+        if( strcmp(argv[arg], "-r") == 0 )
+        {
+            rounds = (uint32_t)strtoul(argv[arg + 1], NULL, 0);
+        }
+    }
+    rounds = (rounds == 0U) ? 1U : rounds;
+
+    /* Sweep inputs: every register word, every Q4 value */
+    for( i = 0; i < CONV_WORDS; i++ )
+    {
+        Conv_Frames[i * MCP9808_REG_SIZE + MCP9808_MSB] = (uint8_t)(i >> 8);
+        Conv_Frames[i * MCP9808_REG_SIZE + MCP9808_LSB] = (uint8_t)i;
+    }
+
+    errors += Conv_CheckDecode();
+    errors += Conv_CheckLimits();
+    errors += Conv_CheckEncode();
+#if MCP9808_USE_FLOAT
+    errors += Conv_CheckSpecial();
+#endif /* MCP9808_USE_FLOAT */
+    errors += Conv_CheckBatch();
+
+#if MCP9808_USE_FLOAT
+    for( i = 0; i < CONV_Q4_COUNT; i++ )
+    {
+        Conv_Temp[i] = (float)(CONV_Q4_MIN + (int32_t)i) / 16.0f;
+    }
+#endif /* MCP9808_USE_FLOAT */
+    for( i = 0; i < (sizeof(Conv_Entries) / sizeof(Conv_Entries[0])); i++ )
+    {
+        Conv_Run(&Conv_Entries[i], rounds);
+    }
+
+    return (errors == 0U) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -26,8 +26,14 @@
 /************************************************************************
 	INCLUDES
 ************************************************************************/
+#include <stdio.h>
 #include <stdlib.h>
 #include "MCP9808.h"
+#if MCP9808_USE_STATS || MCP9808_USE_ONESHOT
+#include "MCP9808_port.h"
+#else
+#include <time.h>
+#endif /* MCP9808_USE_STATS || MCP9808_USE_ONESHOT */
 
 /************************************************************************
  	DEFINES AND TYPES
@@ -38,16 +44,40 @@
 #define LOWER_TEMP      12.5
 #define CRIT_TEMP       45.75
 
+#define GET_TIME_US()   Example_GetTimeUs()
+
 
 /************************************************************************
     FUNCTIONS
 ************************************************************************/
+
+/**
+ * @brief Free running microsecond counter for the sampler: the port clock
+ *        when the port provides one, the POSIX monotonic clock otherwise.
+ *
+ * @return uint32_t Current time (us, wraps around).
+ */
+static uint32_t Example_GetTimeUs( void )
+{
+#if MCP9808_USE_STATS || MCP9808_USE_ONESHOT
+    return MCP9808_PORT_GetTimeUs(NULL);
+#else
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint32_t)((uint64_t)now.tv_sec * 1000000U + (uint64_t)now.tv_nsec / 1000U);
+#endif /* MCP9808_USE_STATS || MCP9808_USE_ONESHOT */
+}
+
 void main( void )
 {
-    float temperature = 0.0;
+    MCP9808_Device_t sensor;
+    MCP9808_Sampler_t sampler;
+    int16_t temperature = 0;
+    uint32_t age = 0;
     MCP9808_Error_t result;
 
-    result = MCP9808_Init(DEV_ADDRESS);
+    result = MCP9808_Init(&sensor, NULL, DEV_ADDRESS);
 
     if( result != MCP9808_OK )
     {
@@ -58,17 +88,32 @@ void main( void )
         }
     }
    /* Temperature window example (not needed) */
-    MCP9808_SetCriticalTemperature(CRIT_TEMP);
-    MCP9808_SetWindowTemperature(UPPER_TEMP, LOWER_TEMP);
+#if MCP9808_USE_FLOAT
+    MCP9808_SetCriticalTemperature(&sensor, CRIT_TEMP);
+    MCP9808_SetWindowTemperature(&sensor, UPPER_TEMP, LOWER_TEMP);
+#else
+    MCP9808_SetCriticalTemperatureQ4(&sensor, (int16_t)(CRIT_TEMP * MCP9808_Q4_ONE));
+    MCP9808_SetWindowTemperatureQ4(&sensor, (int16_t)(UPPER_TEMP * MCP9808_Q4_ONE),
+                                   (int16_t)(LOWER_TEMP * MCP9808_Q4_ONE));
+#endif /* MCP9808_USE_FLOAT */
+
+    /* TA is only read once the maximum conversion time has elapsed */
+    MCP9808_SamplerInit(&sampler, &sensor);
 
     while( 1 )
     {
-        result = MCP9808_ReadTemperature(&temperature);
-        if( result == MCP9808_OK )
+        result = MCP9808_SamplerRead(&sampler, GET_TIME_US(), &temperature, &age);
+        if( (result == MCP9808_OK) && (age == 0U) )
         {
-            printf("Temperature %.2lf",temperature);
+#if MCP9808_USE_FLOAT
+            printf("Temperature %.2lf", (double)temperature / MCP9808_Q4_ONE);
+#else
+            /* No floating point: whole degrees and hundredths */
+            printf("Temperature %s%d.%02d", (temperature < 0) ? "-" : "",
+                   abs(temperature) / MCP9808_Q4_ONE, (abs(temperature) % MCP9808_Q4_ONE) * 100 / MCP9808_Q4_ONE);
+#endif /* MCP9808_USE_FLOAT */
         }
-        else
+        else if( result != MCP9808_OK )
         {
             printf("Error reading temperature! \n");
         }
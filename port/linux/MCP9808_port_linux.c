@@ -0,0 +1,385 @@
+/**                             _____________
+ *              /\      /\     /             \
+ *             //\\____//\\   |   MAUUUU!!    |
+ *            /     '      \   \  ___________/
+ *           /   /\ '  /\    \ /_/			      / /  ___    / __\ |__   __ _| |_ 
+ *          |    == o ==      |       /|	     / /  / _ \  / /  | '_ \ / _` | __|
+ *           \      '        /       | |	    / /__|  __/ / /___| | | | (_| | |_ 
+ *             \           /         \ \	    \____/\___| \____/|_| |_|\__,_|\__|
+ *             /----<o>---- \         / /
+ *             |            ' \       \ \
+ *             |    |    | '   '\      \ \
+ *  _________  | ´´ |  ' |     '  \    / /
+ *  |  MAYA  | |  ' |    | '       |__/ /
+ *   \______/   \__/ \__/ \_______/____/
+ * 
+ * @file MCP9808_port_linux.c
+ * @author Alejandro Gomez Molina (@Alejo2312)
+ * @brief Linux i2c-dev port layer for MPC9808 driver. Every transfer is a
+ * 		single I2C_RDWR ioctl, so register reads use a repeated start
+ * 		between the pointer write and the data read.
+ * @version 0.1
+ * @date Mar 22, 2022
+ * 
+ * @copyright Copyright (c) 2022
+ * 
+ */
+
+/************************************************************************
+	INCLUDES
+************************************************************************/
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include "MCP9808_port_linux.h"
+/************************************************************************
+ 	DEFINES AND TYPES
+************************************************************************/
+
+
+/************************************************************************
+	DECLARATIONS
+************************************************************************/
+
+
+/************************************************************************
+	FUNCTIONS
+************************************************************************/
+
+/**
+ * @brief Submit an I2C_RDWR transfer, to the kernel or to the transfer hook.
+ *
+ * @param bus Linux bus context.
+ * @param msgs Messages.
+ * @param nmsgs Number of messages.
+ * @return error_t NO_ERROR if every message has been transferred otherwise, SYS_ERROR
+ */
+static MCP9808_Error_t MCP9808_LINUX_Xfer(MCP9808_LINUX_Bus_t* bus, struct i2c_msg* msgs, uint32_t nmsgs)
+{
+	struct i2c_rdwr_ioctl_data xfer = { .msgs = msgs, .nmsgs = nmsgs };
+	int result = -1;
+
+	if( bus->xfer != NULL )
+	{
+		result = bus->xfer(bus->xferContext, &xfer);
+	}
+	else if( bus->fd >= 0 )
+	{
+		result = ioctl(bus->fd, I2C_RDWR, &xfer);
+	}
+
+	return (result == (int)nmsgs) ? MCP9808_OK : MCP9808_ERROR;
+}
+
+/**
+ * @brief Initialize a Linux bus context. The adapter is opened by MCP9808_PORT_Init().
+ *
+ * @param bus Linux bus context storage.
+ * @param path Adapter device, e.g. "/dev/i2c-1".
+ * @return error_t NO_ERROR if the context has been initialized otherwise, SYS_ERROR
+ */
+MCP9808_Error_t MCP9808_LINUX_BusInit( MCP9808_LINUX_Bus_t* bus, const char* path )
+{
+	MCP9808_Error_t error = MCP9808_ERROR;
+
+	if( bus != NULL )
+	{
+		memset(bus, 0, sizeof(*bus));
+		bus->path = path;
+		bus->fd = -1;
+		error = MCP9808_OK;
+	}
+
+	return error;
+}
+
+/**
+ * @brief Replace the I2C_RDWR ioctl with a user function. It allows running
+ * 		the port (and the driver) without kernel nor hardware, e.g. to
+ * 		check the generated messages or to plug a simulated device.
+ *
+ * @param bus Linux bus context.
+ * @param xfer Transfer hook (NULL to go back to the kernel).
+ * @param context Transfer hook context.
+ * @return error_t NO_ERROR if the hook has been set otherwise, SYS_ERROR
+ */
+MCP9808_Error_t MCP9808_LINUX_BusSetXfer( MCP9808_LINUX_Bus_t* bus, MCP9808_LINUX_Xfer_t xfer, void* context )
+{
+	MCP9808_Error_t error = MCP9808_ERROR;
+
+	if( bus != NULL )
+	{
+		bus->xfer = xfer;
+		bus->xferContext = context;
+		error = MCP9808_OK;
+	}
+
+	return error;
+}
+
+/**
+ * @brief Close the adapter.
+ *
+ * @param bus Linux bus context.
+ * @return error_t NO_ERROR if the adapter has been closed otherwise, SYS_ERROR
+ */
+MCP9808_Error_t MCP9808_LINUX_BusClose( MCP9808_LINUX_Bus_t* bus )
+{
+	MCP9808_Error_t error = MCP9808_ERROR;
+
+	if( bus != NULL )
+	{
+		error = MCP9808_OK;
+		if( bus->fd >= 0 )
+		{
+			error = (close(bus->fd) == 0) ? MCP9808_OK : MCP9808_ERROR;
+			bus->fd = -1;
+		}
+	}
+
+	return error;
+}
+
+/**
+ * @brief Open the adapter. It is opened only once and kept open across
+ * 		calls, so it can be called for every device on the bus.
+ *
+ * @param bus Linux bus context (MCP9808_LINUX_Bus_t).
+ * @return error_t NO_ERROR if the device has been configured otherwise, SYS_ERROR.
+ */
+MCP9808_Error_t MCP9808_PORT_Init( void* bus )
+{
+	MCP9808_LINUX_Bus_t* linuxBus = (MCP9808_LINUX_Bus_t*)bus;
+	MCP9808_Error_t error = MCP9808_ERROR;
+
+	if( linuxBus != NULL )
+	{
+		if( (linuxBus->xfer != NULL) || (linuxBus->fd >= 0) )
+		{
+			error = MCP9808_OK;
+		}
+		else if( linuxBus->path != NULL )
+		{
+			linuxBus->fd = open(linuxBus->path, O_RDWR | O_CLOEXEC);
+			error = (linuxBus->fd >= 0) ? MCP9808_OK : MCP9808_ERROR;
+		}
+	}
+
+	return error;
+}
+
+/**
+ * @brief Read a register with a combined transaction (one ioctl).
+ * 		| S |  ADDR  | W | A | REG | A | Sr |  ADDR  | R | A | DATA0 | ---- | DATAN | N | P |
+ *
+ * @param bus Linux bus context (MCP9808_LINUX_Bus_t).
+ * @param address Slave address
+ * @param reg Register/command to be read
+ * @param size Register size in byte
+ * @param data Register data
+ * @return error_t NO_ERROR if the register has been read otherwise, SYS_ERROR
+ */
+MCP9808_Error_t MCP9808_PORT_Read(void* bus, uint8_t address, uint8_t reg, uint8_t size, uint8_t* data)
+{
+	struct i2c_msg msgs[2] =
+	{
+		{ .addr = address, .flags = 0, .len = 1, .buf = &reg },
+		{ .addr = address, .flags = I2C_M_RD, .len = size, .buf = data },
+	};
+
+	return (bus != NULL) ? MCP9808_LINUX_Xfer((MCP9808_LINUX_Bus_t*)bus, msgs, 2U) : MCP9808_ERROR;
+}
+
+/**
+ * @brief Write a register (one ioctl).
+ * 		| S |  ADDR  | W | A | REG | A | DATA0 | A | ---- | DATAN | A | P |
+ *
+ * @param bus Linux bus context (MCP9808_LINUX_Bus_t).
+ * @param address Slave address
+ * @param reg Register/command to be written
+ * @param size Register size in byte
+ * @param data Register data
+ * @return error_t NO_ERROR if the register has been written otherwise, SYS_ERROR
+ */
+MCP9808_Error_t MCP9808_PORT_Write(void* bus, uint8_t address, uint8_t reg, uint8_t size, uint8_t* data)
+{
+	uint8_t buffer[1 + MCP9808_REG_SIZE];
+	struct i2c_msg msg = { .addr = address, .flags = 0, .len = 1U + size, .buf = buffer };
+	MCP9808_Error_t error = MCP9808_ERROR;
+
+	if( (bus != NULL) && (size <= MCP9808_REG_SIZE) )
+	{
+		buffer[0] = reg;
+		memcpy(&buffer[1], data, size);
+		error = MCP9808_LINUX_Xfer((MCP9808_LINUX_Bus_t*)bus, &msg, 1U);
+	}
+
+	return error;
+}
+
+#if MCP9808_USE_STICKY_POINTER
+/**
+ * @brief Read the register the device pointer is already set to (one ioctl,
+ * 		no pointer byte).
+ * 		| S |  ADDR  | R | A | DATA0 | ---- | DATAN | N | P |
+ *
+ * @param bus Linux bus context (MCP9808_LINUX_Bus_t).
+ * @param address Slave address
+ * @param size Register size in byte
+ * @param data Register data
+ * @return error_t NO_ERROR if the register has been read otherwise, SYS_ERROR
+ */
+MCP9808_Error_t MCP9808_PORT_ReadCurrent(void* bus, uint8_t address, uint8_t size, uint8_t* data)
+{
+	struct i2c_msg msg = { .addr = address, .flags = I2C_M_RD, .len = size, .buf = data };
+
+	return (bus != NULL) ? MCP9808_LINUX_Xfer((MCP9808_LINUX_Bus_t*)bus, &msg, 1U) : MCP9808_ERROR;
+}
+#endif /* MCP9808_USE_STICKY_POINTER */
+
+#if MCP9808_USE_MULTI
+/**
+ * @brief Read the same register of several devices with a single ioctl.
+ * 		Each device gets its own combined pointer write + data read pair.
+ * 		| S | ADDR0 | W | A | REG | A | Sr | ADDR0 | R | A | DATA | N | Sr | ADDR1 | W | ---- | ADDRN | R | A | DATA | N | P |
+ *
+ * @param bus Linux bus context (MCP9808_LINUX_Bus_t).
+ * @param addresses Slave addresses
+ * @param count Number of devices (up to MCP9808_MULTI_MAX)
+ * @param reg Register/command to be read
+ * @param size Register size in byte
+ * @param data Register data, "size" bytes per device
+ * @return error_t NO_ERROR if every register has been read otherwise, SYS_ERROR
+ */
+MCP9808_Error_t MCP9808_PORT_ReadMulti(void* bus, const uint8_t* addresses, uint8_t count, uint8_t reg,
+									   uint8_t size, uint8_t* data)
+{
+	struct i2c_msg msgs[2U * MCP9808_MULTI_MAX];
+	MCP9808_Error_t error = MCP9808_ERROR;
+	uint8_t i = 0;
+
+	if( (bus != NULL) && (count <= MCP9808_MULTI_MAX) && ((2U * count) <= I2C_RDWR_IOCTL_MAX_MSGS) )
+	{
+		for( i = 0; i < count; i++ )
+		{
+			msgs[2U * i].addr = addresses[i];
+			msgs[2U * i].flags = 0;
+			msgs[2U * i].len = 1;
+			msgs[2U * i].buf = &reg;
+			msgs[2U * i + 1U].addr = addresses[i];
+			msgs[2U * i + 1U].flags = I2C_M_RD;
+			msgs[2U * i + 1U].len = size;
+			msgs[2U * i + 1U].buf = &data[i * size];
+		}
+		error = MCP9808_LINUX_Xfer((MCP9808_LINUX_Bus_t*)bus, msgs, 2U * count);
+	}
+
+	return error;
+}
+#endif /* MCP9808_USE_MULTI */
+
+#if MCP9808_USE_STATS || MCP9808_USE_ONESHOT
+/**
+ * @brief Monotonic clock, in microseconds.
+ *
+ * @param bus Bus context (MCP9808_LINUX_Bus_t), unused.
+ * @return uint32_t Current time (us).
+ */
+uint32_t MCP9808_PORT_GetTimeUs(void* bus)
+{
+	struct timespec now;
+
+	(void)bus;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+
+	return (uint32_t)((uint64_t)now.tv_sec * 1000000ULL + (uint64_t)now.tv_nsec / 1000U);
+}
+#endif /* MCP9808_USE_STATS || MCP9808_USE_ONESHOT */
+
+#if MCP9808_USE_ONESHOT
+/**
+ * @brief Sleep for the device conversion.
+ *
+ * @param bus Bus context (MCP9808_LINUX_Bus_t), unused.
+ * @param us Time to wait (us).
+ */
+void MCP9808_PORT_DelayUs(void* bus, uint32_t us)
+{
+	struct timespec delay;
+
+	(void)bus;
+	delay.tv_sec = us / 1000000U;
+	delay.tv_nsec = (long)(us % 1000000U) * 1000L;
+	while( (nanosleep(&delay, &delay) != 0) && (errno == EINTR) )
+	{
+		/* Interrupted by a signal: sleep the remaining time */
+	}
+}
+#endif /* MCP9808_USE_ONESHOT */
+
+#if MCP9808_USE_ALERT_PIN
+/**
+ * @brief The ALERT pin is not part of the I2C adapter: GPIO handling is
+ * 		left to the application (e.g. libgpiod line events), which calls
+ * 		MCP9808_AlertNotify() on each asserting edge.
+ *
+ * @param bus Bus context (MCP9808_LINUX_Bus_t).
+ * @param address Slave address
+ * @param callback Edge callback, NULL to detach the pin
+ * @param context Callback context
+ * @return error_t NO_ERROR when detaching, SYS_ERROR otherwise
+ */
+MCP9808_Error_t MCP9808_PORT_AlertAttach(void* bus, uint8_t address, MCP9808_PORT_Alert_t callback, void* context)
+{
+	(void)bus;
+	(void)address;
+	(void)context;
+
+	return (callback == NULL) ? MCP9808_OK : MCP9808_ERROR;
+}
+#endif /* MCP9808_USE_ALERT_PIN */
+
+#if MCP9808_USE_ASYNC
+/**
+ * @brief i2c-dev transfers are blocking: the transfer is done and the
+ * 		callback called before returning.
+ *
+ * @param bus Linux bus context (MCP9808_LINUX_Bus_t).
+ * @param address Slave address
+ * @param reg Register/command to be read
+ * @param size Register size in byte
+ * @param data Register data
+ * @param callback Completion callback
+ * @param context Callback context
+ * @return error_t NO_ERROR if the transfer has been queued otherwise, SYS_ERROR
+ */
+MCP9808_Error_t MCP9808_PORT_ReadAsync(void* bus, uint8_t address, uint8_t reg, uint8_t size, uint8_t* data,
+									   MCP9808_PORT_Callback_t callback, void* context)
+{
+	callback(context, MCP9808_PORT_Read(bus, address, reg, size, data));
+	return MCP9808_OK;
+}
+
+/**
+ * @brief i2c-dev transfers are blocking: the transfer is done and the
+ * 		callback called before returning.
+ *
+ * @param bus Linux bus context (MCP9808_LINUX_Bus_t).
+ * @param address Slave address
+ * @param reg Register/command to be written
+ * @param size Register size in byte
+ * @param data Register data
+ * @param callback Completion callback
+ * @param context Callback context
+ * @return error_t NO_ERROR if the transfer has been queued otherwise, SYS_ERROR
+ */
+MCP9808_Error_t MCP9808_PORT_WriteAsync(void* bus, uint8_t address, uint8_t reg, uint8_t size, uint8_t* data,
+										MCP9808_PORT_Callback_t callback, void* context)
+{
+	callback(context, MCP9808_PORT_Write(bus, address, reg, size, data));
+	return MCP9808_OK;
+}
+#endif /* MCP9808_USE_ASYNC */
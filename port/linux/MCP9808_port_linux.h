@@ -0,0 +1,73 @@
+/**                             _____________
+ *              /\      /\     /             \
+ *             //\\____//\\   |   MAUUUU!!    |
+ *            /     '      \   \  ___________/
+ *           /   /\ '  /\    \ /_/			      / /  ___    / __\ |__   __ _| |_ 
+ *          |    == o ==      |       /|	     / /  / _ \  / /  | '_ \ / _` | __|
+ *           \      '        /       | |	    / /__|  __/ / /___| | | | (_| | |_ 
+ *             \           /         \ \	    \____/\___| \____/|_| |_|\__,_|\__|
+ *             /----<o>---- \         / /
+ *             |            ' \       \ \
+ *             |    |    | '   '\      \ \
+ *  _________  | ´´ |  ' |     '  \    / /
+ *  |  MAYA  | |  ' |    | '       |__/ /
+ *   \______/   \__/ \__/ \_______/____/
+ * 
+ * @file MCP9808_port_linux.h
+ * @author Alejandro Gomez Molina (@Alejo2312)
+ * @brief Linux i2c-dev port layer for MPC9808 driver.
+ * @version 0.1
+ * @date Mar 22, 2022
+ * 
+ * @copyright Copyright (c) 2022
+ * 
+ */
+#ifndef DRIVERS_INC_MCP9808_PORT_LINUX_H_
+#define DRIVERS_INC_MCP9808_PORT_LINUX_H_
+
+
+/************************************************************************
+	INCLUDES
+************************************************************************/
+#include <linux/i2c.h>
+#include <linux/i2c-dev.h>
+#include "MCP9808_port.h"
+
+/************************************************************************
+	DEFINES AND TYPES
+************************************************************************/
+
+/** Stand-in for the I2C_RDWR ioctl. Returns the number of messages done or -1. */
+typedef int (*MCP9808_LINUX_Xfer_t)( void* context, struct i2c_rdwr_ioctl_data* xfer );
+
+/** Bus context. Pass it as "bus" to MCP9808_Init(). */
+typedef struct
+{
+	const char*				path;		/**< Adapter device, e.g. "/dev/i2c-1" */
+	int						fd;			/**< Adapter file descriptor (-1 if closed) */
+	MCP9808_LINUX_Xfer_t	xfer;		/**< Transfer hook (NULL to use the kernel) */
+	void*					xferContext;/**< Transfer hook context */
+}MCP9808_LINUX_Bus_t;
+
+
+/************************************************************************
+	FUNCTIONS
+************************************************************************/
+
+/**
+  See "MCP9808_port_linux.c" for details of how to use this function.
+ */
+MCP9808_Error_t MCP9808_LINUX_BusInit( MCP9808_LINUX_Bus_t* bus, const char* path );
+
+/**
+  See "MCP9808_port_linux.c" for details of how to use this function.
+ */
+MCP9808_Error_t MCP9808_LINUX_BusSetXfer( MCP9808_LINUX_Bus_t* bus, MCP9808_LINUX_Xfer_t xfer, void* context );
+
+/**
+  See "MCP9808_port_linux.c" for details of how to use this function.
+ */
+MCP9808_Error_t MCP9808_LINUX_BusClose( MCP9808_LINUX_Bus_t* bus );
+
+
+#endif /* DRIVERS_INC_MCP9808_PORT_LINUX_H_ */
@@ -0,0 +1,942 @@
+/**                             _____________
+ *              /\      /\     /             \
+ *             //\\____//\\   |   MAUUUU!!    |
+ *            /     '      \   \  ___________/
+ *           /   /\ '  /\    \ /_/			      / /  ___    / __\ |__   __ _| |_ 
+ *          |    == o ==      |       /|	     / /  / _ \  / /  | '_ \ / _` | __|
+ *           \      '        /       | |	    / /__|  __/ / /___| | | | (_| | |_ 
+ *             \           /         \ \	    \____/\___| \____/|_| |_|\__,_|\__|
+ *             /----<o>---- \         / /
+ *             |            ' \       \ \
+ *             |    |    | '   '\      \ \
+ *  _________  | ´´ |  ' |     '  \    / /
+ *  |  MAYA  | |  ' |    | '       |__/ /
+ *   \______/   \__/ \__/ \_______/____/
+ * 
+ * @file MCP9808_port_sim.c
+ * @author Alejandro Gomez Molina (@Alejo2312)
+ * @brief Simulated MCP9808 devices implementing the port layer. Each
+ * 		MCP9808_SIM_Bus_t holds up to 8 devices and its own virtual
+ * 		clock, so thousands of devices can be simulated in one process
+ * 		(one bus per thread, no locking).
+ * 		The model covers the register pointer, CONFIG lock and
+ * 		interrupt clear semantics, shutdown, resolution dependent
+ * 		conversion time and the alert comparator/interrupt output.
+ * @version 0.1
+ * @date Mar 22, 2022
+ * 
+ * @copyright Copyright (c) 2022
+ * 
+ */
+
+/************************************************************************
+	INCLUDES
+************************************************************************/
+#include <string.h>
+#include <time.h>
+#include "MCP9808_port_sim.h"
+/************************************************************************
+ 	DEFINES AND TYPES
+************************************************************************/
+#define MCP9808_SIM_MANUFACTURER_ID	0x0054U		/**< Manufacturer ID register */
+#define MCP9808_SIM_DEVICE_ID		0x0400U		/**< Device ID/Revision register */
+#define MCP9808_SIM_MAX_STEPS		64U			/**< Conversions evaluated one by one when catching up */
+#define MCP9808_SIM_BIT_OVERHEAD	2U			/**< START/STOP per transaction */
+#define MCP9808_SIM_CONFIG_MSK		0x07FFU		/**< Implemented CONFIG bits */
+
+/************************************************************************
+	DECLARATIONS
+************************************************************************/
+/** Conversion time (ns) per resolution */
+static const uint64_t MCP9808_SIM_ConversionNs[4] =
+{
+	30000000ULL, 65000000ULL, 130000000ULL, 250000000ULL
+};
+
+/** CONFIG bits that a lock bit freezes (datasheet, CONFIG register description) */
+static const struct
+{
+	uint16_t	bits;		/**< Frozen bits */
+	uint16_t	lockedBy;	/**< Lock bits freezing them */
+}MCP9808_SIM_ConfigRules[] =
+{
+	{ 0x0600U,	MCP9808_CONFIG_CRIT_LOCK | MCP9808_CONFIG_WIN_LOCK },	/* THYST */
+	{ 0x0008U,	MCP9808_CONFIG_CRIT_LOCK | MCP9808_CONFIG_WIN_LOCK },	/* Alert Cnt. */
+	{ 0x0004U,	MCP9808_CONFIG_WIN_LOCK },								/* Alert Sel. */
+	{ 0x0002U,	MCP9808_CONFIG_CRIT_LOCK | MCP9808_CONFIG_WIN_LOCK },	/* Alert Pol. */
+	{ 0x0001U,	MCP9808_CONFIG_CRIT_LOCK | MCP9808_CONFIG_WIN_LOCK },	/* Alert Mod. */
+};
+
+/** Hysteresis (1/16 °C) per THYST value */
+static const int16_t MCP9808_SIM_Hysteresis[4] = { 0, 24, 48, 96 };
+
+static bool MCP9808_SIM_Alert( const MCP9808_SIM_Device_t* dev );
+static void MCP9808_SIM_Edge( MCP9808_SIM_Device_t* dev );
+
+/************************************************************************
+	FUNCTIONS
+************************************************************************/
+
+/**
+ * @brief Evaluate the device waveform.
+ *
+ * @param dev Simulated device.
+ * @param timeNs Virtual time.
+ * @return int16_t Temperature (1/16 °C).
+ */
+static int16_t MCP9808_SIM_Sample( MCP9808_SIM_Device_t* dev, uint64_t timeNs )
+{
+	const MCP9808_SIM_Wave_t* wave = &dev->wave;
+	int32_t value = wave->offset;
+	uint64_t phase = 0;
+
+	if( dev->waveform != NULL )
+	{
+		return dev->waveform(dev->waveContext, timeNs);
+	}
+
+	if( wave->periodNs != 0U )
+	{
+		phase = timeNs % wave->periodNs;
+
+		switch( wave->type )
+		{
+			case MCP9808_SIM_WAVE_RAMP:
+				value += (int32_t)(((int64_t)wave->amplitude * (int64_t)timeNs) / (int64_t)wave->periodNs);
+				break;
+			case MCP9808_SIM_WAVE_SQUARE:
+				value += (phase < (wave->periodNs / 2U)) ? 0 : wave->amplitude;
+				break;
+			case MCP9808_SIM_WAVE_TRIANGLE:
+				phase = (phase < (wave->periodNs / 2U)) ? phase : (wave->periodNs - phase);
+				value += (int32_t)(((int64_t)wave->amplitude * (int64_t)phase * 2) / (int64_t)wave->periodNs);
+				break;
+			default:
+				break;
+		}
+	}
+
+	/* Sensor range */
+	if( value > 4095 )
+	{
+		value = 4095;
+	}
+	else if( value < -4096 )
+	{
+		value = -4096;
+	}
+
+	return (int16_t)value;
+}
+
+/**
+ * @brief Update the alert comparators after a conversion.
+ *
+ * @param dev Simulated device.
+ */
+static void MCP9808_SIM_Compare( MCP9808_SIM_Device_t* dev )
+{
+	int16_t t = dev->temperature;
+	int16_t hyst = MCP9808_SIM_Hysteresis[(dev->config >> 9) & 0x3U];
+	int16_t upper = MCP9808_RegToQ4(dev->upper);
+	int16_t lower = MCP9808_RegToQ4(dev->lower);
+	int16_t crit = MCP9808_RegToQ4(dev->crit);
+	bool window = dev->upperState || dev->lowerState;
+
+	/* Hysteresis applies on falling edges of TUPPER/TCRIT and rising edge of TLOWER */
+	dev->critState = dev->critState ? (t >= (crit - hyst)) : (t >= crit);
+	dev->upperState = dev->upperState ? (t > (upper - hyst)) : (t > upper);
+	dev->lowerState = dev->lowerState ? (t < (lower + hyst)) : (t < lower);
+
+	/* Interrupt mode: any window boundary crossing is latched until cleared */
+	if( (window != (dev->upperState || dev->lowerState)) &&
+		((dev->config & MCP9808_CONFIG_ALERT_MODE) == MCP9808_ALERT_MODE_ALL) )
+	{
+		dev->irqLatched = true;
+	}
+}
+
+/**
+ * @brief Run the conversions due until the bus time.
+ *
+ * @param bus Simulated bus.
+ * @param dev Simulated device.
+ */
+static void MCP9808_SIM_Update( MCP9808_SIM_Bus_t* bus, MCP9808_SIM_Device_t* dev )
+{
+	uint64_t tconv = MCP9808_SIM_ConversionNs[dev->resolution & MCP9808_RESOLUTION_MSK];
+	uint64_t due = 0;
+	int16_t mask = 0;
+
+	if( dev->config & MCP9808_CONFIG_SHDN )
+	{
+		dev->conversionNs = bus->timeNs;
+		return;
+	}
+
+	if( bus->timeNs < (dev->conversionNs + tconv) )
+	{
+		return;
+	}
+
+	due = (bus->timeNs - dev->conversionNs) / tconv;
+	if( due > MCP9808_SIM_MAX_STEPS )
+	{
+		/* Too far behind: skip to the last conversions */
+		dev->conversionNs += (due - MCP9808_SIM_MAX_STEPS) * tconv;
+		dev->conversions += (uint32_t)(due - MCP9808_SIM_MAX_STEPS);
+		due = MCP9808_SIM_MAX_STEPS;
+	}
+
+	/* Unused LSBs read as '0' at lower resolutions */
+	mask = (int16_t)~((1 << (3U - (dev->resolution & MCP9808_RESOLUTION_MSK))) - 1);
+
+	while( due-- > 0U )
+	{
+		dev->conversionNs += tconv;
+		dev->conversions++;
+		dev->temperature = MCP9808_SIM_Sample(dev, dev->conversionNs) & mask;
+		MCP9808_SIM_Compare(dev);
+		MCP9808_SIM_Edge(dev);
+	}
+}
+
+/**
+ * @brief Get the logical alert output state (Alert Stat. bit).
+ *
+ * @param dev Simulated device.
+ * @return true if the output is asserted.
+ */
+static bool MCP9808_SIM_Alert( const MCP9808_SIM_Device_t* dev )
+{
+	bool asserted = false;
+
+	if( dev->config & MCP9808_CONFIG_ALERT_CONTROL )
+	{
+		if( (dev->config & MCP9808_CONFIG_ALERT_MODE) == MCP9808_ALERT_MODE_TCRIT )
+		{
+			asserted = dev->critState;
+		}
+		else if( (dev->config & MCP9808_CONFIG_ALERT_OUTPUT) == MCP9808_ALERT_OUTPUT_IRQ )
+		{
+			/* TCRIT always works as a comparator */
+			asserted = dev->irqLatched || dev->critState;
+		}
+		else
+		{
+			asserted = dev->critState || dev->upperState || dev->lowerState;
+		}
+	}
+
+	return asserted;
+}
+
+/**
+ * @brief Report the ALERT pin asserting edge to the attached callback.
+ *
+ * @param dev Simulated device.
+ */
+static void MCP9808_SIM_Edge( MCP9808_SIM_Device_t* dev )
+{
+#if MCP9808_USE_ALERT_PIN
+	bool asserted = MCP9808_SIM_Alert(dev);
+
+	if( asserted && !dev->alertLevel && (dev->alertCallback != NULL) )
+	{
+		dev->alertCallback(dev->alertContext);
+	}
+	dev->alertLevel = asserted;
+#else
+	(void)dev;
+#endif /* MCP9808_USE_ALERT_PIN */
+}
+
+/**
+ * @brief Read a device register.
+ *
+ * @param dev Simulated device.
+ * @param reg Register.
+ * @return uint16_t Register value (MSB << 8 | LSB).
+ */
+static uint16_t MCP9808_SIM_ReadReg( MCP9808_SIM_Device_t* dev, uint8_t reg )
+{
+	uint16_t value = 0;
+	int16_t t = dev->temperature;
+
+	switch( reg )
+	{
+		case MCP9808_REG_CONFIG:
+			value = dev->config | (MCP9808_SIM_Alert(dev) ? MCP9808_CONFIG_ALERT_STATUS : 0U);
+			break;
+		case MCP9808_REG_UPPER_TEMP:
+			value = dev->upper;
+			break;
+		case MCP9808_REG_LOWER_TEMP:
+			value = dev->lower;
+			break;
+		case MCP9808_REG_CRITICAL_TEMP:
+			value = dev->crit;
+			break;
+		case MCP9808_REG_TEMPERATURE:
+			value = (uint16_t)t & MCP9808_TEMP_MSK;
+			value |= (t >= MCP9808_RegToQ4(dev->crit)) ? MCP9808_TA_TCRIT : 0U;
+			value |= (t > MCP9808_RegToQ4(dev->upper)) ? MCP9808_TA_TUPPER : 0U;
+			value |= (t < MCP9808_RegToQ4(dev->lower)) ? MCP9808_TA_TLOWER : 0U;
+			break;
+		case MCP9808_REG_ID_1:
+			value = MCP9808_SIM_MANUFACTURER_ID;
+			break;
+		case MCP9808_REG_ID_2:
+			value = MCP9808_SIM_DEVICE_ID;
+			break;
+		case MCP9808_REG_RESOLUTION:
+			value = dev->resolution;
+			break;
+		default:
+			break;
+	}
+
+	return value;
+}
+
+/**
+ * @brief Write a device register, following the lock rules of the device.
+ *
+ * @param bus Simulated bus.
+ * @param dev Simulated device.
+ * @param reg Register.
+ * @param value Register value (MSB << 8 | LSB).
+ */
+static void MCP9808_SIM_WriteReg( MCP9808_SIM_Bus_t* bus, MCP9808_SIM_Device_t* dev, uint8_t reg, uint16_t value )
+{
+	uint16_t config = dev->config;
+	bool clearIrq = false;
+	size_t i = 0;
+
+	switch( reg )
+	{
+		case MCP9808_REG_CONFIG:
+			clearIrq = ((value & MCP9808_CONFIG_CLEAR_IRQ) != 0U);
+			/* Int. Clear reads as '0', Alert Stat. is read-only, bits 15-11 unimplemented */
+			value &= MCP9808_SIM_CONFIG_MSK & ~(MCP9808_CONFIG_CLEAR_IRQ | MCP9808_CONFIG_ALERT_STATUS);
+			for( i = 0; i < (sizeof(MCP9808_SIM_ConfigRules) / sizeof(MCP9808_SIM_ConfigRules[0])); i++ )
+			{
+				if( config & MCP9808_SIM_ConfigRules[i].lockedBy )
+				{
+					value = (value & ~MCP9808_SIM_ConfigRules[i].bits) | (config & MCP9808_SIM_ConfigRules[i].bits);
+				}
+			}
+			/* SHDN can be cleared but not set while locked */
+			if( (config & (MCP9808_CONFIG_CRIT_LOCK | MCP9808_CONFIG_WIN_LOCK)) && !(config & MCP9808_CONFIG_SHDN) )
+			{
+				value &= ~MCP9808_CONFIG_SHDN;
+			}
+			/* Lock bits are only cleared by a power-on reset */
+			dev->config = value | (config & (MCP9808_CONFIG_CRIT_LOCK | MCP9808_CONFIG_WIN_LOCK));
+			if( clearIrq && !(dev->config & MCP9808_CONFIG_SHDN) )
+			{
+				/* Int. Clear cannot be set in shutdown (SHDN as configured by this write) */
+				dev->irqLatched = false;
+			}
+			if( (config & MCP9808_CONFIG_SHDN) && !(dev->config & MCP9808_CONFIG_SHDN) )
+			{
+				/* Wake up: next conversion one tCONV from now */
+				dev->conversionNs = bus->timeNs;
+			}
+			break;
+		case MCP9808_REG_UPPER_TEMP:
+			dev->upper = (config & MCP9808_CONFIG_WIN_LOCK) ? dev->upper : (value & MCP9808_LIMIT_MSK);
+			break;
+		case MCP9808_REG_LOWER_TEMP:
+			dev->lower = (config & MCP9808_CONFIG_WIN_LOCK) ? dev->lower : (value & MCP9808_LIMIT_MSK);
+			break;
+		case MCP9808_REG_CRITICAL_TEMP:
+			dev->crit = (config & MCP9808_CONFIG_CRIT_LOCK) ? dev->crit : (value & MCP9808_LIMIT_MSK);
+			break;
+		case MCP9808_REG_RESOLUTION:
+			dev->resolution = value & MCP9808_RESOLUTION_MSK;
+			break;
+		default:
+			/* Read-only or reserved */
+			break;
+	}
+
+	/* Alert enable or interrupt clear may change the output */
+	MCP9808_SIM_Edge(dev);
+}
+
+/**
+ * @brief Busy wait, to give transfers the latency of a real bus.
+ *
+ * @param ns Time to wait (ns).
+ */
+static void MCP9808_SIM_Spin( uint32_t ns )
+{
+	struct timespec start;
+	struct timespec now;
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	do
+	{
+		clock_gettime(CLOCK_MONOTONIC, &now);
+	}
+	while( ((uint64_t)(now.tv_sec - start.tv_sec) * 1000000000ULL + (uint64_t)now.tv_nsec - (uint64_t)start.tv_nsec) <
+		   ns );
+}
+
+/**
+ * @brief Account the wire time and latency of one transaction.
+ *
+ * @param bus Simulated bus.
+ * @param bytes Bytes transferred by all its messages (address bytes included).
+ */
+static void MCP9808_SIM_Transfer( MCP9808_SIM_Bus_t* bus, uint32_t bytes )
+{
+	if( bus->latencyNs != 0U )
+	{
+		MCP9808_SIM_Spin(bus->latencyNs);
+	}
+
+	if( bus->clockHz != 0U )
+	{
+		bus->timeNs += ((uint64_t)(bytes * 9U + MCP9808_SIM_BIT_OVERHEAD) * 1000000000ULL) / bus->clockHz;
+	}
+}
+
+/**
+ * @brief Find the device addressed by a message and account its bytes.
+ *
+ * @param bus Simulated bus.
+ * @param address Slave address.
+ * @param bytes Bytes of the message pair (address bytes included).
+ * @return MCP9808_SIM_Device_t* Device, NULL if nobody ACKs the address.
+ */
+static MCP9808_SIM_Device_t* MCP9808_SIM_Message( MCP9808_SIM_Bus_t* bus, uint8_t address, uint32_t bytes )
+{
+	MCP9808_SIM_Device_t* dev = MCP9808_SIM_GetDevice(bus, address);
+
+	if( dev != NULL )
+	{
+		bus->bytes += bytes;
+		MCP9808_SIM_Update(bus, dev);
+	}
+	else
+	{
+		/* Address NACK */
+		bus->bytes += 1U;
+		bus->errors++;
+	}
+
+	return dev;
+}
+
+/**
+ * @brief Find a device and account one transaction.
+ *
+ * @param bus Simulated bus.
+ * @param address Slave address.
+ * @param bytes Bytes transferred (address bytes included).
+ * @return MCP9808_SIM_Device_t* Device, NULL if nobody ACKs the address.
+ */
+static MCP9808_SIM_Device_t* MCP9808_SIM_Transaction( MCP9808_SIM_Bus_t* bus, uint8_t address, uint32_t bytes )
+{
+	MCP9808_SIM_Transfer(bus, bytes);
+	return MCP9808_SIM_Message(bus, address, bytes);
+}
+
+/**
+ * @brief Read the register selected by the device pointer.
+ *
+ * @param dev Simulated device.
+ * @param size Register size in byte.
+ * @param data Register data.
+ */
+static void MCP9808_SIM_ReadData( MCP9808_SIM_Device_t* dev, uint8_t size, uint8_t* data )
+{
+	uint16_t value = MCP9808_SIM_ReadReg(dev, dev->pointer);
+
+	if( size == 1U )
+	{
+		data[0] = value & 0xFF;
+	}
+	else if( size == MCP9808_REG_SIZE )
+	{
+		data[MCP9808_MSB] = (value >> 8) & 0xFF;
+		data[MCP9808_LSB] = value & 0xFF;
+	}
+}
+
+/**
+ * @brief Initialize a simulated bus, without devices.
+ *
+ * @param bus Simulated bus storage.
+ * @param clockHz SCL frequency used to advance the virtual time on each
+ * 		transfer (0 to only advance it with MCP9808_SIM_Advance()).
+ * @return error_t NO_ERROR if the bus has been initialized otherwise, SYS_ERROR
+ */
+MCP9808_Error_t MCP9808_SIM_BusInit( MCP9808_SIM_Bus_t* bus, uint32_t clockHz )
+{
+	MCP9808_Error_t error = MCP9808_ERROR;
+
+	if( bus != NULL )
+	{
+		memset(bus, 0, sizeof(*bus));
+		bus->clockHz = clockHz;
+		error = MCP9808_OK;
+	}
+
+	return error;
+}
+
+/**
+ * @brief Plug a device on the bus, in power-up state.
+ *
+ * @param bus Simulated bus.
+ * @param address Slave address (0x18 to 0x1F).
+ * @return MCP9808_SIM_Device_t* Device, NULL if the address is not valid.
+ */
+MCP9808_SIM_Device_t* MCP9808_SIM_AddDevice( MCP9808_SIM_Bus_t* bus, uint8_t address )
+{
+	MCP9808_SIM_Device_t* dev = NULL;
+
+	if( (bus != NULL) && (address >= MCP9808_SIM_BASE_ADDRESS) &&
+		(address < (MCP9808_SIM_BASE_ADDRESS + MCP9808_SIM_DEVICES)) )
+	{
+		dev = &bus->devices[address - MCP9808_SIM_BASE_ADDRESS];
+		memset(dev, 0, sizeof(*dev));
+		dev->present = true;
+		MCP9808_SIM_Reset(bus, dev);
+	}
+
+	return dev;
+}
+
+/**
+ * @brief Get a device plugged on the bus.
+ *
+ * @param bus Simulated bus.
+ * @param address Slave address.
+ * @return MCP9808_SIM_Device_t* Device, NULL if there is no device at this address.
+ */
+MCP9808_SIM_Device_t* MCP9808_SIM_GetDevice( MCP9808_SIM_Bus_t* bus, uint8_t address )
+{
+	MCP9808_SIM_Device_t* dev = NULL;
+
+	if( (bus != NULL) && (address >= MCP9808_SIM_BASE_ADDRESS) &&
+		(address < (MCP9808_SIM_BASE_ADDRESS + MCP9808_SIM_DEVICES)) &&
+		bus->devices[address - MCP9808_SIM_BASE_ADDRESS].present )
+	{
+		dev = &bus->devices[address - MCP9808_SIM_BASE_ADDRESS];
+	}
+
+	return dev;
+}
+
+/**
+ * @brief Power-on reset. Registers go back to their default values, the
+ * 		waveform is kept. The first conversion ends one tCONV later.
+ *
+ * @param bus Simulated bus.
+ * @param dev Simulated device.
+ * @return error_t NO_ERROR if the device has been reset otherwise, SYS_ERROR
+ */
+MCP9808_Error_t MCP9808_SIM_Reset( MCP9808_SIM_Bus_t* bus, MCP9808_SIM_Device_t* dev )
+{
+	MCP9808_Error_t error = MCP9808_ERROR;
+
+	if( (bus != NULL) && (dev != NULL) )
+	{
+		dev->pointer = 0;
+		dev->config = 0;
+		dev->upper = 0;
+		dev->lower = 0;
+		dev->crit = 0;
+		dev->resolution = MCP9808_RESOLUTION_4;
+		dev->temperature = 0;
+		dev->conversionNs = bus->timeNs;
+		dev->critState = false;
+		dev->upperState = false;
+		dev->lowerState = false;
+		dev->irqLatched = false;
+		error = MCP9808_OK;
+	}
+
+	return error;
+}
+
+/**
+ * @brief Use a built-in temperature waveform.
+ *
+ * @param dev Simulated device.
+ * @param wave Waveform description.
+ * @return error_t NO_ERROR if the waveform has been set otherwise, SYS_ERROR
+ */
+MCP9808_Error_t MCP9808_SIM_SetWave( MCP9808_SIM_Device_t* dev, const MCP9808_SIM_Wave_t* wave )
+{
+	MCP9808_Error_t error = MCP9808_ERROR;
+
+	if( (dev != NULL) && (wave != NULL) )
+	{
+		dev->wave = *wave;
+		dev->waveform = NULL;
+		error = MCP9808_OK;
+	}
+
+	return error;
+}
+
+/**
+ * @brief Use a custom temperature waveform.
+ *
+ * @param dev Simulated device.
+ * @param waveform Waveform function (NULL to go back to the built-in one).
+ * @param context Waveform function context.
+ * @return error_t NO_ERROR if the waveform has been set otherwise, SYS_ERROR
+ */
+MCP9808_Error_t MCP9808_SIM_SetWaveform( MCP9808_SIM_Device_t* dev, MCP9808_SIM_Waveform_t waveform, void* context )
+{
+	MCP9808_Error_t error = MCP9808_ERROR;
+
+	if( dev != NULL )
+	{
+		dev->waveform = waveform;
+		dev->waveContext = context;
+		error = MCP9808_OK;
+	}
+
+	return error;
+}
+
+/**
+ * @brief Advance the bus virtual time. Conversions are evaluated lazily,
+ * 		on the next access to each device (right away for devices with
+ * 		an attached ALERT pin).
+ *
+ * @param bus Simulated bus.
+ * @param ns Time to add (ns).
+ * @return error_t NO_ERROR if the time has been updated otherwise, SYS_ERROR
+ */
+MCP9808_Error_t MCP9808_SIM_Advance( MCP9808_SIM_Bus_t* bus, uint64_t ns )
+{
+	MCP9808_Error_t error = MCP9808_ERROR;
+#if MCP9808_USE_ALERT_PIN
+	uint8_t i = 0;
+#endif /* MCP9808_USE_ALERT_PIN */
+
+	if( bus != NULL )
+	{
+		bus->timeNs += ns;
+#if MCP9808_USE_ALERT_PIN
+		/* Devices with an attached pin are evaluated now to raise edges on time */
+		for( i = 0; i < MCP9808_SIM_DEVICES; i++ )
+		{
+			if( bus->devices[i].present && (bus->devices[i].alertCallback != NULL) )
+			{
+				MCP9808_SIM_Update(bus, &bus->devices[i]);
+			}
+		}
+#endif /* MCP9808_USE_ALERT_PIN */
+		error = MCP9808_OK;
+	}
+
+	return error;
+}
+
+/**
+ * @brief Get the alert output logical state (same as Alert Stat.).
+ *
+ * @param bus Simulated bus.
+ * @param dev Simulated device.
+ * @return true if the alert output is asserted.
+ */
+bool MCP9808_SIM_IsAlertAsserted( MCP9808_SIM_Bus_t* bus, MCP9808_SIM_Device_t* dev )
+{
+	bool result = false;
+
+	if( (bus != NULL) && (dev != NULL) )
+	{
+		MCP9808_SIM_Update(bus, dev);
+		result = MCP9808_SIM_Alert(dev);
+	}
+
+	return result;
+}
+
+/**
+ * @brief Get the alert pin level, polarity applied. The output is open
+ * 		drain: a deasserted active-low output reads high (pull-up).
+ *
+ * @param bus Simulated bus.
+ * @param dev Simulated device.
+ * @return true if the pin is high.
+ */
+bool MCP9808_SIM_GetAlertPin( MCP9808_SIM_Bus_t* bus, MCP9808_SIM_Device_t* dev )
+{
+	bool asserted = MCP9808_SIM_IsAlertAsserted(bus, dev);
+	bool activeHigh = (dev != NULL) && ((dev->config & MCP9808_ALERT_POL_MSK) == MCP9808_ALERT_POL_HIGH);
+
+	return activeHigh ? asserted : !asserted;
+}
+
+/**
+ * @brief Nothing to initialize: devices are added with MCP9808_SIM_AddDevice().
+ *
+ * @param bus Simulated bus (MCP9808_SIM_Bus_t).
+ * @return error_t NO_ERROR if the device has been configured otherwise, SYS_ERROR.
+ */
+MCP9808_Error_t MCP9808_PORT_Init( void* bus )
+{
+	return (bus != NULL) ? MCP9808_OK : MCP9808_ERROR;
+}
+
+/**
+ * @brief Read a register: the pointer is set to "reg" and the register read.
+ * 		| S |  ADDR  | W | A | REG | A | Sr |  ADDR  | R | A | DATA0 | ---- | DATAN | N | P |
+ *
+ * @param bus Simulated bus (MCP9808_SIM_Bus_t).
+ * @param address Slave address
+ * @param reg Register/command to be read
+ * @param size Register size in byte
+ * @param data Register data
+ * @return error_t NO_ERROR if the register has been read otherwise, SYS_ERROR
+ */
+MCP9808_Error_t MCP9808_PORT_Read(void* bus, uint8_t address, uint8_t reg, uint8_t size, uint8_t* data)
+{
+	MCP9808_SIM_Bus_t* simBus = (MCP9808_SIM_Bus_t*)bus;
+	MCP9808_SIM_Device_t* dev = NULL;
+	MCP9808_Error_t error = MCP9808_ERROR;
+
+	if( (simBus != NULL) && (data != NULL) && (size <= MCP9808_REG_SIZE) )
+	{
+		simBus->reads++;
+		dev = MCP9808_SIM_Transaction(simBus, address, 3U + size);
+		if( dev != NULL )
+		{
+			dev->pointer = reg & 0x0FU;
+			MCP9808_SIM_ReadData(dev, size, data);
+			error = MCP9808_OK;
+		}
+	}
+
+	return error;
+}
+
+/**
+ * @brief Write a register.
+ * 		| S |  ADDR  | W | A | REG | A | DATA0 | A | ---- | DATAN | A | P |
+ *
+ * @param bus Simulated bus (MCP9808_SIM_Bus_t).
+ * @param address Slave address
+ * @param reg Register/command to be written
+ * @param size Register size in byte
+ * @param data Register data
+ * @return error_t NO_ERROR if the register has been written otherwise, SYS_ERROR
+ */
+MCP9808_Error_t MCP9808_PORT_Write(void* bus, uint8_t address, uint8_t reg, uint8_t size, uint8_t* data)
+{
+	MCP9808_SIM_Bus_t* simBus = (MCP9808_SIM_Bus_t*)bus;
+	MCP9808_SIM_Device_t* dev = NULL;
+	MCP9808_Error_t error = MCP9808_ERROR;
+
+	if( (simBus != NULL) && ((data != NULL) || (size == 0U)) && (size <= MCP9808_REG_SIZE) )
+	{
+		simBus->writes++;
+		dev = MCP9808_SIM_Transaction(simBus, address, 2U + size);
+		if( dev != NULL )
+		{
+			dev->pointer = reg & 0x0FU;
+			if( size == 1U )
+			{
+				MCP9808_SIM_WriteReg(simBus, dev, dev->pointer, data[0]);
+			}
+			else if( size == MCP9808_REG_SIZE )
+			{
+				MCP9808_SIM_WriteReg(simBus, dev, dev->pointer,
+									 (data[MCP9808_MSB] << 8) | data[MCP9808_LSB]);
+			}
+			error = MCP9808_OK;
+		}
+	}
+
+	return error;
+}
+
+#if MCP9808_USE_STICKY_POINTER
+/**
+ * @brief Read the register the device pointer is already set to.
+ * 		| S |  ADDR  | R | A | DATA0 | ---- | DATAN | N | P |
+ *
+ * @param bus Simulated bus (MCP9808_SIM_Bus_t).
+ * @param address Slave address
+ * @param size Register size in byte
+ * @param data Register data
+ * @return error_t NO_ERROR if the register has been read otherwise, SYS_ERROR
+ */
+MCP9808_Error_t MCP9808_PORT_ReadCurrent(void* bus, uint8_t address, uint8_t size, uint8_t* data)
+{
+	MCP9808_SIM_Bus_t* simBus = (MCP9808_SIM_Bus_t*)bus;
+	MCP9808_SIM_Device_t* dev = NULL;
+	MCP9808_Error_t error = MCP9808_ERROR;
+
+	if( (simBus != NULL) && (data != NULL) && (size <= MCP9808_REG_SIZE) )
+	{
+		simBus->reads++;
+		dev = MCP9808_SIM_Transaction(simBus, address, 1U + size);
+		if( dev != NULL )
+		{
+			MCP9808_SIM_ReadData(dev, size, data);
+			error = MCP9808_OK;
+		}
+	}
+
+	return error;
+}
+#endif /* MCP9808_USE_STICKY_POINTER */
+
+#if MCP9808_USE_MULTI
+/**
+ * @brief Read the same register of several devices in a single transfer, as
+ * 		the Linux port does with one ioctl: one transaction and one latency
+ * 		for the whole transfer, a pointer write and a data read message per
+ * 		device. The transfer stops at the first device that does not ACK.
+ *
+ * @param bus Simulated bus (MCP9808_SIM_Bus_t).
+ * @param addresses Slave addresses
+ * @param count Number of devices (up to MCP9808_MULTI_MAX)
+ * @param reg Register/command to be read
+ * @param size Register size in byte
+ * @param data Register data, "size" bytes per device
+ * @return error_t NO_ERROR if every register has been read otherwise, SYS_ERROR
+ */
+MCP9808_Error_t MCP9808_PORT_ReadMulti(void* bus, const uint8_t* addresses, uint8_t count, uint8_t reg,
+									   uint8_t size, uint8_t* data)
+{
+	MCP9808_SIM_Bus_t* simBus = (MCP9808_SIM_Bus_t*)bus;
+	MCP9808_SIM_Device_t* dev = NULL;
+	MCP9808_Error_t error = MCP9808_ERROR;
+	uint8_t i = 0;
+
+	if( (simBus != NULL) && (addresses != NULL) && (data != NULL) && (count > 0U) &&
+		(count <= MCP9808_MULTI_MAX) && (size <= MCP9808_REG_SIZE) )
+	{
+		simBus->reads++;
+		MCP9808_SIM_Transfer(simBus, (uint32_t)count * (3U + size));
+		error = MCP9808_OK;
+		for( i = 0; (i < count) && !IS_MCP9808_ERROR(error); i++ )
+		{
+			dev = MCP9808_SIM_Message(simBus, addresses[i], 3U + size);
+			if( dev != NULL )
+			{
+				dev->pointer = reg & 0x0FU;
+				MCP9808_SIM_ReadData(dev, size, &data[i * size]);
+			}
+			else
+			{
+				error = MCP9808_ERROR;
+			}
+		}
+	}
+
+	return error;
+}
+#endif /* MCP9808_USE_MULTI */
+
+#if MCP9808_USE_STATS || MCP9808_USE_ONESHOT
+/**
+ * @brief Bus virtual time, in microseconds. Latencies are the simulated
+ * 		wire time (see MCP9808_SIM_BusInit()).
+ *
+ * @param bus Simulated bus (MCP9808_SIM_Bus_t).
+ * @return uint32_t Current time (us).
+ */
+uint32_t MCP9808_PORT_GetTimeUs(void* bus)
+{
+	MCP9808_SIM_Bus_t* simBus = (MCP9808_SIM_Bus_t*)bus;
+
+	return (simBus != NULL) ? (uint32_t)(simBus->timeNs / 1000U) : 0U;
+}
+#endif /* MCP9808_USE_STATS || MCP9808_USE_ONESHOT */
+
+#if MCP9808_USE_ONESHOT
+/**
+ * @brief Advance the bus virtual time instead of sleeping.
+ *
+ * @param bus Simulated bus (MCP9808_SIM_Bus_t).
+ * @param us Time to wait (us).
+ */
+void MCP9808_PORT_DelayUs(void* bus, uint32_t us)
+{
+	MCP9808_SIM_Advance((MCP9808_SIM_Bus_t*)bus, (uint64_t)us * 1000U);
+}
+#endif /* MCP9808_USE_ONESHOT */
+
+#if MCP9808_USE_ALERT_PIN
+/**
+ * @brief Attach the simulated ALERT pin. The callback is called from
+ * 		MCP9808_SIM_Advance() or from a bus transfer when the alert output
+ * 		gets asserted.
+ *
+ * @param bus Simulated bus (MCP9808_SIM_Bus_t).
+ * @param address Slave address
+ * @param callback Edge callback, NULL to detach the pin
+ * @param context Callback context
+ * @return error_t NO_ERROR if the pin has been attached otherwise, SYS_ERROR
+ */
+MCP9808_Error_t MCP9808_PORT_AlertAttach(void* bus, uint8_t address, MCP9808_PORT_Alert_t callback, void* context)
+{
+	MCP9808_SIM_Device_t* dev = MCP9808_SIM_GetDevice((MCP9808_SIM_Bus_t*)bus, address);
+	MCP9808_Error_t error = MCP9808_ERROR;
+
+	if( dev != NULL )
+	{
+		dev->alertCallback = callback;
+		dev->alertContext = context;
+		dev->alertLevel = MCP9808_SIM_Alert(dev);
+		error = MCP9808_OK;
+	}
+
+	return error;
+}
+#endif /* MCP9808_USE_ALERT_PIN */
+
+#if MCP9808_USE_ASYNC
+/**
+ * @brief Simulated transfers complete immediately: the callback is called
+ * 		before returning.
+ *
+ * @param bus Simulated bus (MCP9808_SIM_Bus_t).
+ * @param address Slave address
+ * @param reg Register/command to be read
+ * @param size Register size in byte
+ * @param data Register data
+ * @param callback Completion callback
+ * @param context Callback context
+ * @return error_t NO_ERROR if the transfer has been queued otherwise, SYS_ERROR
+ */
+MCP9808_Error_t MCP9808_PORT_ReadAsync(void* bus, uint8_t address, uint8_t reg, uint8_t size, uint8_t* data,
+									   MCP9808_PORT_Callback_t callback, void* context)
+{
+	callback(context, MCP9808_PORT_Read(bus, address, reg, size, data));
+	return MCP9808_OK;
+}
+
+/**
+ * @brief Simulated transfers complete immediately: the callback is called
+ * 		before returning.
+ *
+ * @param bus Simulated bus (MCP9808_SIM_Bus_t).
+ * @param address Slave address
+ * @param reg Register/command to be written
+ * @param size Register size in byte
+ * @param data Register data
+ * @param callback Completion callback
+ * @param context Callback context
+ * @return error_t NO_ERROR if the transfer has been queued otherwise, SYS_ERROR
+ */
+MCP9808_Error_t MCP9808_PORT_WriteAsync(void* bus, uint8_t address, uint8_t reg, uint8_t size, uint8_t* data,
+										MCP9808_PORT_Callback_t callback, void* context)
+{
+	callback(context, MCP9808_PORT_Write(bus, address, reg, size, data));
+	return MCP9808_OK;
+}
+#endif /* MCP9808_USE_ASYNC */
@@ -0,0 +1,152 @@
+/**                             _____________
+ *              /\      /\     /             \
+ *             //\\____//\\   |   MAUUUU!!    |
+ *            /     '      \   \  ___________/
+ *           /   /\ '  /\    \ /_/			      / /  ___    / __\ |__   __ _| |_ 
+ *          |    == o ==      |       /|	     / /  / _ \  / /  | '_ \ / _` | __|
+ *           \      '        /       | |	    / /__|  __/ / /___| | | | (_| | |_ 
+ *             \           /         \ \	    \____/\___| \____/|_| |_|\__,_|\__|
+ *             /----<o>---- \         / /
+ *             |            ' \       \ \
+ *             |    |    | '   '\      \ \
+ *  _________  | ´´ |  ' |     '  \    / /
+ *  |  MAYA  | |  ' |    | '       |__/ /
+ *   \______/   \__/ \__/ \_______/____/
+ * 
+ * @file MCP9808_port_sim.h
+ * @author Alejandro Gomez Molina (@Alejo2312)
+ * @brief Simulated MCP9808 devices implementing the port layer.
+ * @version 0.1
+ * @date Mar 22, 2022
+ * 
+ * @copyright Copyright (c) 2022
+ * 
+ */
+#ifndef DRIVERS_INC_MCP9808_PORT_SIM_H_
+#define DRIVERS_INC_MCP9808_PORT_SIM_H_
+
+
+/************************************************************************
+	INCLUDES
+************************************************************************/
+#include "MCP9808_port.h"
+
+/************************************************************************
+	DEFINES AND TYPES
+************************************************************************/
+#define MCP9808_SIM_BASE_ADDRESS	0x18U	/**< First MCP9808 address (A2..A0 = 0) */
+#define MCP9808_SIM_DEVICES			8U		/**< Devices per simulated bus (0x18 to 0x1F) */
+
+/** Built-in temperature waveforms */
+typedef enum
+{
+	MCP9808_SIM_WAVE_CONSTANT	= 0,	/**< offset */
+	MCP9808_SIM_WAVE_RAMP		= 1,	/**< offset + amplitude per period, unbounded */
+	MCP9808_SIM_WAVE_SQUARE		= 2,	/**< offset and offset + amplitude, half period each */
+	MCP9808_SIM_WAVE_TRIANGLE	= 3,	/**< offset to offset + amplitude and back over a period */
+}MCP9808_SIM_Wave_Type_t;
+
+/** Built-in temperature waveform */
+typedef struct
+{
+	MCP9808_SIM_Wave_Type_t	type;		/**< Waveform type */
+	int16_t					offset;		/**< Base temperature (1/16 °C) */
+	int16_t					amplitude;	/**< Amplitude (1/16 °C) */
+	uint64_t				periodNs;	/**< Period (ns) */
+}MCP9808_SIM_Wave_t;
+
+/** Custom temperature waveform. Returns the temperature (1/16 °C) at a given time. */
+typedef int16_t (*MCP9808_SIM_Waveform_t)( void* context, uint64_t timeNs );
+
+/** Simulated device */
+typedef struct
+{
+	bool					present;		/**< Device answers on the bus */
+	uint8_t					pointer;		/**< Register pointer */
+	uint16_t				config;			/**< CONFIG register */
+	uint16_t				upper;			/**< T UPPER register */
+	uint16_t				lower;			/**< T LOWER register */
+	uint16_t				crit;			/**< T CRIT register */
+	uint8_t					resolution;		/**< RESOLUTION register */
+	int16_t					temperature;	/**< Last converted temperature (1/16 °C) */
+	uint64_t				conversionNs;	/**< Time of the last conversion */
+	bool					critState;		/**< TA >= TCRIT (with hysteresis) */
+	bool					upperState;		/**< TA > TUPPER (with hysteresis) */
+	bool					lowerState;		/**< TA < TLOWER (with hysteresis) */
+	bool					irqLatched;		/**< Interrupt mode event pending */
+	MCP9808_SIM_Wave_t		wave;			/**< Built-in waveform */
+	MCP9808_SIM_Waveform_t	waveform;		/**< Custom waveform (NULL to use "wave") */
+	void*					waveContext;	/**< Custom waveform context */
+	uint32_t				conversions;	/**< Conversions done */
+#if MCP9808_USE_ALERT_PIN
+	MCP9808_PORT_Alert_t	alertCallback;	/**< ALERT pin edge callback */
+	void*					alertContext;	/**< ALERT pin edge callback context */
+	bool					alertLevel;		/**< Last alert output state seen */
+#endif /* MCP9808_USE_ALERT_PIN */
+}MCP9808_SIM_Device_t;
+
+/** Simulated bus. Pass it as "bus" to MCP9808_Init(). */
+typedef struct
+{
+	MCP9808_SIM_Device_t	devices[MCP9808_SIM_DEVICES];	/**< Devices 0x18 to 0x1F */
+	uint64_t				timeNs;		/**< Virtual time */
+	uint32_t				clockHz;	/**< SCL frequency: each transfer advances the time (0 to disable) */
+	uint32_t				latencyNs;	/**< Wall-clock time spent in each transfer (busy wait, 0 to disable) */
+	uint32_t				reads;		/**< Read transactions */
+	uint32_t				writes;		/**< Write transactions */
+	uint32_t				bytes;		/**< Bytes on the bus (address bytes included) */
+	uint32_t				errors;		/**< NACKed transactions */
+}MCP9808_SIM_Bus_t;
+
+
+/************************************************************************
+	FUNCTIONS
+************************************************************************/
+
+/**
+  See "MCP9808_port_sim.c" for details of how to use this function.
+ */
+MCP9808_Error_t MCP9808_SIM_BusInit( MCP9808_SIM_Bus_t* bus, uint32_t clockHz );
+
+/**
+  See "MCP9808_port_sim.c" for details of how to use this function.
+ */
+MCP9808_SIM_Device_t* MCP9808_SIM_AddDevice( MCP9808_SIM_Bus_t* bus, uint8_t address );
+
+/**
+  See "MCP9808_port_sim.c" for details of how to use this function.
+ */
+MCP9808_SIM_Device_t* MCP9808_SIM_GetDevice( MCP9808_SIM_Bus_t* bus, uint8_t address );
+
+/**
+  See "MCP9808_port_sim.c" for details of how to use this function.
+ */
+MCP9808_Error_t MCP9808_SIM_Reset( MCP9808_SIM_Bus_t* bus, MCP9808_SIM_Device_t* dev );
+
+/**
+  See "MCP9808_port_sim.c" for details of how to use this function.
+ */
+MCP9808_Error_t MCP9808_SIM_SetWave( MCP9808_SIM_Device_t* dev, const MCP9808_SIM_Wave_t* wave );
+
+/**
+  See "MCP9808_port_sim.c" for details of how to use this function.
+ */
+MCP9808_Error_t MCP9808_SIM_SetWaveform( MCP9808_SIM_Device_t* dev, MCP9808_SIM_Waveform_t waveform, void* context );
+
+/**
+  See "MCP9808_port_sim.c" for details of how to use this function.
+ */
+MCP9808_Error_t MCP9808_SIM_Advance( MCP9808_SIM_Bus_t* bus, uint64_t ns );
+
+/**
+  See "MCP9808_port_sim.c" for details of how to use this function.
+ */
+bool MCP9808_SIM_IsAlertAsserted( MCP9808_SIM_Bus_t* bus, MCP9808_SIM_Device_t* dev );
+
+/**
+  See "MCP9808_port_sim.c" for details of how to use this function.
+ */
+bool MCP9808_SIM_GetAlertPin( MCP9808_SIM_Bus_t* bus, MCP9808_SIM_Device_t* dev );
+
+
+#endif /* DRIVERS_INC_MCP9808_PORT_SIM_H_ */
@@ -0,0 +1,416 @@
+/**                             _____________
+ *              /\      /\     /             \
+ *             //\\____//\\   |   MAUUUU!!    |
+ *            /     '      \   \  ___________/
+ *           /   /\ '  /\    \ /_/			      / /  ___    / __\ |__   __ _| |_ 
+ *          |    == o ==      |       /|	     / /  / _ \  / /  | '_ \ / _` | __|
+ *           \      '        /       | |	    / /__|  __/ / /___| | | | (_| | |_ 
+ *             \           /         \ \	    \____/\___| \____/|_| |_|\__,_|\__|
+ *             /----<o>---- \         / /
+ *             |            ' \       \ \
+ *             |    |    | '   '\      \ \
+ *  _________  | ´´ |  ' |     '  \    / /
+ *  |  MAYA  | |  ' |    | '       |__/ /
+ *   \______/   \__/ \__/ \_______/____/
+ * 
+ * @file MCP9808_port_replay.c
+ * @author Alejandro Gomez Molina (@Alejo2312)
+ * @brief Replay port. Each MCP9808_REPLAY_Bus_t reads its own copy of a
+ * 		trace (see MCP9808_trace.c) and serves the records of one
+ * 		recorded bus, in order: read data and results come from the
+ * 		trace, so driver and pipeline changes can be measured offline
+ * 		against production traffic.
+ * 		A transfer is matched against the next MCP9808_REPLAY_LOOKAHEAD
+ * 		records of the bus (type, address, register and size); records
+ * 		jumped over are counted as skipped, so a driver doing fewer
+ * 		transfers than the recorded one (e.g. register cache) stays in
+ * 		step. Written data is not compared.
+ * @version 0.1
+ * @date Mar 22, 2022
+ * 
+ * @copyright Copyright (c) 2022
+ * 
+ */
+
+/************************************************************************
+	INCLUDES
+************************************************************************/
+#include <errno.h>
+#include <string.h>
+#include <time.h>
+#include "MCP9808_port_replay.h"
+/************************************************************************
+	DECLARATIONS
+************************************************************************/
+
+
+/************************************************************************
+	FUNCTIONS
+************************************************************************/
+
+/**
+ * @brief Read ahead the records of the bus, up to MCP9808_REPLAY_LOOKAHEAD.
+ * 		A truncated or corrupt record ends the trace.
+ *
+ * @param bus Replay bus.
+ */
+static void MCP9808_REPLAY_Fill( MCP9808_REPLAY_Bus_t* bus )
+{
+	MCP9808_TRACE_Record_t* record = NULL;
+
+	while( !bus->end && (bus->nPending < MCP9808_REPLAY_LOOKAHEAD) )
+	{
+		record = &bus->pending[bus->nPending];
+		if( MCP9808_TRACE_ReaderNext(&bus->reader, record) != MCP9808_OK )
+		{
+			bus->end = true;
+		}
+		else if( record->bus == bus->number )
+		{
+			bus->nPending++;
+		}
+	}
+}
+
+/**
+ * @brief Wait until the wall clock reaches a trace time, scaled by the
+ * 		replay speed. The first transfer served sets the time origin.
+ *
+ * @param bus Replay bus.
+ * @param traceUs Trace time (us).
+ */
+static void MCP9808_REPLAY_Pace( MCP9808_REPLAY_Bus_t* bus, uint64_t traceUs )
+{
+	struct timespec target;
+	struct timespec now;
+	uint64_t targetNs = 0;
+
+	if( bus->speed != 0U )
+	{
+		clock_gettime(CLOCK_MONOTONIC, &now);
+		if( !bus->started )
+		{
+			bus->started = true;
+			bus->baseUs = traceUs;
+			bus->originNs = (uint64_t)now.tv_sec * 1000000000ULL + (uint64_t)now.tv_nsec;
+		}
+
+		if( traceUs > bus->baseUs )
+		{
+			targetNs = bus->originNs + (traceUs - bus->baseUs) * 1000U / bus->speed;
+			target.tv_sec = (time_t)(targetNs / 1000000000ULL);
+			target.tv_nsec = (long)(targetNs % 1000000000ULL);
+			while( clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &target, NULL) == EINTR )
+			{
+			}
+		}
+	}
+}
+
+/**
+ * @brief Serve a transfer from the trace.
+ *
+ * @param bus Replay bus.
+ * @param op Transfer type (MCP9808_TRACE_Op_t).
+ * @param address Slave address
+ * @param reg Register/command (ignored for MCP9808_TRACE_READ_CURRENT)
+ * @param size Register size in byte
+ * @param data Register data (filled in for reads)
+ * @return MCP9808_Error_t Recorded result, MCP9808_ERROR if the transfer is
+ * 		not in the trace.
+ */
+static MCP9808_Error_t MCP9808_REPLAY_Serve( MCP9808_REPLAY_Bus_t* bus, uint8_t op, uint8_t address, uint8_t reg,
+											 uint8_t size, uint8_t* data )
+{
+	MCP9808_Error_t error = MCP9808_ERROR;
+	MCP9808_TRACE_Record_t record;
+	uint8_t i = 0;
+
+	MCP9808_REPLAY_Fill(bus);
+	for( i = 0; (i < bus->nPending) &&
+				((bus->pending[i].op != op) || (bus->pending[i].address != address) ||
+				 (bus->pending[i].size != size) ||
+				 ((op != MCP9808_TRACE_READ_CURRENT) && (bus->pending[i].reg != reg))); i++ )
+	{
+	}
+
+	if( i < bus->nPending )
+	{
+		record = bus->pending[i];
+		bus->nPending -= i + 1U;
+		memmove(&bus->pending[0], &bus->pending[i + 1U], bus->nPending * sizeof(bus->pending[0]));
+		bus->skipped += i;
+		bus->served++;
+
+		MCP9808_REPLAY_Pace(bus, record.timeUs);
+		if( (op != MCP9808_TRACE_WRITE) && (data != NULL) )
+		{
+			memcpy(data, record.data, size);
+		}
+		bus->timeUs = record.timeUs + record.durationUs;
+		MCP9808_REPLAY_Pace(bus, bus->timeUs);
+		error = record.result;
+	}
+	else
+	{
+		bus->mismatches++;
+	}
+
+	return error;
+}
+
+/**
+ * @brief Initialize a replay bus. Several replay buses can serve the same
+ * 		trace, each one with its own file (opened for reading, "rb").
+ *
+ * @param bus Replay bus storage.
+ * @param file Trace file, at the beginning. It is not closed by the port.
+ * @param number Recorded bus served (see MCP9808_TRACE_RecorderAddBus()).
+ * @param speed 0: as fast as possible, 1: original timing, N: N times faster.
+ * @return MCP9808_Error_t A number lower than '0' if something was wrong.
+ */
+MCP9808_Error_t MCP9808_REPLAY_BusInit( MCP9808_REPLAY_Bus_t* bus, FILE* file, uint8_t number, uint32_t speed )
+{
+	MCP9808_Error_t error = MCP9808_ERROR;
+
+	if( bus != NULL )
+	{
+		memset(bus, 0, sizeof(*bus));
+		bus->number = number;
+		bus->speed = speed;
+		error = MCP9808_TRACE_ReaderOpen(&bus->reader, file);
+	}
+
+	return error;
+}
+
+/**
+ * @brief Nothing to initialize: the trace is opened by MCP9808_REPLAY_BusInit().
+ *
+ * @param bus Replay bus (MCP9808_REPLAY_Bus_t).
+ * @return error_t NO_ERROR if the device has been configured otherwise, SYS_ERROR.
+ */
+MCP9808_Error_t MCP9808_PORT_Init( void* bus )
+{
+	MCP9808_REPLAY_Bus_t* replayBus = (MCP9808_REPLAY_Bus_t*)bus;
+
+	return ((replayBus != NULL) && (replayBus->reader.file != NULL)) ? MCP9808_OK : MCP9808_ERROR;
+}
+
+/**
+ * @brief Serve a register read from the trace.
+ *
+ * @param bus Replay bus (MCP9808_REPLAY_Bus_t).
+ * @param address Slave address
+ * @param reg Register/command to be read
+ * @param size Register size in byte
+ * @param data Register data
+ * @return error_t NO_ERROR if the register has been read otherwise, SYS_ERROR
+ */
+MCP9808_Error_t MCP9808_PORT_Read(void* bus, uint8_t address, uint8_t reg, uint8_t size, uint8_t* data)
+{
+	MCP9808_Error_t error = MCP9808_ERROR;
+
+	if( (bus != NULL) && (data != NULL) && (size <= MCP9808_TRACE_PAYLOAD_MAX) )
+	{
+		error = MCP9808_REPLAY_Serve((MCP9808_REPLAY_Bus_t*)bus, MCP9808_TRACE_READ, address, reg, size, data);
+	}
+
+	return error;
+}
+
+/**
+ * @brief Serve a register write from the trace. The data is not compared
+ * 		with the recorded one.
+ *
+ * @param bus Replay bus (MCP9808_REPLAY_Bus_t).
+ * @param address Slave address
+ * @param reg Register/command to be written
+ * @param size Register size in byte
+ * @param data Register data
+ * @return error_t NO_ERROR if the register has been written otherwise, SYS_ERROR
+ */
+MCP9808_Error_t MCP9808_PORT_Write(void* bus, uint8_t address, uint8_t reg, uint8_t size, uint8_t* data)
+{
+	MCP9808_Error_t error = MCP9808_ERROR;
+
+	if( (bus != NULL) && (size <= MCP9808_TRACE_PAYLOAD_MAX) )
+	{
+		error = MCP9808_REPLAY_Serve((MCP9808_REPLAY_Bus_t*)bus, MCP9808_TRACE_WRITE, address, reg, size, data);
+	}
+
+	return error;
+}
+
+#if MCP9808_USE_STICKY_POINTER
+/**
+ * @brief Serve a current register read from the trace. The trace must have
+ * 		been recorded with MCP9808_USE_STICKY_POINTER too.
+ *
+ * @param bus Replay bus (MCP9808_REPLAY_Bus_t).
+ * @param address Slave address
+ * @param size Register size in byte
+ * @param data Register data
+ * @return error_t NO_ERROR if the register has been read otherwise, SYS_ERROR
+ */
+MCP9808_Error_t MCP9808_PORT_ReadCurrent(void* bus, uint8_t address, uint8_t size, uint8_t* data)
+{
+	MCP9808_Error_t error = MCP9808_ERROR;
+
+	if( (bus != NULL) && (data != NULL) && (size <= MCP9808_TRACE_PAYLOAD_MAX) )
+	{
+		error = MCP9808_REPLAY_Serve((MCP9808_REPLAY_Bus_t*)bus, MCP9808_TRACE_READ_CURRENT, address, 0U, size, data);
+	}
+
+	return error;
+}
+#endif /* MCP9808_USE_STICKY_POINTER */
+
+#if MCP9808_USE_MULTI
+/**
+ * @brief Serve a multi-device read from the trace, one read record per device.
+ * 		The recorder writes a record for every device even when the transfer
+ * 		fails, so all of them are consumed before the driver fallback reads.
+ *
+ * @param bus Replay bus (MCP9808_REPLAY_Bus_t).
+ * @param addresses Slave addresses
+ * @param count Number of devices (up to MCP9808_MULTI_MAX)
+ * @param reg Register/command to be read
+ * @param size Register size in byte
+ * @param data Register data, "size" bytes per device
+ * @return error_t NO_ERROR if every register has been read otherwise, SYS_ERROR
+ */
+MCP9808_Error_t MCP9808_PORT_ReadMulti(void* bus, const uint8_t* addresses, uint8_t count, uint8_t reg,
+									   uint8_t size, uint8_t* data)
+{
+	MCP9808_Error_t error = MCP9808_OK;
+	MCP9808_Error_t result = MCP9808_OK;
+	uint8_t i = 0;
+
+	for( i = 0; i < count; i++ )
+	{
+		result = MCP9808_PORT_Read(bus, addresses[i], reg, size, &data[i * size]);
+		if( !IS_MCP9808_ERROR(error) )
+		{
+			error = result;
+		}
+	}
+
+	return error;
+}
+#endif /* MCP9808_USE_MULTI */
+
+#if MCP9808_USE_STATS || MCP9808_USE_ONESHOT
+/**
+ * @brief Trace time, in microseconds: the start of the next recorded
+ * 		transfer of the bus before it is served, its end afterwards, so
+ * 		latencies are the recorded ones whatever the replay speed.
+ *
+ * @param bus Replay bus (MCP9808_REPLAY_Bus_t).
+ * @return uint32_t Current time (us).
+ */
+uint32_t MCP9808_PORT_GetTimeUs(void* bus)
+{
+	MCP9808_REPLAY_Bus_t* replayBus = (MCP9808_REPLAY_Bus_t*)bus;
+	uint64_t timeUs = 0;
+
+	if( replayBus != NULL )
+	{
+		MCP9808_REPLAY_Fill(replayBus);
+		timeUs = replayBus->timeUs;
+		if( (replayBus->nPending > 0U) && (replayBus->pending[0].timeUs > timeUs) )
+		{
+			timeUs = replayBus->pending[0].timeUs;
+		}
+	}
+
+	return (uint32_t)timeUs;
+}
+#endif /* MCP9808_USE_STATS || MCP9808_USE_ONESHOT */
+
+#if MCP9808_USE_ONESHOT
+/**
+ * @brief Sleep, scaled by the replay speed (no wait at full speed).
+ *
+ * @param bus Replay bus (MCP9808_REPLAY_Bus_t).
+ * @param us Time to wait (us).
+ */
+void MCP9808_PORT_DelayUs(void* bus, uint32_t us)
+{
+	MCP9808_REPLAY_Bus_t* replayBus = (MCP9808_REPLAY_Bus_t*)bus;
+	struct timespec delay;
+	uint64_t ns = 0;
+
+	if( (replayBus != NULL) && (replayBus->speed != 0U) )
+	{
+		ns = (uint64_t)us * 1000U / replayBus->speed;
+		delay.tv_sec = (time_t)(ns / 1000000000ULL);
+		delay.tv_nsec = (long)(ns % 1000000000ULL);
+		while( (nanosleep(&delay, &delay) != 0) && (errno == EINTR) )
+		{
+		}
+	}
+}
+#endif /* MCP9808_USE_ONESHOT */
+
+#if MCP9808_USE_ALERT_PIN
+/**
+ * @brief ALERT pin edges are not part of a trace: the pin is accepted but
+ * 		never fires. Alert state reads are replayed as any other read.
+ *
+ * @param bus Replay bus (MCP9808_REPLAY_Bus_t).
+ * @param address Slave address
+ * @param callback Edge callback, NULL to detach the pin
+ * @param context Callback context
+ * @return error_t NO_ERROR if the pin has been attached otherwise, SYS_ERROR
+ */
+MCP9808_Error_t MCP9808_PORT_AlertAttach(void* bus, uint8_t address, MCP9808_PORT_Alert_t callback, void* context)
+{
+	(void)address;
+	(void)callback;
+	(void)context;
+	return (bus != NULL) ? MCP9808_OK : MCP9808_ERROR;
+}
+#endif /* MCP9808_USE_ALERT_PIN */
+
+#if MCP9808_USE_ASYNC
+/**
+ * @brief Replayed transfers complete immediately: the callback is called
+ * 		before returning.
+ *
+ * @param bus Replay bus (MCP9808_REPLAY_Bus_t).
+ * @param address Slave address
+ * @param reg Register/command to be read
+ * @param size Register size in byte
+ * @param data Register data
+ * @param callback Completion callback
+ * @param context Callback context
+ * @return error_t NO_ERROR if the transfer has been queued otherwise, SYS_ERROR
+ */
+MCP9808_Error_t MCP9808_PORT_ReadAsync(void* bus, uint8_t address, uint8_t reg, uint8_t size, uint8_t* data,
+									   MCP9808_PORT_Callback_t callback, void* context)
+{
+	callback(context, MCP9808_PORT_Read(bus, address, reg, size, data));
+	return MCP9808_OK;
+}
+
+/**
+ * @brief Replayed transfers complete immediately: the callback is called
+ * 		before returning.
+ *
+ * @param bus Replay bus (MCP9808_REPLAY_Bus_t).
+ * @param address Slave address
+ * @param reg Register/command to be written
+ * @param size Register size in byte
+ * @param data Register data
+ * @param callback Completion callback
+ * @param context Callback context
+ * @return error_t NO_ERROR if the transfer has been queued otherwise, SYS_ERROR
+ */
+MCP9808_Error_t MCP9808_PORT_WriteAsync(void* bus, uint8_t address, uint8_t reg, uint8_t size, uint8_t* data,
+										MCP9808_PORT_Callback_t callback, void* context)
+{
+	callback(context, MCP9808_PORT_Write(bus, address, reg, size, data));
+	return MCP9808_OK;
+}
+#endif /* MCP9808_USE_ASYNC */
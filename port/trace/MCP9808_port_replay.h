@@ -0,0 +1,74 @@
+/**                             _____________
+ *              /\      /\     /             \
+ *             //\\____//\\   |   MAUUUU!!    |
+ *            /     '      \   \  ___________/
+ *           /   /\ '  /\    \ /_/			      / /  ___    / __\ |__   __ _| |_ 
+ *          |    == o ==      |       /|	     / /  / _ \  / /  | '_ \ / _` | __|
+ *           \      '        /       | |	    / /__|  __/ / /___| | | | (_| | |_ 
+ *             \           /         \ \	    \____/\___| \____/|_| |_|\__,_|\__|
+ *             /----<o>---- \         / /
+ *             |            ' \       \ \
+ *             |    |    | '   '\      \ \
+ *  _________  | ´´ |  ' |     '  \    / /
+ *  |  MAYA  | |  ' |    | '       |__/ /
+ *   \______/   \__/ \__/ \_______/____/
+ * 
+ * @file MCP9808_port_replay.h
+ * @author Alejandro Gomez Molina (@Alejo2312)
+ * @brief Replay port: serves the transfers of a recorded trace back to the
+ * 		driver, at the original speed, faster, or as fast as possible.
+ * @version 0.1
+ * @date Mar 22, 2022
+ * 
+ * @copyright Copyright (c) 2022
+ * 
+ */
+#ifndef DRIVERS_INC_MCP9808_PORT_REPLAY_H_
+#define DRIVERS_INC_MCP9808_PORT_REPLAY_H_
+
+
+/************************************************************************
+	INCLUDES
+************************************************************************/
+#include "MCP9808_port.h"
+#include "MCP9808_trace.h"
+
+/************************************************************************
+	DEFINES AND TYPES
+************************************************************************/
+
+/** Records searched ahead to match a transfer the driver asks for */
+#ifndef MCP9808_REPLAY_LOOKAHEAD
+#define MCP9808_REPLAY_LOOKAHEAD	16U
+#endif /* MCP9808_REPLAY_LOOKAHEAD */
+
+/** Replay bus. Pass it as "bus" to MCP9808_Init(). */
+typedef struct
+{
+	MCP9808_TRACE_Reader_t	reader;		/**< Trace being replayed */
+	uint8_t					number;		/**< Bus number served (records of other buses are skipped) */
+	uint32_t				speed;		/**< 0: as fast as possible, 1: original timing, N: N times faster */
+	bool					end;		/**< No more records in the trace */
+	bool					started;	/**< Pacing started */
+	uint64_t				timeUs;		/**< Trace time: end of the last transfer served */
+	uint64_t				baseUs;		/**< Trace time of the first transfer served */
+	uint64_t				originNs;	/**< Wall clock of the first transfer served */
+	uint8_t					nPending;	/**< Records read ahead */
+	MCP9808_TRACE_Record_t	pending[MCP9808_REPLAY_LOOKAHEAD];	/**< Records read ahead, oldest first */
+	uint32_t				served;		/**< Transfers served from the trace */
+	uint32_t				skipped;	/**< Recorded transfers the driver did not ask for */
+	uint32_t				mismatches;	/**< Transfers not found in the trace (failed) */
+}MCP9808_REPLAY_Bus_t;
+
+
+/************************************************************************
+	FUNCTIONS
+************************************************************************/
+
+/**
+  See "MCP9808_port_replay.c" for details of how to use this function.
+ */
+MCP9808_Error_t MCP9808_REPLAY_BusInit( MCP9808_REPLAY_Bus_t* bus, FILE* file, uint8_t number, uint32_t speed );
+
+
+#endif /* DRIVERS_INC_MCP9808_PORT_REPLAY_H_ */
@@ -0,0 +1,383 @@
+/**                             _____________
+ *              /\      /\     /             \
+ *             //\\____//\\   |   MAUUUU!!    |
+ *            /     '      \   \  ___________/
+ *           /   /\ '  /\    \ /_/			      / /  ___    / __\ |__   __ _| |_ 
+ *          |    == o ==      |       /|	     / /  / _ \  / /  | '_ \ / _` | __|
+ *           \      '        /       | |	    / /__|  __/ / /___| | | | (_| | |_ 
+ *             \           /         \ \	    \____/\___| \____/|_| |_|\__,_|\__|
+ *             /----<o>---- \         / /
+ *             |            ' \       \ \
+ *             |    |    | '   '\      \ \
+ *  _________  | ´´ |  ' |     '  \    / /
+ *  |  MAYA  | |  ' |    | '       |__/ /
+ *   \______/   \__/ \__/ \_______/____/
+ * 
+ * @file MCP9808_trace.c
+ * @author Alejandro Gomez Molina (@Alejo2312)
+ * @brief Bus trace recorder and reader.
+ * 		File: "MCPT", version, 3 reserved bytes, then one record per
+ * 		transfer:
+ * 		| op/error/bus | address | reg | size | start delta | duration | [result] | payload |
+ * 		op in bits 0-1, error flag in bit 2, bus number in bits 3-7.
+ * 		The start delta (us, to the previous record, zigzag) and the
+ * 		duration (us) are LEB128 varints; the result byte is only there
+ * 		for failed transfers. A register read takes 7 to 9 bytes.
+ * @version 0.1
+ * @date Mar 22, 2022
+ * 
+ * @copyright Copyright (c) 2022
+ * 
+ */
+
+/************************************************************************
+	INCLUDES
+************************************************************************/
+#include <stdatomic.h>
+#include <string.h>
+#include <time.h>
+#include "MCP9808_trace.h"
+/************************************************************************
+	DEFINES AND TYPES
+************************************************************************/
+#define MCP9808_TRACE_OP_MSK		0x03U	/**< Transfer type bits */
+#define MCP9808_TRACE_ERROR_FLAG	0x04U	/**< Result byte present */
+#define MCP9808_TRACE_BUS_POS		3U		/**< Bus number position */
+
+/************************************************************************
+	DECLARATIONS
+************************************************************************/
+static const uint8_t MCP9808_TRACE_Magic[4] = { 'M', 'C', 'P', 'T' };
+
+/** Recorder fed by the port shim */
+static MCP9808_TRACE_Recorder_t* _Atomic MCP9808_TRACE_Active;
+
+/************************************************************************
+	FUNCTIONS
+************************************************************************/
+
+/**
+ * @brief Encode an unsigned LEB128 varint.
+ *
+ * @param buffer Output (10 bytes at most).
+ * @param value Value.
+ * @return uint8_t Bytes used.
+ */
+static uint8_t MCP9808_TRACE_PutVarint( uint8_t* buffer, uint64_t value )
+{
+	uint8_t size = 0;
+
+	while( value >= 0x80U )
+	{
+		buffer[size++] = (uint8_t)(value | 0x80U);
+		value >>= 7;
+	}
+	buffer[size++] = (uint8_t)value;
+
+	return size;
+}
+
+/**
+ * @brief Decode an unsigned LEB128 varint from a file.
+ *
+ * @param file Input file.
+ * @param value Value storage.
+ * @return MCP9808_Error_t A number lower than '0' if something was wrong.
+ */
+static MCP9808_Error_t MCP9808_TRACE_GetVarint( FILE* file, uint64_t* value )
+{
+	MCP9808_Error_t error = MCP9808_ERROR;
+	uint8_t shift = 0;
+	int byte = 0;
+
+	*value = 0U;
+	while( (shift < 64U) && IS_MCP9808_ERROR(error) && ((byte = getc(file)) != EOF) )
+	{
+		*value |= (uint64_t)(byte & 0x7F) << shift;
+		shift += 7U;
+		if( (byte & 0x80) == 0 )
+		{
+			error = MCP9808_OK;
+		}
+	}
+
+	return error;
+}
+
+/**
+ * @brief Monotonic time stamp used in the records.
+ *
+ * @return uint64_t Time (us).
+ */
+uint64_t MCP9808_TRACE_NowUs( void )
+{
+	struct timespec now;
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return (uint64_t)now.tv_sec * 1000000U + (uint64_t)now.tv_nsec / 1000U;
+}
+
+/**
+ * @brief Start a recording: the trace header is written and the recorder
+ * 		becomes the one fed by the port shim. Only one recorder can be
+ * 		open at a time.
+ *
+ * @param recorder Recorder storage.
+ * @param file Output file, opened for writing ("wb").
+ * @return MCP9808_Error_t A number lower than '0' if something was wrong.
+ */
+MCP9808_Error_t MCP9808_TRACE_RecorderOpen( MCP9808_TRACE_Recorder_t* recorder, FILE* file )
+{
+	MCP9808_Error_t error = MCP9808_ERROR;
+	MCP9808_TRACE_Recorder_t* expected = NULL;
+	uint8_t header[MCP9808_TRACE_HEADER_SIZE] = { 0 };
+
+	if( (recorder != NULL) && (file != NULL) )
+	{
+		memset(recorder, 0, sizeof(*recorder));
+		recorder->file = file;
+		memcpy(header, MCP9808_TRACE_Magic, sizeof(MCP9808_TRACE_Magic));
+		header[4] = MCP9808_TRACE_VERSION;
+
+		if( (fwrite(header, 1, sizeof(header), file) == sizeof(header)) &&
+			(pthread_mutex_init(&recorder->lock, NULL) == 0) )
+		{
+			recorder->bytes = sizeof(header);
+			recorder->originUs = MCP9808_TRACE_NowUs();
+			error = atomic_compare_exchange_strong(&MCP9808_TRACE_Active, &expected, recorder) ?
+					MCP9808_OK : MCP9808_ERROR;
+			if( IS_MCP9808_ERROR(error) )
+			{
+				pthread_mutex_destroy(&recorder->lock);
+			}
+		}
+	}
+
+	return error;
+}
+
+/**
+ * @brief Stop a recording and flush the file. The file is not closed. No
+ * 		transfer may be in flight.
+ *
+ * @param recorder Recorder.
+ * @return MCP9808_Error_t A number lower than '0' if something was wrong.
+ */
+MCP9808_Error_t MCP9808_TRACE_RecorderClose( MCP9808_TRACE_Recorder_t* recorder )
+{
+	MCP9808_Error_t error = MCP9808_ERROR;
+	MCP9808_TRACE_Recorder_t* expected = recorder;
+
+	if( (recorder != NULL) && atomic_compare_exchange_strong(&MCP9808_TRACE_Active, &expected, NULL) )
+	{
+		pthread_mutex_lock(&recorder->lock);
+		error = (fflush(recorder->file) == 0) ? MCP9808_OK : MCP9808_ERROR;
+		pthread_mutex_unlock(&recorder->lock);
+		pthread_mutex_destroy(&recorder->lock);
+	}
+
+	return error;
+}
+
+/**
+ * @brief Get the open recorder.
+ *
+ * @return MCP9808_TRACE_Recorder_t* Recorder, NULL if not recording.
+ */
+MCP9808_TRACE_Recorder_t* MCP9808_TRACE_RecorderGet( void )
+{
+	return atomic_load_explicit(&MCP9808_TRACE_Active, memory_order_acquire);
+}
+
+/**
+ * @brief Look up the trace number of a bus. Buses are numbered in order of
+ * 		first use; adding them right after MCP9808_TRACE_RecorderOpen()
+ * 		gives stable numbers for the replay.
+ *
+ * @param recorder Recorder.
+ * @param bus Bus handle given to the port.
+ * @param number Bus number storage (can be NULL).
+ * @return MCP9808_Error_t A number lower than '0' if something was wrong
+ * 		(more than MCP9808_TRACE_BUSES buses).
+ */
+MCP9808_Error_t MCP9808_TRACE_RecorderAddBus( MCP9808_TRACE_Recorder_t* recorder, void* bus, uint8_t* number )
+{
+	MCP9808_Error_t error = MCP9808_ERROR;
+	uint8_t i = 0;
+
+	if( recorder != NULL )
+	{
+		pthread_mutex_lock(&recorder->lock);
+		for( i = 0; (i < recorder->nBuses) && (recorder->buses[i] != bus); i++ )
+		{
+		}
+		if( (i == recorder->nBuses) && (i < MCP9808_TRACE_BUSES) )
+		{
+			recorder->buses[recorder->nBuses++] = bus;
+		}
+		if( i < recorder->nBuses )
+		{
+			if( number != NULL )
+			{
+				*number = i;
+			}
+			error = MCP9808_OK;
+		}
+		pthread_mutex_unlock(&recorder->lock);
+	}
+
+	return error;
+}
+
+/**
+ * @brief Append a transfer to the trace. "timeUs" is taken from
+ * 		MCP9808_TRACE_NowUs() and made relative to the recording start;
+ * 		"bus" is filled in from the bus handle.
+ *
+ * @param recorder Recorder.
+ * @param bus Bus handle given to the port.
+ * @param record Transfer (timeUs: MCP9808_TRACE_NowUs() at the start).
+ * @return MCP9808_Error_t A number lower than '0' if something was wrong.
+ */
+MCP9808_Error_t MCP9808_TRACE_Record( MCP9808_TRACE_Recorder_t* recorder, void* bus, MCP9808_TRACE_Record_t* record )
+{
+	MCP9808_Error_t error = MCP9808_ERROR;
+	uint8_t buffer[MCP9808_TRACE_RECORD_MAX];
+	uint8_t size = 0;
+	int64_t delta = 0;
+
+	if( (recorder != NULL) && (record != NULL) )
+	{
+		error = (record->size <= MCP9808_TRACE_PAYLOAD_MAX) ?
+				MCP9808_TRACE_RecorderAddBus(recorder, bus, &record->bus) : MCP9808_ERROR;
+
+		pthread_mutex_lock(&recorder->lock);
+		if( !IS_MCP9808_ERROR(error) )
+		{
+			record->timeUs = (record->timeUs > recorder->originUs) ? (record->timeUs - recorder->originUs) : 0U;
+
+			buffer[size++] = (uint8_t)((record->op & MCP9808_TRACE_OP_MSK) |
+									   (IS_MCP9808_ERROR(record->result) ? MCP9808_TRACE_ERROR_FLAG : 0U) |
+									   (record->bus << MCP9808_TRACE_BUS_POS));
+			buffer[size++] = record->address;
+			buffer[size++] = record->reg;
+			buffer[size++] = record->size;
+			/* Threads finish out of order: the start delta can be negative */
+			delta = (int64_t)(record->timeUs - recorder->lastUs);
+			size += MCP9808_TRACE_PutVarint(&buffer[size], ((uint64_t)delta << 1) ^ (uint64_t)(delta >> 63));
+			size += MCP9808_TRACE_PutVarint(&buffer[size], record->durationUs);
+			if( IS_MCP9808_ERROR(record->result) )
+			{
+				buffer[size++] = (uint8_t)((record->result < -128) ? -128 : record->result);
+			}
+			memcpy(&buffer[size], record->data, record->size);
+			size += record->size;
+
+			if( fwrite(buffer, 1, size, recorder->file) == size )
+			{
+				recorder->lastUs = record->timeUs;
+				recorder->records++;
+				recorder->bytes += size;
+			}
+			else
+			{
+				error = MCP9808_ERROR;
+			}
+		}
+		if( IS_MCP9808_ERROR(error) )
+		{
+			recorder->dropped++;
+		}
+		pthread_mutex_unlock(&recorder->lock);
+	}
+
+	return error;
+}
+
+/**
+ * @brief Open a trace for reading and check its header.
+ *
+ * @param reader Reader storage.
+ * @param file Input file, opened for reading ("rb") at the beginning.
+ * @return MCP9808_Error_t A number lower than '0' if something was wrong.
+ */
+MCP9808_Error_t MCP9808_TRACE_ReaderOpen( MCP9808_TRACE_Reader_t* reader, FILE* file )
+{
+	MCP9808_Error_t error = MCP9808_ERROR;
+	uint8_t header[MCP9808_TRACE_HEADER_SIZE];
+
+	if( (reader != NULL) && (file != NULL) )
+	{
+		memset(reader, 0, sizeof(*reader));
+		reader->file = file;
+		if( (fread(header, 1, sizeof(header), file) == sizeof(header)) &&
+			(memcmp(header, MCP9808_TRACE_Magic, sizeof(MCP9808_TRACE_Magic)) == 0) &&
+			(header[4] == MCP9808_TRACE_VERSION) )
+		{
+			error = MCP9808_OK;
+		}
+	}
+
+	return error;
+}
+
+/**
+ * @brief Read the next record.
+ *
+ * @param reader Reader.
+ * @param record Record storage.
+ * @return MCP9808_Error_t MCP9808_TRACE_END at the end of the trace, a number
+ * 		lower than '0' if something was wrong (truncated or corrupt record).
+ */
+MCP9808_Error_t MCP9808_TRACE_ReaderNext( MCP9808_TRACE_Reader_t* reader, MCP9808_TRACE_Record_t* record )
+{
+	MCP9808_Error_t error = MCP9808_ERROR;
+	uint8_t head[4];
+	uint64_t delta = 0;
+	uint64_t duration = 0;
+	int result = 0;
+
+	if( (reader != NULL) && (record != NULL) )
+	{
+		head[0] = 0;
+		if( (fread(head, 1, sizeof(head), reader->file) == 0U) && feof(reader->file) )
+		{
+			error = MCP9808_TRACE_END;
+		}
+		else if( !ferror(reader->file) && !feof(reader->file) &&
+				 ((head[0] & MCP9808_TRACE_OP_MSK) <= MCP9808_TRACE_READ_CURRENT) &&
+				 (head[3] <= MCP9808_TRACE_PAYLOAD_MAX) &&
+				 !IS_MCP9808_ERROR(MCP9808_TRACE_GetVarint(reader->file, &delta)) &&
+				 !IS_MCP9808_ERROR(MCP9808_TRACE_GetVarint(reader->file, &duration)) )
+		{
+			record->op = head[0] & MCP9808_TRACE_OP_MSK;
+			record->bus = head[0] >> MCP9808_TRACE_BUS_POS;
+			record->address = head[1];
+			record->reg = head[2];
+			record->size = head[3];
+			record->timeUs = reader->timeUs + (uint64_t)((delta & 1U) ? ~(delta >> 1) : (delta >> 1));
+			record->durationUs = (uint32_t)duration;
+			record->result = MCP9808_OK;
+			error = MCP9808_OK;
+
+			if( (head[0] & MCP9808_TRACE_ERROR_FLAG) != 0U )
+			{
+				result = getc(reader->file);
+				record->result = (int8_t)result;
+				error = ((result == EOF) || !IS_MCP9808_ERROR(record->result)) ? MCP9808_ERROR : MCP9808_OK;
+			}
+			if( !IS_MCP9808_ERROR(error) &&
+				(fread(record->data, 1, record->size, reader->file) != record->size) )
+			{
+				error = MCP9808_ERROR;
+			}
+			if( !IS_MCP9808_ERROR(error) )
+			{
+				reader->timeUs = record->timeUs;
+				reader->records++;
+			}
+		}
+	}
+
+	return error;
+}
@@ -0,0 +1,142 @@
+/**                             _____________
+ *              /\      /\     /             \
+ *             //\\____//\\   |   MAUUUU!!    |
+ *            /     '      \   \  ___________/
+ *           /   /\ '  /\    \ /_/			      / /  ___    / __\ |__   __ _| |_ 
+ *          |    == o ==      |       /|	     / /  / _ \  / /  | '_ \ / _` | __|
+ *           \      '        /       | |	    / /__|  __/ / /___| | | | (_| | |_ 
+ *             \           /         \ \	    \____/\___| \____/|_| |_|\__,_|\__|
+ *             /----<o>---- \         / /
+ *             |            ' \       \ \
+ *             |    |    | '   '\      \ \
+ *  _________  | ´´ |  ' |     '  \    / /
+ *  |  MAYA  | |  ' |    | '       |__/ /
+ *   \______/   \__/ \__/ \_______/____/
+ * 
+ * @file MCP9808_trace.h
+ * @author Alejandro Gomez Molina (@Alejo2312)
+ * @brief Bus trace recorder and reader. Every port transfer becomes a
+ * 		compact binary record: bus, address, register, payload, start
+ * 		time, duration and result.
+ * @version 0.1
+ * @date Mar 22, 2022
+ * 
+ * @copyright Copyright (c) 2022
+ * 
+ */
+#ifndef DRIVERS_INC_MCP9808_TRACE_H_
+#define DRIVERS_INC_MCP9808_TRACE_H_
+
+
+/************************************************************************
+	INCLUDES
+************************************************************************/
+#include <stdio.h>
+#include <pthread.h>
+#include "MCP9808.h"
+
+/************************************************************************
+	DEFINES AND TYPES
+************************************************************************/
+#define MCP9808_TRACE_VERSION		1U
+#define MCP9808_TRACE_HEADER_SIZE	8U		/**< "MCPT", version, reserved */
+#define MCP9808_TRACE_PAYLOAD_MAX	MCP9808_REG_SIZE	/**< Largest payload recorded */
+#define MCP9808_TRACE_RECORD_MAX	(4U + 10U + 5U + 1U + MCP9808_TRACE_PAYLOAD_MAX) /**< Worst case encoded record */
+#define MCP9808_TRACE_BUSES			32U		/**< Buses told apart in a trace */
+
+#define MCP9808_TRACE_END			1		/**< No more records (MCP9808_TRACE_ReaderNext()) */
+
+/** Recorded transfer type */
+typedef enum
+{
+	MCP9808_TRACE_READ			= 0,	/**< MCP9808_PORT_Read() (one per device for MCP9808_PORT_ReadMulti()) */
+	MCP9808_TRACE_WRITE			= 1,	/**< MCP9808_PORT_Write() */
+	MCP9808_TRACE_READ_CURRENT	= 2,	/**< MCP9808_PORT_ReadCurrent() */
+}MCP9808_TRACE_Op_t;
+
+/** Decoded record */
+typedef struct
+{
+	uint64_t		timeUs;			/**< Transfer start since the recording started (us) */
+	uint32_t		durationUs;		/**< Transfer duration (us) */
+	MCP9808_Error_t	result;			/**< Port result */
+	uint8_t			op;				/**< Transfer type (MCP9808_TRACE_Op_t) */
+	uint8_t			bus;			/**< Bus number in the trace (order of first use) */
+	uint8_t			address;		/**< Slave address */
+	uint8_t			reg;			/**< Register (0 for MCP9808_TRACE_READ_CURRENT) */
+	uint8_t			size;			/**< Payload bytes */
+	uint8_t			data[MCP9808_TRACE_PAYLOAD_MAX];	/**< Data read or written */
+}MCP9808_TRACE_Record_t;
+
+/**
+ * Trace recorder. Records come from the port shim (MCP9808_trace_wrap.c)
+ * while the recorder is open, from any thread.
+ */
+typedef struct
+{
+	FILE*			file;			/**< Output file */
+	pthread_mutex_t	lock;			/**< Serializes the records */
+	uint64_t		originUs;		/**< Monotonic time the recording started (us) */
+	uint64_t		lastUs;			/**< Start time of the last record (us) */
+	void*			buses[MCP9808_TRACE_BUSES];	/**< Bus handles, by bus number */
+	uint8_t			nBuses;			/**< Bus numbers used */
+	uint32_t		records;		/**< Records written */
+	uint64_t		bytes;			/**< Bytes written (header included) */
+	uint32_t		dropped;		/**< Transfers not recorded (too many buses, file errors) */
+}MCP9808_TRACE_Recorder_t;
+
+/** Trace reader */
+typedef struct
+{
+	FILE*			file;			/**< Input file */
+	uint64_t		timeUs;			/**< Start time of the last record read (us) */
+	uint32_t		records;		/**< Records read */
+}MCP9808_TRACE_Reader_t;
+
+
+/************************************************************************
+	FUNCTIONS
+************************************************************************/
+
+/**
+  See "MCP9808_trace.c" for details of how to use this function.
+ */
+uint64_t MCP9808_TRACE_NowUs( void );
+
+/**
+  See "MCP9808_trace.c" for details of how to use this function.
+ */
+MCP9808_Error_t MCP9808_TRACE_RecorderOpen( MCP9808_TRACE_Recorder_t* recorder, FILE* file );
+
+/**
+  See "MCP9808_trace.c" for details of how to use this function.
+ */
+MCP9808_Error_t MCP9808_TRACE_RecorderClose( MCP9808_TRACE_Recorder_t* recorder );
+
+/**
+  See "MCP9808_trace.c" for details of how to use this function.
+ */
+MCP9808_TRACE_Recorder_t* MCP9808_TRACE_RecorderGet( void );
+
+/**
+  See "MCP9808_trace.c" for details of how to use this function.
+ */
+MCP9808_Error_t MCP9808_TRACE_RecorderAddBus( MCP9808_TRACE_Recorder_t* recorder, void* bus, uint8_t* number );
+
+/**
+  See "MCP9808_trace.c" for details of how to use this function.
+ */
+MCP9808_Error_t MCP9808_TRACE_Record( MCP9808_TRACE_Recorder_t* recorder, void* bus, MCP9808_TRACE_Record_t* record );
+
+/**
+  See "MCP9808_trace.c" for details of how to use this function.
+ */
+MCP9808_Error_t MCP9808_TRACE_ReaderOpen( MCP9808_TRACE_Reader_t* reader, FILE* file );
+
+/**
+  See "MCP9808_trace.c" for details of how to use this function.
+ */
+MCP9808_Error_t MCP9808_TRACE_ReaderNext( MCP9808_TRACE_Reader_t* reader, MCP9808_TRACE_Record_t* record );
+
+
+#endif /* DRIVERS_INC_MCP9808_TRACE_H_ */
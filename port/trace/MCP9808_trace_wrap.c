@@ -0,0 +1,195 @@
+/**                             _____________
+ *              /\      /\     /             \
+ *             //\\____//\\   |   MAUUUU!!    |
+ *            /     '      \   \  ___________/
+ *           /   /\ '  /\    \ /_/			      / /  ___    / __\ |__   __ _| |_ 
+ *          |    == o ==      |       /|	     / /  / _ \  / /  | '_ \ / _` | __|
+ *           \      '        /       | |	    / /__|  __/ / /___| | | | (_| | |_ 
+ *             \           /         \ \	    \____/\___| \____/|_| |_|\__,_|\__|
+ *             /----<o>---- \         / /
+ *             |            ' \       \ \
+ *             |    |    | '   '\      \ \
+ *  _________  | ´´ |  ' |     '  \    / /
+ *  |  MAYA  | |  ' |    | '       |__/ /
+ *   \______/   \__/ \__/ \_______/____/
+ * 
+ * @file MCP9808_trace_wrap.c
+ * @author Alejandro Gomez Molina (@Alejo2312)
+ * @brief Recording shim around the port layer. Any port (e.g. the Linux
+ * 		one) keeps doing the transfers; every call made by the driver is
+ * 		appended to the open MCP9808_TRACE_Recorder_t. Link with the GNU
+ * 		linker wrap option:
+ * 		-Wl,--wrap=MCP9808_PORT_Read,--wrap=MCP9808_PORT_Write
+ * 		plus --wrap=MCP9808_PORT_ReadCurrent (MCP9808_USE_STICKY_POINTER)
+ * 		and --wrap=MCP9808_PORT_ReadMulti (MCP9808_USE_MULTI).
+ * 		Asynchronous transfers are not recorded.
+ * @version 0.1
+ * @date Mar 22, 2022
+ * 
+ * @copyright Copyright (c) 2022
+ * 
+ */
+
+/************************************************************************
+	INCLUDES
+************************************************************************/
+#include <string.h>
+#include "MCP9808_port.h"
+#include "MCP9808_trace.h"
+/************************************************************************
+	DECLARATIONS
+************************************************************************/
+MCP9808_Error_t __real_MCP9808_PORT_Read(void* bus, uint8_t address, uint8_t reg, uint8_t size, uint8_t* data);
+MCP9808_Error_t __real_MCP9808_PORT_Write(void* bus, uint8_t address, uint8_t reg, uint8_t size, uint8_t* data);
+MCP9808_Error_t __wrap_MCP9808_PORT_Read(void* bus, uint8_t address, uint8_t reg, uint8_t size, uint8_t* data);
+MCP9808_Error_t __wrap_MCP9808_PORT_Write(void* bus, uint8_t address, uint8_t reg, uint8_t size, uint8_t* data);
+#if MCP9808_USE_STICKY_POINTER
+MCP9808_Error_t __real_MCP9808_PORT_ReadCurrent(void* bus, uint8_t address, uint8_t size, uint8_t* data);
+MCP9808_Error_t __wrap_MCP9808_PORT_ReadCurrent(void* bus, uint8_t address, uint8_t size, uint8_t* data);
+#endif /* MCP9808_USE_STICKY_POINTER */
+#if MCP9808_USE_MULTI
+MCP9808_Error_t __real_MCP9808_PORT_ReadMulti(void* bus, const uint8_t* addresses, uint8_t count, uint8_t reg,
+											  uint8_t size, uint8_t* data);
+MCP9808_Error_t __wrap_MCP9808_PORT_ReadMulti(void* bus, const uint8_t* addresses, uint8_t count, uint8_t reg,
+											  uint8_t size, uint8_t* data);
+#endif /* MCP9808_USE_MULTI */
+
+/************************************************************************
+	FUNCTIONS
+************************************************************************/
+
+/**
+ * @brief Record a finished transfer, if a recording is open.
+ *
+ * @param recorder Recorder open when the transfer started (can be NULL).
+ * @param bus Bus handle.
+ * @param op Transfer type (MCP9808_TRACE_Op_t).
+ * @param address Slave address
+ * @param reg Register/command
+ * @param size Register size in byte
+ * @param data Register data
+ * @param startUs Transfer start (MCP9808_TRACE_NowUs()).
+ * @param durationUs Transfer duration (us).
+ * @param result Port result.
+ */
+static void MCP9808_TRACE_Capture( MCP9808_TRACE_Recorder_t* recorder, void* bus, uint8_t op, uint8_t address,
+								   uint8_t reg, uint8_t size, const uint8_t* data, uint64_t startUs,
+								   uint64_t durationUs, MCP9808_Error_t result )
+{
+	MCP9808_TRACE_Record_t record;
+
+	if( recorder != NULL )
+	{
+		record.timeUs = startUs;
+		record.durationUs = (durationUs > UINT32_MAX) ? UINT32_MAX : (uint32_t)durationUs;
+		record.result = result;
+		record.op = op;
+		record.address = address;
+		record.reg = reg;
+		record.size = size;
+		if( (data != NULL) && (size <= MCP9808_TRACE_PAYLOAD_MAX) )
+		{
+			memcpy(record.data, data, size);
+		}
+		(void)MCP9808_TRACE_Record(recorder, bus, &record);
+	}
+}
+
+/**
+ * @brief Recorded MCP9808_PORT_Read().
+ *
+ * @param bus Bus handle of the wrapped port.
+ * @param address Slave address
+ * @param reg Register/command to be read
+ * @param size Register size in byte
+ * @param data Register data
+ * @return error_t Result of the wrapped port.
+ */
+MCP9808_Error_t __wrap_MCP9808_PORT_Read(void* bus, uint8_t address, uint8_t reg, uint8_t size, uint8_t* data)
+{
+	MCP9808_TRACE_Recorder_t* recorder = MCP9808_TRACE_RecorderGet();
+	uint64_t start = (recorder != NULL) ? MCP9808_TRACE_NowUs() : 0U;
+	MCP9808_Error_t error = __real_MCP9808_PORT_Read(bus, address, reg, size, data);
+
+	MCP9808_TRACE_Capture(recorder, bus, MCP9808_TRACE_READ, address, reg, size, data,
+						  start, (recorder != NULL) ? (MCP9808_TRACE_NowUs() - start) : 0U, error);
+	return error;
+}
+
+/**
+ * @brief Recorded MCP9808_PORT_Write().
+ *
+ * @param bus Bus handle of the wrapped port.
+ * @param address Slave address
+ * @param reg Register/command to be written
+ * @param size Register size in byte
+ * @param data Register data
+ * @return error_t Result of the wrapped port.
+ */
+MCP9808_Error_t __wrap_MCP9808_PORT_Write(void* bus, uint8_t address, uint8_t reg, uint8_t size, uint8_t* data)
+{
+	MCP9808_TRACE_Recorder_t* recorder = MCP9808_TRACE_RecorderGet();
+	uint64_t start = (recorder != NULL) ? MCP9808_TRACE_NowUs() : 0U;
+	MCP9808_Error_t error = __real_MCP9808_PORT_Write(bus, address, reg, size, data);
+
+	MCP9808_TRACE_Capture(recorder, bus, MCP9808_TRACE_WRITE, address, reg, size, data,
+						  start, (recorder != NULL) ? (MCP9808_TRACE_NowUs() - start) : 0U, error);
+	return error;
+}
+
+#if MCP9808_USE_STICKY_POINTER
+/**
+ * @brief Recorded MCP9808_PORT_ReadCurrent().
+ *
+ * @param bus Bus handle of the wrapped port.
+ * @param address Slave address
+ * @param size Register size in byte
+ * @param data Register data
+ * @return error_t Result of the wrapped port.
+ */
+MCP9808_Error_t __wrap_MCP9808_PORT_ReadCurrent(void* bus, uint8_t address, uint8_t size, uint8_t* data)
+{
+	MCP9808_TRACE_Recorder_t* recorder = MCP9808_TRACE_RecorderGet();
+	uint64_t start = (recorder != NULL) ? MCP9808_TRACE_NowUs() : 0U;
+	MCP9808_Error_t error = __real_MCP9808_PORT_ReadCurrent(bus, address, size, data);
+
+	MCP9808_TRACE_Capture(recorder, bus, MCP9808_TRACE_READ_CURRENT, address, 0U, size, data,
+						  start, (recorder != NULL) ? (MCP9808_TRACE_NowUs() - start) : 0U, error);
+	return error;
+}
+#endif /* MCP9808_USE_STICKY_POINTER */
+
+#if MCP9808_USE_MULTI
+/**
+ * @brief Recorded MCP9808_PORT_ReadMulti(): one read record per device,
+ * 		the transfer time split evenly between them.
+ *
+ * @param bus Bus handle of the wrapped port.
+ * @param addresses Slave addresses
+ * @param count Number of devices (up to MCP9808_MULTI_MAX)
+ * @param reg Register/command to be read
+ * @param size Register size in byte
+ * @param data Register data, "size" bytes per device
+ * @return error_t Result of the wrapped port.
+ */
+MCP9808_Error_t __wrap_MCP9808_PORT_ReadMulti(void* bus, const uint8_t* addresses, uint8_t count, uint8_t reg,
+											  uint8_t size, uint8_t* data)
+{
+	MCP9808_TRACE_Recorder_t* recorder = MCP9808_TRACE_RecorderGet();
+	uint64_t start = (recorder != NULL) ? MCP9808_TRACE_NowUs() : 0U;
+	MCP9808_Error_t error = __real_MCP9808_PORT_ReadMulti(bus, addresses, count, reg, size, data);
+	uint64_t slice = 0;
+	uint8_t i = 0;
+
+	if( (recorder != NULL) && (addresses != NULL) && (data != NULL) && (count > 0U) )
+	{
+		slice = (MCP9808_TRACE_NowUs() - start) / count;
+		for( i = 0; i < count; i++ )
+		{
+			MCP9808_TRACE_Capture(recorder, bus, MCP9808_TRACE_READ, addresses[i], reg, size, &data[i * size],
+								  start + i * slice, slice, error);
+		}
+	}
+	return error;
+}
+#endif /* MCP9808_USE_MULTI */
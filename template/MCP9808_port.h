@@ -36,6 +36,16 @@
 ************************************************************************/
 //#define FILE_NAME_DEF	/**< Detailed description */
 
+#if MCP9808_USE_ASYNC
+/** Transfer completion callback. The port calls it once per transfer. */
+typedef void (*MCP9808_PORT_Callback_t)( void* context, MCP9808_Error_t result );
+#endif /* MCP9808_USE_ASYNC */
+
+#if MCP9808_USE_ALERT_PIN
+/** ALERT pin edge callback. The port calls it when the pin gets asserted. */
+typedef void (*MCP9808_PORT_Alert_t)( void* context );
+#endif /* MCP9808_USE_ALERT_PIN */
+
 
 /************************************************************************
 	FUNCTIONS
@@ -44,17 +54,67 @@
 /**
   See "MCP9808_port.c" for details of how to use this function.
  */
-MCP9808_Error_t MCP9808_PORT_Init( void );
+MCP9808_Error_t MCP9808_PORT_Init( void* bus );
+
+/**
+  See "MCP9808_port.c" for details of how to use this function.
+ */
+MCP9808_Error_t MCP9808_PORT_Read(void* bus, uint8_t address, uint8_t reg, uint8_t size, uint8_t* data);
+
+/**
+  See "MCP9808_port.c" for details of how to use this function.
+ */
+MCP9808_Error_t MCP9808_PORT_Write(void* bus, uint8_t address, uint8_t reg, uint8_t size, uint8_t* data);
+
+#if MCP9808_USE_STICKY_POINTER
+/**
+  See "MCP9808_port.c" for details of how to use this function.
+ */
+MCP9808_Error_t MCP9808_PORT_ReadCurrent(void* bus, uint8_t address, uint8_t size, uint8_t* data);
+#endif /* MCP9808_USE_STICKY_POINTER */
+
+#if MCP9808_USE_MULTI
+/**
+  See "MCP9808_port.c" for details of how to use this function.
+ */
+MCP9808_Error_t MCP9808_PORT_ReadMulti(void* bus, const uint8_t* addresses, uint8_t count, uint8_t reg,
+									   uint8_t size, uint8_t* data);
+#endif /* MCP9808_USE_MULTI */
+
+#if MCP9808_USE_STATS || MCP9808_USE_ONESHOT
+/**
+  See "MCP9808_port.c" for details of how to use this function.
+ */
+uint32_t MCP9808_PORT_GetTimeUs(void* bus);
+#endif /* MCP9808_USE_STATS || MCP9808_USE_ONESHOT */
+
+#if MCP9808_USE_ONESHOT
+/**
+  See "MCP9808_port.c" for details of how to use this function.
+ */
+void MCP9808_PORT_DelayUs(void* bus, uint32_t us);
+#endif /* MCP9808_USE_ONESHOT */
+
+#if MCP9808_USE_ALERT_PIN
+/**
+  See "MCP9808_port.c" for details of how to use this function.
+ */
+MCP9808_Error_t MCP9808_PORT_AlertAttach(void* bus, uint8_t address, MCP9808_PORT_Alert_t callback, void* context);
+#endif /* MCP9808_USE_ALERT_PIN */
 
+#if MCP9808_USE_ASYNC
 /**
   See "MCP9808_port.c" for details of how to use this function.
  */
-MCP9808_Error_t MCP9808_PORT_Read(uint8_t address, uint8_t reg, uint8_t size, uint8_t* data);
+MCP9808_Error_t MCP9808_PORT_ReadAsync(void* bus, uint8_t address, uint8_t reg, uint8_t size, uint8_t* data,
+									   MCP9808_PORT_Callback_t callback, void* context);
 
 /**
   See "MCP9808_port.c" for details of how to use this function.
  */
-MCP9808_Error_t MCP9808_PORT_Write(uint8_t address, uint8_t reg, uint8_t size, uint8_t* data);
+MCP9808_Error_t MCP9808_PORT_WriteAsync(void* bus, uint8_t address, uint8_t reg, uint8_t size, uint8_t* data,
+										MCP9808_PORT_Callback_t callback, void* context);
+#endif /* MCP9808_USE_ASYNC */
 
 
 #endif /* DRIVERS_INC_MCP9808_PORT_H_ */
@@ -42,11 +42,13 @@
 ************************************************************************/
 
 /**
- * @brief Initialize I2c driver.
+ * @brief Initialize I2c driver. It is called once per device handle, so it
+ *        must be safe to call it several times for the same bus.
  *
+ * @param bus Bus context given to MCP9808_Init().
  * @return error_t NO_ERROR if the device has been configured otherwise, SYS_ERROR.
  */
-MCP9808_Error_t MCP9808_PORT_Init( void )
+MCP9808_Error_t MCP9808_PORT_Init( void* bus )
 {
 	/* Implement your function here! */
 	return 0;
@@ -56,13 +58,14 @@ MCP9808_Error_t MCP9808_PORT_Init( void )
  * @brief Read a register o execute a read command in a I2C register based device.
  * 		| S |  ADDR  | W | A | REG | A | DATA0 | ---- | DATAN | A | P |
  *
+ * @param bus Bus context given to MCP9808_Init().
  * @param address Slave address
  * @param reg Register/command to be read
  * @param size Register size in byte
  * @param data Register data
  * @return error_t NO_ERROR if the register has been read otherwise, SYS_ERROR
  */
-MCP9808_Error_t MCP9808_PORT_Read(uint8_t address, uint8_t reg, uint8_t size, uint8_t* data)
+MCP9808_Error_t MCP9808_PORT_Read(void* bus, uint8_t address, uint8_t reg, uint8_t size, uint8_t* data)
 {
 	/* Implement your function here! */
 	return 0;
@@ -73,14 +76,151 @@ MCP9808_Error_t MCP9808_PORT_Read(uint8_t address, uint8_t reg, uint8_t size, ui
  * 		| S |  ADDR  | W | A | REG | A |
  * 		| S |  ADDR  | R | A | DATA0 | ---- | DATAN | A | P |
  *
+ * @param bus Bus context given to MCP9808_Init().
  * @param address Slave address
  * @param reg Register/command to be written
  * @param size Register size in byte
  * @param data Register data
  * @return error_t NO_ERROR if the register has been written otherwise, SYS_ERROR
  */
-MCP9808_Error_t MCP9808_PORT_Write(uint8_t address, uint8_t reg, uint8_t size, uint8_t* data)
+MCP9808_Error_t MCP9808_PORT_Write(void* bus, uint8_t address, uint8_t reg, uint8_t size, uint8_t* data)
 {
 	/* Implement your function here! */
 	return 0;
 }
+
+#if MCP9808_USE_STICKY_POINTER
+/**
+ * @brief Read the register the device pointer is already set to, without
+ * 		sending the pointer byte.
+ * 		| S |  ADDR  | R | A | DATA0 | ---- | DATAN | N | P |
+ *
+ * @param bus Bus context given to MCP9808_Init().
+ * @param address Slave address
+ * @param size Register size in byte
+ * @param data Register data
+ * @return error_t NO_ERROR if the register has been read otherwise, SYS_ERROR
+ */
+MCP9808_Error_t MCP9808_PORT_ReadCurrent(void* bus, uint8_t address, uint8_t size, uint8_t* data)
+{
+	/* Implement your function here! */
+	return 0;
+}
+#endif /* MCP9808_USE_STICKY_POINTER */
+
+#if MCP9808_USE_MULTI
+/**
+ * @brief Read the same register of several devices in a single bus transfer.
+ * 		| S | ADDR0 | W | A | REG | A | Sr | ADDR0 | R | A | DATA | N | Sr | ADDR1 | W | ---- | ADDRN | R | A | DATA | N | P |
+ * 		If any device fails the whole call fails; the driver then reads the
+ * 		devices one by one to report each device status.
+ *
+ * @param bus Bus context given to MCP9808_Init().
+ * @param addresses Slave addresses
+ * @param count Number of devices (up to MCP9808_MULTI_MAX)
+ * @param reg Register/command to be read
+ * @param size Register size in byte
+ * @param data Register data, "size" bytes per device
+ * @return error_t NO_ERROR if every register has been read otherwise, SYS_ERROR
+ */
+MCP9808_Error_t MCP9808_PORT_ReadMulti(void* bus, const uint8_t* addresses, uint8_t count, uint8_t reg,
+									   uint8_t size, uint8_t* data)
+{
+	/* Implement your function here! */
+	return 0;
+}
+#endif /* MCP9808_USE_MULTI */
+
+#if MCP9808_USE_STATS || MCP9808_USE_ONESHOT
+/**
+ * @brief Get a free running microsecond counter, used to measure bus
+ * 		transactions latency. It may wrap around (32 bits).
+ *
+ * @param bus Bus context given to MCP9808_Init().
+ * @return uint32_t Current time (us).
+ */
+uint32_t MCP9808_PORT_GetTimeUs(void* bus)
+{
+	/* Implement your function here! */
+	return 0;
+}
+#endif /* MCP9808_USE_STATS || MCP9808_USE_ONESHOT */
+
+#if MCP9808_USE_ONESHOT
+/**
+ * @brief Wait (sleep if possible) for the device conversion.
+ *
+ * @param bus Bus context given to MCP9808_Init().
+ * @param us Time to wait (us).
+ */
+void MCP9808_PORT_DelayUs(void* bus, uint32_t us)
+{
+	/* Implement your function here! */
+}
+#endif /* MCP9808_USE_ONESHOT */
+
+#if MCP9808_USE_ALERT_PIN
+/**
+ * @brief Route the ALERT pin of a device to "callback". Configure the GPIO
+ * 		interrupt on the asserting edge (falling edge for the active-low
+ * 		default polarity) and call "callback" from its handler. It can be
+ * 		called from ISR context: the driver only flags the event.
+ *
+ * @param bus Bus context given to MCP9808_Init().
+ * @param address Slave address
+ * @param callback Edge callback, NULL to detach the pin
+ * @param context Callback context
+ * @return error_t NO_ERROR if the pin has been attached otherwise, SYS_ERROR
+ */
+MCP9808_Error_t MCP9808_PORT_AlertAttach(void* bus, uint8_t address, MCP9808_PORT_Alert_t callback, void* context)
+{
+	/* Implement your function here! */
+	return 0;
+}
+#endif /* MCP9808_USE_ALERT_PIN */
+
+#if MCP9808_USE_ASYNC
+/**
+ * @brief Start a register read and return without waiting for it.
+ * 		The transfer is the same as MCP9808_PORT_Read(). When it finishes,
+ * 		"callback" must be called once (from ISR or thread context) with
+ * 		the transfer result. "data" stays valid until then.
+ *
+ * @param bus Bus context given to MCP9808_Init().
+ * @param address Slave address
+ * @param reg Register/command to be read
+ * @param size Register size in byte
+ * @param data Register data
+ * @param callback Completion callback
+ * @param context Callback context
+ * @return error_t NO_ERROR if the transfer has been queued otherwise, SYS_ERROR
+ */
+MCP9808_Error_t MCP9808_PORT_ReadAsync(void* bus, uint8_t address, uint8_t reg, uint8_t size, uint8_t* data,
+									   MCP9808_PORT_Callback_t callback, void* context)
+{
+	/* Implement your function here! */
+	return 0;
+}
+
+/**
+ * @brief Start a register write and return without waiting for it.
+ * 		The transfer is the same as MCP9808_PORT_Write(). When it finishes,
+ * 		"callback" must be called once (from ISR or thread context) with
+ * 		the transfer result. "data" stays valid until then.
+ *
+ * @param bus Bus context given to MCP9808_Init().
+ * @param address Slave address
+ * @param reg Register/command to be written
+ * @param size Register size in byte
+ * @param data Register data
+ * @param callback Completion callback
+ * @param context Callback context
+ * @return error_t NO_ERROR if the transfer has been queued otherwise, SYS_ERROR
+ */
+MCP9808_Error_t MCP9808_PORT_WriteAsync(void* bus, uint8_t address, uint8_t reg, uint8_t size, uint8_t* data,
+										MCP9808_PORT_Callback_t callback, void* context)
+{
+	/* Implement your function here! */
+	return 0;
+}
+#endif /* MCP9808_USE_ASYNC */
@@ -0,0 +1,202 @@
+/**                             _____________
+ *              /\      /\     /             \
+ *             //\\____//\\   |   MAUUUU!!    |
+ *            /     '      \   \  ___________/
+ *           /   /\ '  /\    \ /_/                  / /  ___    / __\ |__   __ _| |_
+ *          |    == o ==      |       /|         / /  / _ \  / /  | '_ \ / _` | __|
+ *           \      '        /       | |        / /__|  __/ / /___| | | | (_| | |_
+ *             \           /         \ \        \____/\___| \____/|_| |_|\__,_|\__|
+ *             /----<o>---- \         / /
+ *             |            ' \       \ \
+ *             |    |    | '   '\      \ \
+ *  _________  | ´´ |  ' |     '  \    / /
+ *  |  MAYA  | |  ' |    | '       |__/ /
+ *   \______/   \__/ \__/ \_______/____/
+ * @file MCP9808_test_linux.c
+ * @author Alejandro Gomez Molina (@Alejo2312)
+ * @brief I2C_RDWR messages built by the Linux port, checked through the
+ *        transfer hook (no kernel, no adapter):
+ *        - Read: pointer write + data read, one ioctl,
+ *        - Write: pointer + data in one message,
+ *        - ReadCurrent: a single read message,
+ *        - ReadMulti: one pointer write + data read pair per device, one ioctl.
+ *
+ *        gcc -I. -Itemplate -Iport/linux -DMCP9808_USE_STICKY_POINTER=1 -DMCP9808_USE_MULTI=1 test/MCP9808_test_linux.c port/linux/MCP9808_port_linux.c -o mcp9808_test_linux
+ * @version 0.1
+ * @date Mar 22, 2022
+ * 
+ * @copyright Copyright (c) 2022
+ * 
+ */
+
+/************************************************************************
+    INCLUDES
+************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "MCP9808.h"
+#include "MCP9808_port_linux.h"
+
+/************************************************************************
+    DEFINES AND TYPES
+************************************************************************/
+#define TEST_ADDRESS            0x18U
+#define TEST_MSGS               (2U * MCP9808_MULTI_MAX)
+#define TEST_BUF_SIZE           4U
+
+/** Message seen by the hook (buffer copied, it only lives during the call) */
+typedef struct
+{
+    uint16_t    addr;                   /**< Slave address */
+    uint16_t    flags;                  /**< I2C_M_* flags */
+    uint16_t    len;                    /**< Buffer length */
+    uint8_t*    buf;                    /**< Buffer address */
+    uint8_t     data[TEST_BUF_SIZE];    /**< Buffer content (first bytes) */
+}Test_Msg_t;
+
+/** Transfer hook context: the last ioctl */
+typedef struct
+{
+    uint32_t    calls;                  /**< Hook calls */
+    uint32_t    nmsgs;                  /**< Messages of the last call */
+    Test_Msg_t  msgs[TEST_MSGS];        /**< Messages of the last call */
+    int         result;                 /**< Value returned (-1: all messages) */
+}Test_Hook_t;
+
+static uint32_t Test_Failures;
+
+/************************************************************************
+    FUNCTIONS
+************************************************************************/
+
+/**
+ * @brief Transfer hook: record the messages, fill read buffers with 0xA5.
+ *
+ * @param context Test_Hook_t.
+ * @param xfer I2C_RDWR argument.
+ * @return int Messages done.
+ */
+static int Test_Xfer( void* context, struct i2c_rdwr_ioctl_data* xfer )
+{
+    Test_Hook_t* hook = (Test_Hook_t*)context;
+    uint32_t i = 0;
+
+    hook->calls++;
+    hook->nmsgs = xfer->nmsgs;
+    for( i = 0; (i < xfer->nmsgs) && (i < TEST_MSGS); i++ )
+    {
+        hook->msgs[i].addr = xfer->msgs[i].addr;
+        hook->msgs[i].flags = xfer->msgs[i].flags;
+        hook->msgs[i].len = xfer->msgs[i].len;
+        hook->msgs[i].buf = xfer->msgs[i].buf;
+        memset(hook->msgs[i].data, 0, TEST_BUF_SIZE);
+        if( xfer->msgs[i].flags & I2C_M_RD )
+        {
+            memset(xfer->msgs[i].buf, 0xA5, xfer->msgs[i].len);
+        }
+        else
+        {
+            memcpy(hook->msgs[i].data, xfer->msgs[i].buf,
+                   (xfer->msgs[i].len < TEST_BUF_SIZE) ? xfer->msgs[i].len : TEST_BUF_SIZE);
+        }
+    }
+
+    return (hook->result >= 0) ? hook->result : (int)xfer->nmsgs;
+}
+
+/**
+ * @brief Report a check.
+ *
+ * @param name Check name.
+ * @param ok Check result.
+ */
+static void Test_Check( const char* name, bool ok )
+{
+    if( !ok )
+    {
+        Test_Failures++;
+    }
+    printf("%s %s\n", ok ? "ok  " : "FAIL", name);
+}
+
+/**
+ * @brief Check one recorded message.
+ *
+ * @param msg Recorded message.
+ * @param addr Expected address.
+ * @param flags Expected flags.
+ * @param len Expected length.
+ * @return true if it matches.
+ */
+static bool Test_Msg( const Test_Msg_t* msg, uint16_t addr, uint16_t flags, uint16_t len )
+{
+    return (msg->addr == addr) && (msg->flags == flags) && (msg->len == len);
+}
+
+int main( void )
+{
+    static const uint8_t addresses[3] = { 0x18U, 0x19U, 0x1FU };
+    MCP9808_LINUX_Bus_t bus;
+    Test_Hook_t hook;
+    uint8_t data[3U * MCP9808_REG_SIZE];
+    uint8_t value[MCP9808_REG_SIZE] = { 0x12U, 0x34U };
+    MCP9808_Error_t error = MCP9808_ERROR;
+    bool ok = true;
+    uint8_t i = 0;
+
+    memset(&hook, 0, sizeof(hook));
+    hook.result = -1;
+    MCP9808_LINUX_BusInit(&bus, NULL);
+    MCP9808_LINUX_BusSetXfer(&bus, Test_Xfer, &hook);
+    Test_Check("init without adapter", MCP9808_PORT_Init(&bus) == MCP9808_OK);
+
+    /* Read: | S | ADDR | W | REG | Sr | ADDR | R | DATA | P | */
+    hook.calls = 0U;
+    error = MCP9808_PORT_Read(&bus, TEST_ADDRESS, MCP9808_REG_TEMPERATURE, MCP9808_REG_SIZE, data);
+    Test_Check("read: one ioctl, 2 messages", (error == MCP9808_OK) && (hook.calls == 1U) && (hook.nmsgs == 2U));
+    Test_Check("read: pointer write",
+               Test_Msg(&hook.msgs[0], TEST_ADDRESS, 0U, 1U) && (hook.msgs[0].data[0] == MCP9808_REG_TEMPERATURE));
+    Test_Check("read: data read",
+               Test_Msg(&hook.msgs[1], TEST_ADDRESS, I2C_M_RD, MCP9808_REG_SIZE) && (hook.msgs[1].buf == data) &&
+               (data[0] == 0xA5U));
+
+    /* Write: | S | ADDR | W | REG | DATA | P | */
+    hook.calls = 0U;
+    error = MCP9808_PORT_Write(&bus, TEST_ADDRESS, MCP9808_REG_CRITICAL_TEMP, MCP9808_REG_SIZE, value);
+    Test_Check("write: one ioctl, 1 message", (error == MCP9808_OK) && (hook.calls == 1U) && (hook.nmsgs == 1U));
+    Test_Check("write: pointer + data",
+               Test_Msg(&hook.msgs[0], TEST_ADDRESS, 0U, 1U + MCP9808_REG_SIZE) &&
+               (hook.msgs[0].data[0] == MCP9808_REG_CRITICAL_TEMP) && (hook.msgs[0].data[1] == value[0]) &&
+               (hook.msgs[0].data[2] == value[1]));
+
+    /* ReadCurrent: | S | ADDR | R | DATA | P | */
+    hook.calls = 0U;
+    error = MCP9808_PORT_ReadCurrent(&bus, TEST_ADDRESS, MCP9808_REG_SIZE, data);
+    Test_Check("read current: one ioctl, 1 message", (error == MCP9808_OK) && (hook.calls == 1U) && (hook.nmsgs == 1U));
+    Test_Check("read current: data read, no pointer",
+               Test_Msg(&hook.msgs[0], TEST_ADDRESS, I2C_M_RD, MCP9808_REG_SIZE) && (hook.msgs[0].buf == data));
+
+    /* ReadMulti: a pointer write + data read pair per device */
+    hook.calls = 0U;
+    memset(data, 0, sizeof(data));
+    error = MCP9808_PORT_ReadMulti(&bus, addresses, 3U, MCP9808_REG_TEMPERATURE, MCP9808_REG_SIZE, data);
+    Test_Check("read multi: one ioctl, 2 x count messages",
+               (error == MCP9808_OK) && (hook.calls == 1U) && (hook.nmsgs == 6U));
+    for( i = 0; i < 3U; i++ )
+    {
+        ok = ok && Test_Msg(&hook.msgs[2U * i], addresses[i], 0U, 1U) &&
+             (hook.msgs[2U * i].data[0] == MCP9808_REG_TEMPERATURE) &&
+             Test_Msg(&hook.msgs[2U * i + 1U], addresses[i], I2C_M_RD, MCP9808_REG_SIZE) &&
+             (hook.msgs[2U * i + 1U].buf == &data[i * MCP9808_REG_SIZE]);
+    }
+    Test_Check("read multi: pairs in device order", ok && (data[sizeof(data) - 1U] == 0xA5U));
+
+    /* The ioctl must complete every message */
+    hook.result = 1;
+    error = MCP9808_PORT_Read(&bus, TEST_ADDRESS, MCP9808_REG_TEMPERATURE, MCP9808_REG_SIZE, data);
+    Test_Check("partial transfer reported as error", IS_MCP9808_ERROR(error));
+
+    printf("%lu failure(s)\n", (unsigned long)Test_Failures);
+    return (Test_Failures == 0U) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,178 @@
+/**                             _____________
+ *              /\      /\     /             \
+ *             //\\____//\\   |   MAUUUU!!    |
+ *            /     '      \   \  ___________/
+ *           /   /\ '  /\    \ /_/                  / /  ___    / __\ |__   __ _| |_
+ *          |    == o ==      |       /|         / /  / _ \  / /  | '_ \ / _` | __|
+ *           \      '        /       | |        / /__|  __/ / /___| | | | (_| | |_
+ *             \           /         \ \        \____/\___| \____/|_| |_|\__,_|\__|
+ *             /----<o>---- \         / /
+ *             |            ' \       \ \
+ *             |    |    | '   '\      \ \
+ *  _________  | ´´ |  ' |     '  \    / /
+ *  |  MAYA  | |  ' |    | '       |__/ /
+ *   \______/   \__/ \__/ \_______/____/
+ * @file MCP9808_test_lock.c
+ * @author Alejandro Gomez Molina (@Alejo2312)
+ * @brief CONFIG lock rules, checked on the register cache and on the
+ *        simulated device, under each lock bit:
+ *        - alert control, polarity, output mode and hysteresis are frozen,
+ *        - alert select is frozen by the window lock only,
+ *        - lock bits are sticky,
+ *        - shutdown can be left but not entered,
+ *        - unlock is refused without a bus write.
+ *
+ *        gcc -I. -Itemplate -Iport/sim test/MCP9808_test_lock.c port/sim/MCP9808_port_sim.c -o mcp9808_test_lock
+ *
+ *        The driver source is included to reach MCP9808_UpdateConfig().
+ * @version 0.1
+ * @date Mar 22, 2022
+ * 
+ * @copyright Copyright (c) 2022
+ * 
+ */
+
+/************************************************************************
+    INCLUDES
+************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include "MCP9808.c"
+#include "MCP9808_port_sim.h"
+
+/************************************************************************
+    DEFINES AND TYPES
+************************************************************************/
+#define TEST_ADDRESS            MCP9808_SIM_BASE_ADDRESS
+#define TEST_HYST               ((uint16_t)MCP9808_HYST_MSK << 8)   /**< THYST bits in CONFIG */
+#define TEST_ALERT_BITS         (MCP9808_CONFIG_ALERT_CONTROL | MCP9808_CONFIG_ALERT_POLARITY | \
+                                 MCP9808_CONFIG_ALERT_OUTPUT)
+
+/** Test fixture: one simulated device */
+typedef struct
+{
+    MCP9808_SIM_Bus_t       bus;        /**< Simulated bus */
+    MCP9808_SIM_Device_t*   sim;        /**< Simulated device */
+    MCP9808_Device_t        dev;        /**< Driver handle */
+}Test_t;
+
+static uint32_t Test_Failures;
+
+/************************************************************************
+    FUNCTIONS
+************************************************************************/
+
+/**
+ * @brief Check the CONFIG value seen by the driver cache and by the device.
+ *
+ * @param test Fixture.
+ * @param name Check name.
+ * @param expected Expected CONFIG value.
+ */
+static void Test_Config( Test_t* test, const char* name, uint16_t expected )
+{
+    uint16_t cached = test->dev.cache.value[MCP9808_CACHE_CONFIG];
+    uint16_t device = test->sim->config & ~MCP9808_CONFIG_ALERT_STATUS;
+
+    if( (cached != expected) || (device != expected) )
+    {
+        Test_Failures++;
+        printf("FAIL %s: expected 0x%04X, cache 0x%04X, device 0x%04X\n", name, expected, cached, device);
+    }
+    else
+    {
+        printf("ok   %s\n", name);
+    }
+}
+
+/**
+ * @brief Fresh device with the given CONFIG, then the lock bit set.
+ *
+ * @param test Fixture.
+ * @param config Initial CONFIG value.
+ * @param lock Lock bit to set.
+ */
+static void Test_Setup( Test_t* test, uint16_t config, uint16_t lock )
+{
+    MCP9808_SIM_BusInit(&test->bus, 0U);
+    test->sim = MCP9808_SIM_AddDevice(&test->bus, TEST_ADDRESS);
+    MCP9808_Init(&test->dev, &test->bus, TEST_ADDRESS);
+    MCP9808_UpdateConfig(&test->dev, 0x07FFU, config);
+    MCP9808_UpdateConfig(&test->dev, lock, lock);
+}
+
+/**
+ * @brief Run every rule under one lock bit.
+ *
+ * @param lock MCP9808_CONFIG_CRIT_LOCK or MCP9808_CONFIG_WIN_LOCK.
+ * @param name Lock name.
+ */
+static void Test_Lock( uint16_t lock, const char* name )
+{
+    char check[64];
+    Test_t test;
+    MCP9808_Error_t error = MCP9808_ERROR;
+    uint32_t writes = 0;
+
+    printf("-- %s\n", name);
+
+    /* Alert control, polarity, output mode and hysteresis: frozen in both directions */
+    Test_Setup(&test, 0U, lock);
+    MCP9808_UpdateConfig(&test.dev, TEST_ALERT_BITS | TEST_HYST, TEST_ALERT_BITS | TEST_HYST);
+    snprintf(check, sizeof(check), "%s: alert/hysteresis bits not set", name);
+    Test_Config(&test, check, lock);
+
+    Test_Setup(&test, TEST_ALERT_BITS | TEST_HYST, lock);
+    MCP9808_UpdateConfig(&test.dev, TEST_ALERT_BITS | TEST_HYST, 0U);
+    snprintf(check, sizeof(check), "%s: alert/hysteresis bits not cleared", name);
+    Test_Config(&test, check, TEST_ALERT_BITS | TEST_HYST | lock);
+
+    /* Alert select: frozen by the window lock only */
+    Test_Setup(&test, 0U, lock);
+    MCP9808_SetAlertMode(&test.dev, MCP9808_ALERT_MODE_TCRIT);
+    snprintf(check, sizeof(check), "%s: alert select %s", name,
+             (lock == MCP9808_CONFIG_WIN_LOCK) ? "frozen" : "writable");
+    Test_Config(&test, check, lock | ((lock == MCP9808_CONFIG_WIN_LOCK) ? 0U : MCP9808_CONFIG_ALERT_MODE));
+
+    /* Lock bits are sticky */
+    Test_Setup(&test, 0U, lock);
+    MCP9808_UpdateConfig(&test.dev, MCP9808_CONFIG_CRIT_LOCK | MCP9808_CONFIG_WIN_LOCK, 0U);
+    snprintf(check, sizeof(check), "%s: lock bit sticky", name);
+    Test_Config(&test, check, lock);
+
+    /* Shutdown: can not be entered, can be left */
+    Test_Setup(&test, 0U, lock);
+    MCP9808_UpdateConfig(&test.dev, MCP9808_CONFIG_SHDN, MCP9808_CONFIG_SHDN);
+    snprintf(check, sizeof(check), "%s: shutdown not entered", name);
+    Test_Config(&test, check, lock);
+
+    Test_Setup(&test, MCP9808_CONFIG_SHDN, lock);
+    MCP9808_SetShutdown(&test.dev, false);
+    snprintf(check, sizeof(check), "%s: shutdown left", name);
+    Test_Config(&test, check, lock);
+
+    /* Unlock: refused, nothing written (the lock only clears at power-on reset) */
+    Test_Setup(&test, 0U, lock);
+    writes = test.bus.writes;
+    error = (lock == MCP9808_CONFIG_WIN_LOCK) ? MCP9808_UnlockWindowTempReg(&test.dev) :
+                                                MCP9808_UnlockCriticalTempReg(&test.dev);
+    snprintf(check, sizeof(check), "%s: unlock refused", name);
+    if( !IS_MCP9808_ERROR(error) || (test.bus.writes != writes) )
+    {
+        Test_Failures++;
+        printf("FAIL %s: result %d, %lu write(s)\n", check, error, (unsigned long)(test.bus.writes - writes));
+    }
+    else
+    {
+        Test_Config(&test, check, lock);
+    }
+}
+
+int main( void )
+{
+    Test_Lock(MCP9808_CONFIG_CRIT_LOCK, "crit lock");
+    Test_Lock(MCP9808_CONFIG_WIN_LOCK, "window lock");
+
+    printf("%lu failure(s)\n", (unsigned long)Test_Failures);
+    return (Test_Failures == 0U) ? EXIT_SUCCESS : EXIT_FAILURE;
+}